@@ -0,0 +1,191 @@
+//Titan Engine, by Atlas X Games
+// AssetLoader.h - header for the class that reads meshes and textures on worker threads and sends them to opengl a few at a time on the main thread
+#pragma once
+
+//include the asset classes it loads
+#include "Mesh.h"
+#include "Texture2D.h"
+#include "TextureCubeMap.h"
+//include the cache finished assets are shared through
+#include "ResourceCache.h"
+//include the thread pool the files are read on
+#include "ThreadPool.h"
+#include "Logging.h"
+//import other required features
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace Titan {
+	//a handle to an asset that's being loaded, it's given out straight away and filled in on the main thread once the asset has been sent to opengl
+	template<typename T>
+	class TTN_Asset {
+	public:
+		//default constructor, makes a handle that isn't loading anything
+		TTN_Asset() = default;
+
+		//gets wheter or not the asset has finished loading (if it failed to load, Get will still return nullptr)
+		bool GetIsLoaded() const { return m_state != nullptr && m_state->Loaded; }
+		//gets the asset, nullptr if it hasn't finished loading yet
+		std::shared_ptr<T> Get() const { return (m_state != nullptr) ? m_state->Value : nullptr; }
+		//waits for the asset to finish loading and returns it, only call this on the main thread, it runs uploads while it waits
+		std::shared_ptr<T> Wait() const;
+
+	private:
+		friend class TTN_AssetLoader;
+
+		//what the loader fills in, shared between the handle and the loading jobs
+		struct State {
+			bool Loaded = false;
+			std::shared_ptr<T> Value;
+		};
+		std::shared_ptr<State> m_state;
+	};
+
+	//class that loads assets in the background, files are read and decoded on a pool of worker threads, and the opengl side of each asset
+	//(which has to happen on the main thread) is queued up and run by the application every frame until that frame's upload budget is used up
+	//so a loading screen can keep rendering while assets stream in
+	//finished assets go into TTN_ResourceCache, so loading something that's already loaded (or already loading) shares it instead
+	class TTN_AssetLoader {
+	public:
+		//starts loading a mesh from an obj file
+		static TTN_Asset<TTN_Mesh> LoadMesh(const std::string& fileName);
+		//starts loading a mesh with morph targets from a series of obj files named fileName_1.obj, fileName_2.obj, etc.
+		static TTN_Asset<TTN_Mesh> LoadAnimatedMesh(const std::string& fileName, int numOfFiles);
+		//starts loading a 2D texture from an image file
+		static TTN_Asset<TTN_Texture2D> LoadTexture2D(const std::string& fileName, bool flipped = true, bool forceRgba = false);
+		//starts loading a cubemap from 6 images, named the same way as TTN_TextureCubeMap::LoadFromImages expects
+		static TTN_Asset<TTN_TextureCubeMap> LoadTextureCubeMap(const std::string& filePath);
+
+		//runs the uploads that are ready until the upload budget for this frame is used up (at least one always runs, so loading can't stall)
+		//called by the application at the start of every frame, must be called on the main thread
+		static void ProcessUploads();
+		//runs uploads until everything that's been started has finished loading, for loading everything up front
+		//must be called on the main thread
+		static void WaitForAll();
+
+		//sets the most time (in milliseconds) ProcessUploads can spend sending assets to opengl each frame, 4ms by default
+		static void SetUploadBudget(float budget) { s_uploadBudget = budget; }
+		//gets the most time ProcessUploads can spend each frame
+		static float GetUploadBudget() { return s_uploadBudget; }
+		//gets the number of assets that have been started but haven't finished loading
+		static size_t GetNumOfPending() { return s_pending; }
+		//gets wheter or not everything that's been started has finished loading
+		static bool GetIsIdle() { return s_pending == 0; }
+
+	protected:
+		TTN_AssetLoader() = default;
+		~TTN_AssetLoader() = default;
+
+	private:
+		template<typename T>
+		friend class TTN_Asset;
+
+		//starts loading an asset, unless the resource cache already has it under the key or it's already loading
+		//read is run on a worker thread and returns the function that finishes the asset on the main thread
+		template<typename T>
+		static TTN_Asset<T> Start(TTN_ResourceType type, const std::string& key, std::function<std::function<std::shared_ptr<T>()>()> read);
+
+		//gets the pool the files are read on, it's made the first time something is loaded
+		//it's seperate from the shared pool, so long loads don't hold up the jobs that run every frame (like particles)
+		static TTN_ThreadPool& GetPool();
+		//queues up a function to be run on the main thread
+		static void PushUpload(std::function<void()> upload);
+		//runs the next queued upload, if wait is true and nothing's queued it waits for something to be, returns wheter or not one was run
+		static bool RunNextUpload(bool wait);
+
+		//the uploads waiting for the main thread
+		inline static std::deque<std::function<void()>> s_uploads;
+		//lock for the upload queue
+		inline static std::mutex s_uploadMutex;
+		//used to wake the main thread up when it's waiting for an upload
+		inline static std::condition_variable s_uploadAdded;
+		//the number of assets that have been started but haven't been uploaded
+		inline static std::atomic<size_t> s_pending = 0;
+		//the most time that can be spent uploading each frame
+		inline static float s_uploadBudget = 4.0f;
+		//the states of the assets that are loading, keyed by their type and resource cache key, so the same file isn't read twice at once
+		//only touched on the main thread
+		inline static std::unordered_map<std::string, std::shared_ptr<void>> s_loading;
+		//the worker threads, declared last so it's stopped before the queue it pushes to is destroyed
+		inline static TTN_ThreadPool::stpptr s_pool;
+	};
+
+	//waits for the asset to finish loading
+	template<typename T>
+	inline std::shared_ptr<T> TTN_Asset<T>::Wait() const
+	{
+		if (m_state == nullptr)
+			return nullptr;
+
+		//this asset's upload might be behind others, so keep running them until it's done
+		while (!m_state->Loaded)
+			TTN_AssetLoader::RunNextUpload(true);
+
+		return m_state->Value;
+	}
+
+	//starts loading an asset
+	template<typename T>
+	inline TTN_Asset<T> TTN_AssetLoader::Start(TTN_ResourceType type, const std::string& key, std::function<std::function<std::shared_ptr<T>()>()> read)
+	{
+		TTN_Asset<T> asset;
+
+		//if it's already loaded, hand it straight back
+		std::shared_ptr<T> cached = TTN_ResourceCache::Find<T>(type, key);
+		if (cached != nullptr) {
+			asset.m_state = std::make_shared<typename TTN_Asset<T>::State>();
+			asset.m_state->Loaded = true;
+			asset.m_state->Value = cached;
+			return asset;
+		}
+
+		//if it's already loading, share that load
+		std::string loadingKey = std::to_string((int)type) + ":" + key;
+		auto loading = s_loading.find(loadingKey);
+		if (loading != s_loading.end()) {
+			asset.m_state = std::static_pointer_cast<typename TTN_Asset<T>::State>(loading->second);
+			return asset;
+		}
+
+		asset.m_state = std::make_shared<typename TTN_Asset<T>::State>();
+		s_loading[loadingKey] = asset.m_state;
+		s_pending++;
+
+		std::shared_ptr<typename TTN_Asset<T>::State> state = asset.m_state;
+		GetPool().Push([state, read, type, key, loadingKey]() {
+			//read the files, if that fails the asset is still marked as loaded (just without a value) so nothing waits on it forever
+			std::function<std::shared_ptr<T>()> finish;
+			try {
+				finish = read();
+			}
+			catch (const std::exception& e) {
+				LOG_ERROR("Asset loader failed to read an asset: {}", e.what());
+			}
+
+			//then hand it to the main thread to send to opengl, if that throws it's failed the same way, and still counts as done
+			PushUpload([state, finish, type, key, loadingKey]() {
+				try {
+					if (finish)
+						state->Value = finish();
+				}
+				catch (const std::exception& e) {
+					LOG_ERROR("Asset loader failed to upload an asset: {}", e.what());
+					state->Value = nullptr;
+				}
+				state->Loaded = true;
+				s_loading.erase(loadingKey);
+				TTN_ResourceCache::Add(type, key, state->Value);
+				s_pending--;
+			});
+		});
+
+		return asset;
+	}
+}
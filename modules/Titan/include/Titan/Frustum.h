@@ -0,0 +1,32 @@
+//Titan Engine, by Atlas X Games
+// Frustum.h - header for the class that represents the volume a camera can see, used to skip drawing things that are off screen
+#pragma once
+
+//include glm features
+#include "GLM/glm.hpp"
+
+namespace Titan {
+	//class representing a camera's view frustum as 6 planes pointing inwards
+	//the planes are stored component by component so 4 of them can be tested against a sphere at once with sse
+	class TTN_Frustum {
+	public:
+		//constructor, makes a frustum that everything is inside
+		TTN_Frustum();
+
+		//destructor
+		~TTN_Frustum() = default;
+
+		//builds the planes out of a view projection matrix, so they're in world space
+		void SetFromViewProjection(const glm::mat4& viewProjection);
+
+		//checks if any part of a sphere might be inside the frustum (spheres near the corners can pass without acutally being inside)
+		bool TestSphere(glm::vec3 center, float radius) const;
+
+	private:
+		//the x, y, z normals and distances of the planes, the last 2 of the 8 are padding that everything is inside
+		alignas(16) float m_planeX[8];
+		alignas(16) float m_planeY[8];
+		alignas(16) float m_planeZ[8];
+		alignas(16) float m_planeW[8];
+	};
+}
@@ -0,0 +1,26 @@
+//Titan Engine, by Atlas X Games
+// Hash.h - header for the class with the hashing and file checking functions the asset caches use to tell if their sources changed
+#pragma once
+
+//import required features
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+namespace Titan {
+	//class with static functions for hashing data and files, and checking if a file has changed since it was last looked at
+	class TTN_Hash final {
+	public:
+		//the starting value of a 64 bit FNV-1a hash
+		static constexpr uint64_t FNVOffsetBasis = 14695981039346656037ull;
+
+		//64 bit FNV-1a hash of a block of memory, pass the result of a previous call as hash to keep hashing on from it
+		static uint64_t FNV1a(const void* data, size_t size, uint64_t hash = FNVOffsetBasis);
+
+		//hashes the contents of a file, returns false if it couldn't be read
+		static bool HashFile(const std::string& fileName, uint64_t& hash);
+
+		//gets the size and last write time of a file, returns false if it doesn't exist
+		static bool GetFileInfo(const std::string& fileName, uint64_t& size, int64_t& timestamp);
+	};
+}
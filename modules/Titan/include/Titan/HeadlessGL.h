@@ -0,0 +1,56 @@
+//Titan Engine, by Atlas X Games
+// HeadlessGL.h - header for the stand-in OpenGL backend that counts calls instead of sending them to a GPU, used to benchmark without a window
+#pragma once
+
+//import required features
+#include <glad/glad.h>
+#include <cstdint>
+
+namespace Titan {
+	//struct with the number of each kind of OpenGL call made since the last reset
+	struct TTN_GLCallStats {
+		//draw calls
+		uint64_t DrawCalls = 0;
+		//draw calls that were instanced
+		uint64_t InstancedDrawCalls = 0;
+		//total number of instances drawn by the instanced draw calls
+		uint64_t InstancesDrawn = 0;
+		//glUseProgram calls
+		uint64_t ShaderBinds = 0;
+		//glBindTextureUnit calls
+		uint64_t TextureBinds = 0;
+		//glBindVertexArray calls
+		uint64_t VaoBinds = 0;
+		//glBindBuffer calls
+		uint64_t BufferBinds = 0;
+		//glProgramUniform* calls
+		uint64_t UniformUploads = 0;
+		//buffer data uploads
+		uint64_t BufferUploads = 0;
+		//bytes sent to buffers
+		uint64_t BufferBytes = 0;
+		//every call that went through the backend
+		uint64_t TotalCalls = 0;
+	};
+
+	//static class that swaps glad's function pointers for stubs that just count the calls
+	class TTN_HeadlessGL {
+	public:
+		//points all of the OpenGL functions titan uses at the counting stubs, call this instead of TTN_Application::Init
+		static void Install();
+
+		//returns wheter or not the headless backend has been installed
+		static bool GetIsInstalled() { return s_installed; }
+
+		//gets the calls made since the last reset
+		static const TTN_GLCallStats& GetStats() { return s_stats; }
+		//resets the call counters
+		static void ResetStats() { s_stats = TTN_GLCallStats(); }
+
+	private:
+		//wheter or not the backend has been installed
+		inline static bool s_installed = false;
+		//the counters
+		inline static TTN_GLCallStats s_stats;
+	};
+}
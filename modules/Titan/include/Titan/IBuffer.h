@@ -30,6 +30,9 @@ namespace Titan {
 			TTN_IBuffer::LoadData((const void*)(data), sizeof(T), count);
 		}
 
+		//updates part of the data already in the buffer (using glNamedBufferSubData) without reallocating it, size and offset are in bytes
+		virtual void UpdateData(const void* data, size_t size, size_t offset = 0);
+
 		//GETTERS
 		//get the number of elements in this buffer
 		GLsizei GetElementCount() const { return static_cast<GLsizei>(_elementCount); }
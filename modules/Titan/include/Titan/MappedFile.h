@@ -0,0 +1,48 @@
+//Titan Engine, by Atlas X Games
+// MappedFile.h - header for the class that maps a file into memory so it can be read without copying it into a buffer first
+#pragma once
+
+//import required features
+#include <string>
+#include <cstddef>
+
+namespace Titan {
+	//class for a read-only memory mapped file, the file stays mapped until the object is destroyed
+	class TTN_MappedFile {
+	public:
+		//ensuring moving and copying is not allowed, the mapping is released in the destructor
+		TTN_MappedFile(const TTN_MappedFile& other) = delete;
+		TTN_MappedFile(TTN_MappedFile&& other) = delete;
+		TTN_MappedFile& operator=(const TTN_MappedFile& other) = delete;
+		TTN_MappedFile& operator=(TTN_MappedFile&& other) = delete;
+
+		//constructor, maps the file (check GetIsOpen to see if it worked)
+		TTN_MappedFile(const std::string& fileName);
+
+		//destructor, unmaps the file
+		~TTN_MappedFile();
+
+		//gets wheter or not the file was opened and mapped
+		bool GetIsOpen() const { return m_isOpen; }
+		//gets the start of the file's contents (nullptr if it's empty or failed to open)
+		const char* GetData() const { return m_data; }
+		//gets the size of the file in bytes
+		size_t GetSize() const { return m_size; }
+
+	private:
+		//the mapped contents of the file
+		const char* m_data;
+		//the size of the file in bytes
+		size_t m_size;
+		//wheter or not the file opened
+		bool m_isOpen;
+
+		//the os handles for the file and the mapping
+#ifdef _WIN32
+		void* m_fileHandle;
+		void* m_mappingHandle;
+#else
+		int m_fileDescriptor;
+#endif
+	};
+}
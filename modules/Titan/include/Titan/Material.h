@@ -7,6 +7,18 @@
 #include "TextureCubeMap.h"
 
 namespace Titan {
+	//the data for a material that gets put into titan's material storage buffer, so shaders can look up it's textures with bindless handles
+	//laid out to match the TTN_MaterialData struct in the default fragment shaders (std430)
+	struct TTN_MaterialData {
+		//bindless handle for the albedo texture, 0 if it should be treated as all white
+		GLuint64 Albedo;
+		//bindless handle for the specular map, 0 if it should be treated as all white
+		GLuint64 Specular;
+		//how shiny the material is
+		float Shininess;
+		float padding;
+	};
+
 	//class for materials on 3D objects
 	class TTN_Material {
 	public:
@@ -47,6 +59,9 @@ namespace Titan {
 		TTN_Texture2D::st2dptr GetHeightMap() { return m_HeightMap; }
 		float GetHeightInfluence() { return m_HeightInfluence; }
 
+		//gets the data for the material storage buffer, making the albedo and specular maps resident if they weren't already
+		TTN_MaterialData GetBindlessData();
+
 	private:
 		//albedo 
 		TTN_Texture2D::st2dptr m_Albedo;
@@ -4,12 +4,33 @@
 
 //include the opengl wrap around classes
 #include "VertexArrayObject.h"
+#include "StreamBuffer.h"
 //include glm features
 #include "GLM/glm.hpp"
 //import other required features
 #include <vector>
 
 namespace Titan {
+	//the data for each copy of a mesh in an instanced draw, read by the default vertex shaders from attribute slots 6-12
+	struct TTN_InstanceData {
+		//the model matrix of the instance (slots 6-9)
+		glm::mat4 Model;
+		//the normal matrix of the instance (slots 10-12)
+		glm::mat3 NormalMat;
+		//the index of the instance's material in the scene's material storage buffer (slot 13), only used with bindless textures
+		uint32_t MaterialIndex;
+	};
+
+	//the data a mesh is made from, kept on the cpu so it can be read and worked out on any thread (making the mesh itself needs opengl)
+	struct TTN_MeshData {
+		//the indices of the triangles (empty if the mesh isn't indexed)
+		std::vector<uint32_t> Indices;
+		//the uvs, shared by every frame
+		std::vector<glm::vec2> Uvs;
+		//the positions and normals of each frame
+		std::vector<std::vector<glm::vec3>> Positions;
+		std::vector<std::vector<glm::vec3>> Normals;
+	};
 
 	//class representing 3D meshes 
 	class TTN_Mesh {
@@ -21,6 +42,8 @@ namespace Titan {
 		static inline smptr Create() {
 			return std::make_shared<TTN_Mesh>();
 		}
+		//creates a mesh out of data that was read ahead of time (like on a loading thread), must be called on the thread with the opengl context
+		static smptr Create(TTN_MeshData& data);
 	public:
 		//ensuring moving and copying is not allowed so we can control destructor calls through pointers
 		TTN_Mesh(const TTN_Mesh& other) = delete;
@@ -38,23 +61,44 @@ namespace Titan {
 		//sets up the VAO for the mesh so it can acutally be rendered, called by the user (as they may change details of the mesh)
 		void SetUpVao(int currentFrame = 0, int nextFrame = 0);
 
+		//sets up the VAO to draw many copies of the mesh in one call, reading the model and normal matrices of each copy from the instance buffer
+		//the VAO is only rebuilt if the mesh or the instance buffer changed since the last call, draws pick their instances with the base instance
+		void SetUpInstancedVao(const TTN_StreamBuffer::ssbptr& instanceBuffer);
+
 		//SETTERS 
 		//sets the list of uvs for the mesh
 		void SetUVs(std::vector<glm::vec2>& uvs);
 		//sets the vertex colors of the mesh, returns wheter or not they were set succesfully
 		bool SetColors(std::vector<glm::vec3>& colors);
+		//sets the indices of the triangles, so vertices shared between triangles only have to be stored once (every frame of a morph animation uses the same ones)
+		void SetIndices(std::vector<uint32_t>& indices);
+		//sets the indices of the triangles straight from memory (like a mapped file) rather than a vector
+		void SetIndices(const uint32_t* indices, size_t count);
+		//sets the uvs straight from memory, halfFloats means each uv is 2 16 bit floats rather than 2 32 bit floats
+		void SetUVs(const void* uvs, size_t count, bool halfFloats);
 
 		//Adders
 		//adds a new set of verts to the class and creates a new vbo for them
 		void AddVertices(std::vector<glm::vec3>& verts);
 		//adds a new set of normals to the class and creates a new vbo for them
 		void AddNormals(std::vector<glm::vec3>& norms);
+		//adds a frame whose positions and normals are interleaved in one block of memory, uploaded to a single vbo as is
+		//each vertex is a vec3 position followed by either a vec3 normal, or a signed normalized 10_10_10_2 int if packedNormals is true
+		void AddInterleavedFrame(const void* data, size_t vertCount, bool packedNormals);
 
 		//GETTERS
 		//Gets the pointer to the meshes vao
 		TTN_VertexArrayObject::svaptr GetVAOPointer();
+		//Gets the pointer to the vao for instanced draws of the mesh (nullptr until SetUpInstancedVao is called)
+		TTN_VertexArrayObject::svaptr GetInstancedVAOPointer();
 		//Gets the number of the vertices in the mesh
 		int GetVertCount() { return m_Vertices[0].size(); }
+		//Gets wheter or not the mesh's triangles are drawn with an index buffer
+		bool GetHasIndices() { return m_ibo != nullptr; }
+		//Gets a list of the indices of the triangles (empty if the mesh isn't indexed)
+		std::vector<uint32_t> GetIndices() { return m_Indices; }
+		//Gets the index buffer (nullptr if the mesh isn't indexed)
+		TTN_IndexBuffer::sibptr GetIndexBuffer() { return m_ibo; }
 		//Gets wheter or not the mesh has vertex colors
 		bool GetHasVertColors() { return m_HasVertColors; }
 		//Gets a list of the vertex position
@@ -63,6 +107,27 @@ namespace Titan {
 		std::vector<glm::vec3> GetVertexNormals() { return m_Normals[0]; }
 		//Gets a list of the uvs
 		std::vector<glm::vec2> GetVertexUvs() { return m_Uvs; }
+		//Gets the number of frames (sets of vertices and normals) the mesh has, 1 unless it's a morph animation
+		int GetNumOfFrames() const { return (int)m_Vertices.size(); }
+		//Gets the vertex positions of a frame without copying them
+		const std::vector<glm::vec3>& GetFramePositions(int frame) const { return m_Vertices[frame]; }
+		//Gets the vertex normals of a frame without copying them
+		const std::vector<glm::vec3>& GetFrameNormals(int frame) const { return m_Normals[frame]; }
+		//Gets the uvs without copying them
+		const std::vector<glm::vec2>& GetUvsRef() const { return m_Uvs; }
+		//Gets the indices without copying them
+		const std::vector<uint32_t>& GetIndicesRef() const { return m_Indices; }
+		//Gets the corners of the box around every frame of the mesh, in the mesh's own space
+		glm::vec3 GetBoundsMin() const { return m_boundsMin; }
+		glm::vec3 GetBoundsMax() const { return m_boundsMax; }
+		//Gets the center and radius of the sphere around every frame of the mesh, in the mesh's own space
+		glm::vec3 GetBoundingSphereCenter() const { UpdateBoundingSphere(); return m_sphereCenter; }
+		float GetBoundingSphereRadius() const { UpdateBoundingSphere(); return m_sphereRadius; }
+		//works out the sphere from every frame if frames have been added since it was last worked out, the loaders call this once
+		//all their frames are in, otherwise it's done the first time the sphere is asked for
+		void UpdateBoundingSphere() const;
+		//Gets how many bytes the mesh's vertex and index buffers take up on the gpu
+		size_t GetMemorySize() const;
 
 	protected:
 		//a vector containing all the vertices on the mesh 
@@ -75,13 +140,48 @@ namespace Titan {
 		std::vector<glm::vec3> m_Colors;
 		//a boolean for if the mesh has colors
 		bool m_HasVertColors;
+		//a vector containing the indices of the triangles
+		std::vector<uint32_t> m_Indices;
+
+		//how a frame's positions and normals are laid out in their vbos, frames added with AddVertices and AddNormals have
+		//their own tightly packed vbo for each, interleaved frames share one vbo between them
+		struct FrameLayout {
+			GLsizei Stride = sizeof(glm::vec3);
+			size_t NormalOffset = 0;
+			bool PackedNormals = false;
+		};
+		std::vector<FrameLayout> m_frameLayouts;
+		//gets the attribute for reading the normals of a frame with the given layout into a slot
+		static BufferAttribute NormalAttribute(GLuint slot, const FrameLayout& layout);
+		//adds the mesh's vbos and ibo to a vao, reading the given frames
+		void AddMeshBuffers(const TTN_VertexArrayObject::svaptr& vao, int currentFrame, int nextFrame);
+		//wheter or not the uv vbo has 16 bit floats
+		bool m_halfFloatUvs;
+
+		//the box around every frame of the mesh, grown whenever a frame is added
+		glm::vec3 m_boundsMin;
+		glm::vec3 m_boundsMax;
+		bool m_hasBounds;
+		//the sphere around every frame of the mesh, worked out once after the frames are added (so it's mutable)
+		mutable glm::vec3 m_sphereCenter;
+		mutable float m_sphereRadius;
+		mutable bool m_sphereDirty;
+		//grows the box to fit a new frame's positions
+		void GrowBounds(const std::vector<glm::vec3>& frame);
 
 		//vbo smart pointers
 		std::vector<TTN_VertexBuffer::svbptr> m_vertVbos;
 		std::vector<TTN_VertexBuffer::svbptr> m_normVbos;
 		TTN_VertexBuffer::svbptr m_UVsVbo;
 		TTN_VertexBuffer::svbptr m_ColVbo;
+		//ibo smart pointer
+		TTN_IndexBuffer::sibptr m_ibo;
+		//the buffer with the per-instance data the instanced vao was set up with (owned by whatever draws the instances, like the scene)
+		TTN_StreamBuffer::ssbptr m_InstanceVbo;
 		//smart pointer with the VAO for the mesh 
 		TTN_VertexArrayObject::svaptr m_vao;
+		//the VAO for instanced draws, and wheter or not the mesh's buffers have changed since it was set up
+		TTN_VertexArrayObject::svaptr m_instancedVao;
+		bool m_instancedVaoDirty;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,66 @@
+//Titan Engine, by Atlas X Games
+// MeshCache.h - header for the class that bakes loaded meshes into binary files so they can be loaded again without parsing their source files
+#pragma once
+
+//include the mesh class so it can be baked and loaded
+#include "Mesh.h"
+#include "MappedFile.h"
+//import other required features
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Titan {
+	//class that reads and writes baked meshes, the source files (an obj, or every frame of a morph animation) are hashed and timestamped
+	//so editing any of them invalidates the baked copy
+	//a baked mesh is a header, then the indices, uvs, and each frame's interleaved positions and normals, every block 16 byte aligned
+	//so they can be uploaded straight out of the mapped file
+	class TTN_MeshCache {
+	public:
+		//turns the cache on or off, it's on by default
+		static void SetEnabled(bool enabled) { s_enabled = enabled; }
+		//returns wheter or not the cache is on
+		static bool GetEnabled() { return s_enabled; }
+
+		//sets wheter or not newly baked meshes are quantized, normals are packed into 10_10_10_2 ints and uvs into half floats
+		//it's off by default, meshes that have already been baked keep however they were baked until they're baked again
+		static void SetQuantized(bool quantized) { s_quantized = quantized; }
+		//returns wheter or not newly baked meshes are quantized
+		static bool GetQuantized() { return s_quantized; }
+
+		//sets the folder the baked meshes are written to and read from (relative to the working directory)
+		static void SetDirectory(const std::string& directory) { s_directory = directory; }
+		//gets the folder the baked meshes are written to and read from
+		static const std::string& GetDirectory() { return s_directory; }
+
+		//loads the baked copy of the mesh made from these source files, returns nullptr if there isn't one, the cache is off,
+		//or any of the source files have changed since it was baked
+		static TTN_Mesh::smptr Load(const std::vector<std::string>& sourceFiles);
+
+		//maps the baked copy of the mesh made from these source files and checks that it's still up to date, without touching opengl
+		//so it can be run on any thread, returns nullptr in the same cases as Load
+		static std::shared_ptr<TTN_MappedFile> Open(const std::vector<std::string>& sourceFiles);
+		//makes a mesh out of a baked copy returned by Open, must be called on the thread with the opengl context
+		static TTN_Mesh::smptr Upload(const TTN_MappedFile& file);
+
+		//bakes a mesh that was made from these source files, returns wheter or not it was written
+		static bool Save(const std::vector<std::string>& sourceFiles, const TTN_Mesh& mesh);
+		//bakes the data for a mesh that was made from these source files, doesn't touch opengl so it can be run on any thread
+		static bool Save(const std::vector<std::string>& sourceFiles, const TTN_MeshData& data);
+
+		//gets the path of the file the mesh made from these source files is baked to
+		static std::string GetCachePath(const std::vector<std::string>& sourceFiles);
+
+	protected:
+		TTN_MeshCache() = default;
+		~TTN_MeshCache() = default;
+
+	private:
+		//wheter or not the obj loader reads and writes baked meshes
+		inline static bool s_enabled = true;
+		//wheter or not new baked meshes are quantized
+		inline static bool s_quantized = false;
+		//the folder the baked meshes are in
+		inline static std::string s_directory = "cache/meshes";
+	};
+}
@@ -5,16 +5,28 @@
 //include the mesh class so we write the data to it 
 #include "Mesh.h"
 #include "Logging.h"
+//import other required features
+#include <functional>
 
 namespace Titan {
 	
 	//class to parse ObjFiles into TTN_Model objects
 	class TTN_ObjLoader {
 	public:
+		//loads a mesh from an obj file, vertices shared between triangles are only stored once and drawn with an index buffer
+		//the result is baked with TTN_MeshCache, so later loads of an unchanged file skip parsing it
 		static TTN_Mesh::smptr LoadFromFile(const std::string& fileName);
 
+		//loads a mesh with morph targets from a series of obj files named fileName_1.obj, fileName_2.obj, etc. (they all need the same faces)
 		static TTN_Mesh::smptr LoadAnimatedMeshFromFiles(const std::string& fileName, int numOfFiles);
 
+		//reads a mesh from an obj file (or it's baked copy) without touching opengl, so it can be run on any thread
+		//the mesh is made by calling the returned function, which has to be done on the thread with the opengl context
+		static std::function<TTN_Mesh::smptr()> ReadFromFile(const std::string& fileName);
+		//reads a mesh with morph targets the same way LoadAnimatedMeshFromFiles does, without touching opengl
+		//the mesh is made by calling the returned function, which has to be done on the thread with the opengl context
+		static std::function<TTN_Mesh::smptr()> ReadAnimatedMeshFromFiles(const std::string& fileName, int numOfFiles);
+
 	protected:
 		TTN_ObjLoader() = default;
 		~TTN_ObjLoader() = default;
@@ -7,6 +7,7 @@
 #include "GLM/glm.hpp"
 #include "GLM/gtx/quaternion.hpp"
 #include "Titan/Random.h"
+#include "Titan/StreamBuffer.h"
 #include <vector>
 #include <iostream>
 #include <algorithm>
@@ -20,6 +21,34 @@ namespace Titan {
 		CUBE = 3
 	};
 
+	//enum for where a particle system's particles are updated
+	enum class TTN_ParticleBackend {
+		//updated on the cpu and streamed to the gpu every frame
+		CPU = 0,
+		//emitted and updated on the gpu with transform feedback, the cpu does no per-particle work
+		GPU = 1
+	};
+
+	//the per-particle data sent to the gpu each frame, interleaved into one instance buffer
+	struct TTN_ParticleInstanceData {
+		glm::vec4 Color;
+		glm::vec3 Position;
+		float Scale;
+	};
+
+	//the state of a particle in the gpu backend, written by the update shader's transform feedback (so the order has to match it's outputs)
+	struct TTN_GPUParticle {
+		glm::vec4 StartColor;
+		glm::vec4 EndColor;
+		glm::vec3 Position;
+		float TimeAlive;
+		glm::vec3 StartVelocity;
+		float LifeTime;
+		glm::vec3 EndVelocity;
+		float StartScale;
+		float EndScale;
+	};
+
 	struct TTN_ParticleTemplate {
 		glm::vec4 _StartColor, _StartColor2;
 		glm::vec4 _EndColor, _EndColor2;
@@ -144,9 +173,9 @@ namespace Titan {
 		//default constructor
 		TTN_ParticleSystem();
 
-		//Constructor that takes data
+		//Constructor that takes data, the gpu backend can handle far more particles but falls back to the cpu if it isn't supported
 		TTN_ParticleSystem(size_t maxParticles, float emissionRate, TTN_ParticleTemplate particleTemplate,
-			float duration = 0.0f, bool loop = true);
+			float duration = 0.0f, bool loop = true, TTN_ParticleBackend backend = TTN_ParticleBackend::CPU);
 
 		//default destructor
 		~TTN_ParticleSystem();
@@ -154,6 +183,9 @@ namespace Titan {
 		//setsup the shader, called by titan's application init
 		static void InitParticleShader();
 
+		//checks if the current opengl context supports the gpu particle backend
+		static bool GetGPUBackendSupported();
+
 		//sets up emitter data
 		void MakeConeEmitter(float angle, glm::vec3 emitterRotation = glm::vec3(0.0f));
 		void MakeCircleEmitter(glm::vec3 emitterRotation = glm::vec3(0.0f));
@@ -178,7 +210,7 @@ namespace Titan {
 		float GetEmissionRate() { return m_emissionRate; }
 		glm::vec3 GetEmitterRotation() { return glm::degrees(m_rotation); }
 
-		//function pointer setters
+		//function pointer setters (only used by the cpu backend, the gpu backend always interpolates linearly)
 		void VelocityReadGraphCallback(float (*function)(float));
 		void ColorReadGraphCallback(float (*function)(float));
 		void RotationReadGraphCallback(float (*function)(float));
@@ -196,8 +228,20 @@ namespace Titan {
 		//emits that number of particles at that time
 		void Burst(size_t numOfParticles);
 
+		//gets how many particles are currently alive
+		//(the gpu backend never reads the particles back, so it's an estimate from how many were emitted within the longest lifetime)
+		size_t GetNumOfAliveParticles() { return m_numOfAliveParticles; }
+		//gets where the particles are updated
+		TTN_ParticleBackend GetBackend() { return m_backend; }
+
+		//sets how many particles a system needs to have alive before it's update gets split across the thread pool
+		//(the velocity readgraph gets called from the worker threads when it does, so it shouldn't touch anything shared)
+		static void SetMultithreadThreshold(size_t threshold) { s_multithreadThreshold = threshold; }
+		//gets how many particles a system needs before it's update is split across threads
+		static size_t GetMultithreadThreshold() { return s_multithreadThreshold; }
+
 	private:
-		//particle artibutes
+		//particle artibutes, the alive particles are packed at the front of the arrays (indices 0 to m_numOfAliveParticles - 1)
 		glm::vec3* Positions;
 
 		glm::vec4* StartColors;
@@ -211,12 +255,9 @@ namespace Titan {
 
 		float* timeAlive;
 		float* lifeTimes;
-		bool* Active;
 
-		//render data
-		glm::vec3* particle_pos;
-		glm::vec4* particle_col;
-		float* particle_scale;
+		//scratch space for the velocity interpolation weights during the update
+		float* m_veloWeights;
 
 		//setable system data
 		glm::vec3 m_rotation;
@@ -230,18 +271,41 @@ namespace Titan {
 		float m_emissionTimer;
 
 		//other data
-		size_t m_activeParticleIndex;
+		TTN_ParticleBackend m_backend;
+		size_t m_numOfAliveParticles;
+		//the next particle to be replaced when a particle is emitted while the system is full
+		size_t m_recycleIndex;
 		float m_durationRemaining;		
 		size_t m_maxParticlesCount;
+		inline static size_t s_multithreadThreshold = 4096;
 		inline static TTN_Shader::sshptr s_particleShaderProgram;
 		inline static TTN_Texture2D::st2dptr s_defaultWhiteTexture;
 		TTN_VertexArrayObject::svaptr m_vao;
 		TTN_VertexBuffer::svbptr VertexPosVBO;
 		TTN_VertexBuffer::svbptr VertexNormVBO;
 		TTN_VertexBuffer::svbptr VertexUVVBO;
-		TTN_VertexBuffer::svbptr ColorInstanceBuffer;
-		TTN_VertexBuffer::svbptr PositionInstanceBuffer;
-		TTN_VertexBuffer::svbptr ScaleInstanceBuffer;
+		//the instance data for all the particles, rewritten every frame
+		TTN_StreamBuffer::ssbptr m_instanceBuffer;
+
+		//gpu backend data
+		inline static TTN_Shader::sshptr s_particleUpdateShader;
+		inline static TTN_Shader::sshptr s_particleGPUShaderProgram;
+		//the particle state, ping-ponged between the 2 buffers every update
+		TTN_VertexBuffer::svbptr m_stateBuffers[2];
+		//the vaos that read each state buffer for updating, and for rendering
+		TTN_VertexArrayObject::svaptr m_updateVaos[2];
+		TTN_VertexArrayObject::svaptr m_renderVaos[2];
+		//the transform feedback objects that write into each state buffer
+		GLuint m_transformFeedbacks[2];
+		//the index of the state buffer with the latest state
+		int m_currentState;
+		//the particles emitted since the last update, and where the next emitted particle goes
+		size_t m_pendingEmits;
+		size_t m_spawnIndex;
+		//the seed for the update shader's random numbers, changed every update
+		int m_seed;
+		//how much longer each batch of emitted particles could be alive for, and how many there were, used to estimate the alive count
+		std::vector<std::pair<float, size_t>> m_emittedBatches;
 
 		//function pointers for lerp
 		float (*readGraphVelo)(float);
@@ -250,6 +314,22 @@ namespace Titan {
 		float (*readGraphScale)(float);
 
 		void SetUpRenderingStuff();
+		//loads the particle template's mesh into the vbos
+		void LoadMeshData();
+		//sets up the buffers, vaos, and transform feedback objects for the gpu backend
+		void SetUpGPUStuff();
+
+		//emits the pending particles and moves all of them forward on the gpu
+		void UpdateGPU(float deltaTime);
+		//renders the particles straight from the gpu state
+		void RenderGPU(glm::vec3 ParentGlobalPos, glm::mat4 view, glm::mat4 projection);
+
+		//gets the index a newly emitted particle should go in
+		size_t GetEmitIndex();
+		//kills a particle by moving the last alive particle into it's place
+		void KillParticle(size_t index);
+		//ages and moves the alive particles in the range [begin, end)
+		void UpdateParticles(size_t begin, size_t end, float deltaTime);
 	};
 
 	//class for a particle system compomenet
@@ -23,6 +23,51 @@ namespace Titan {
 		KINEMATIC = 2
 	};
 
+	//the shapes a physics body's collider can be
+	enum class TTN_ShapeType {
+		//a box the size of the scale
+		BOX = 0,
+		//a simplified convex hull around a mesh's vertices
+		CONVEX_HULL = 1,
+		//a few convex hulls around pieces of a mesh, for concave props
+		COMPOUND = 2
+	};
+
+	//motion state that bullet writes the transforms of moving bodies to, each time it's written it adds it's entity to the scene's list of
+	//moved bodies, so the scene only has to copy transforms back for bodies that acutally moved (sleeping and static bodies never get written)
+	class TTN_MotionState : public btMotionState {
+	public:
+		//constructor, starts at the given transform and doesn't report moves until it's given a list
+		TTN_MotionState(const btTransform& startTrans)
+			: m_trans(startTrans), m_movedList(nullptr), m_entity(entt::null) {}
+
+		//destructor
+		virtual ~TTN_MotionState() = default;
+
+		//called by bullet to get the transform of the body
+		void getWorldTransform(btTransform& worldTrans) const override { worldTrans = m_trans; }
+		//called by bullet when the body moves, saves the transform and reports the move
+		void setWorldTransform(const btTransform& worldTrans) override {
+			m_trans = worldTrans;
+			if (m_movedList != nullptr)
+				m_movedList->push_back(m_entity);
+		}
+
+		//sets the list moves are reported to, and the entity they're reported as
+		void SetMovedList(std::vector<entt::entity>* movedList, entt::entity entity) {
+			m_movedList = movedList;
+			m_entity = entity;
+		}
+
+	private:
+		//the transform of the body
+		btTransform m_trans;
+		//the list moves are reported to
+		std::vector<entt::entity>* m_movedList;
+		//the entity the body belongs to
+		entt::entity m_entity;
+	};
+
 	class TTN_Physics
 	{
 	public:
@@ -32,6 +77,10 @@ namespace Titan {
 		//contrustctor with data
 		TTN_Physics(glm::vec3 position, glm::vec3 rotation, glm::vec3 scale, entt::entity entityNum, TTN_PhysicsBodyType bodyType = TTN_PhysicsBodyType::DYNAMIC, float mass = 1.0f);
 
+		//constructor with data that makes the collider out of a mesh (scaled by the scale) instead of a box, the mesh's first frame is used
+		TTN_Physics(glm::vec3 position, glm::vec3 rotation, glm::vec3 scale, entt::entity entityNum, TTN_Mesh::smptr mesh,
+			TTN_ShapeType shapeType = TTN_ShapeType::CONVEX_HULL, TTN_PhysicsBodyType bodyType = TTN_PhysicsBodyType::DYNAMIC, float mass = 1.0f);
+
 		~TTN_Physics();
 
 		//copy, move, and assingment constrcutors for ENTT
@@ -57,13 +106,24 @@ namespace Titan {
 			else return false;
 		}
 		float GetMass() { return m_Mass; }
+		TTN_ShapeType GetShapeType() { return m_shapeType; }
 		btRigidBody* GetRigidBody() { return m_body; }
+		TTN_MotionState* GetMotionState() { return m_MotionState; }
+		bool GetCanSleep() { return m_canSleep; }
+		//gets wheter or not bullet has put the body to sleep
+		bool GetIsSleeping() { return m_body->getActivationState() == ISLAND_SLEEPING; }
 		bool GetIsInWorld() { return m_InWorld; }
 		glm::vec3 GetLinearVelocity();
 		glm::vec3 GetAngularVelocity();
 		glm::vec3 GetPos();
 		bool GetHasGravity() { return m_hasGravity; }
 		entt::entity GetEntity() { return m_entity; }
+		//gets wheter or not the body's continuous collision detection is sized automatically
+		bool GetUseCcd() { return m_useCcd; }
+		float GetCcdMotionThreshold() { return (float)m_body->getCcdMotionThreshold(); }
+		float GetCcdSweptSphereRadius() { return (float)m_body->getCcdSweptSphereRadius(); }
+		uint32_t GetCollisionGroup() { return m_collisionGroup; }
+		uint32_t GetCollisionMask() { return m_collisionMask; }
 
 		//setters
 		void SetIsInWorld(bool inWorld);
@@ -72,6 +132,22 @@ namespace Titan {
 		void SetAngularVelocity(glm::vec3 velocity);
 		void SetPos(glm::vec3 position);
 		void SetHasGravity(bool hasGrav);
+		//sets wheter or not bullet can put the body to sleep when it stops moving, bodies can't sleep by default
+		//a sleeping body isn't simulated or synced with it's transform until something touches it, or a force or velocity is set on it
+		void SetCanSleep(bool canSleep);
+		//turns continuous collision detection on or off, it's sized from the body's collider so fast bodies (like cannonballs) can't pass
+		//through thin ones between physics steps, bullet only sweeps the body on steps where it moves (velocity * time step) further than
+		//the motion threshold, so it costs nothing while the body is slow
+		void SetUseCcd(bool useCcd);
+		//sets how far the body has to move in one physics step before it's swept, 0 turns continuous collision detection off
+		void SetCcdMotionThreshold(float threshold);
+		//sets the radius of the sphere that's swept along the body's motion, it should fit inside the collider
+		void SetCcdSweptSphereRadius(float radius);
+		//sets the collision group bits of the body, reported in collision events so they can be filtered without looking up components
+		void SetCollisionGroup(uint32_t group);
+		//sets which collision groups the body can collide with, two bodies are only tested against each other if each one's group is in
+		//the other's mask, so bullet's broadphase never makes pairs for them (bodies already overlapping stay paired until they separate)
+		void SetCollisionMask(uint32_t mask);
 
 		//forces
 		void AddForce(glm::vec3 force);
@@ -89,63 +165,66 @@ namespace Titan {
 		//bullet data
 		float m_Mass; //mass of the object
 		bool m_hasGravity; //is the object affected by gravity
-		btCollisionShape* m_colShape; //the shape of it's collider, includes scale
+		TTN_ShapeType m_shapeType; //what kind of shape it's collider is
+		btCollisionShape* m_colShape; //the shape of it's collider, includes scale, shared with every other body the same size (and mesh)
 		btTransform m_bulletTrans;  //it's internal transform, does not include scale
-		btDefaultMotionState* m_MotionState; //motion state for it, need to extract the transform out of this every update if the body is dynamic
+		TTN_MotionState* m_MotionState; //motion state for it, bullet writes the transform to this whenever the body moves
 		btRigidBody* m_body; //rigidbody, acutally does the collision stuff, have to get the transform out of this every update if the body is static
+		bool m_canSleep; //wheter or not bullet can deactivate the body when it's been still for a while
+		bool m_useCcd; //wheter or not continuous collision detection is on and sized from the collider
 		bool m_InWorld; //boolean marking if it's been added to the bullet physics world yet, used to make sure that the physics body
 
 		entt::entity m_entity; //the entity number that gets stored as a void pointer in bullet so that it can be used to indentify the objects later
+		uint32_t m_collisionGroup; //the collision group bits, also stored as the user index in bullet so the scene can read them from the manifolds
+		uint32_t m_collisionMask; //the groups this body collides with, passed to bullet's broadphase filtering along with the group
+
+		//makes the motion state and rigidbody around the collision shape, the transform and shape need to be set first
+		void SetUpBody(entt::entity entityNum, TTN_PhysicsBodyType bodyType, float mass);
 	};
 
-	class TTN_Collision {
-	public:
-		//defines a special easier to use name for the shared(smart) pointer to the class
-		typedef std::shared_ptr<TTN_Collision> scolptr;
+	//the types of collision events
+	enum class TTN_CollisionEventType {
+		//the bodies started touching this frame
+		BEGIN = 0,
+		//the bodies were touching last frame but aren't anymore (either entity may have been deleted since)
+		END = 1
+	};
 
-		//creates and returns a shared(smart) pointer to the class
-		static inline scolptr Create() {
-			return std::make_shared<TTN_Collision>();
+	//a change in wheter or not two physics bodies are touching, the scene makes these out of bullet's contact manifolds once a frame
+	struct TTN_CollisionEvent {
+		//wheter the bodies started or stopped touching
+		TTN_CollisionEventType Type;
+		//the entities the bodies belong to, Body1 always has the lower entity number
+		entt::entity Body1;
+		entt::entity Body2;
+		//the collision groups of each body
+		uint32_t Group1;
+		uint32_t Group2;
+
+		//checks if one of the bodies is in groupA and the other is in groupB
+		bool IsBetween(uint32_t groupA, uint32_t groupB) const {
+			return ((Group1 & groupA) && (Group2 & groupB)) || ((Group1 & groupB) && (Group2 & groupA));
 		}
-	public:
-		//ensure moving and copying is not allowed so we can control destructor calls through pointers
-		TTN_Collision(const TTN_Collision& other) = delete;
-		TTN_Collision(TTN_Collision& other) = delete;
-		TTN_Collision& operator=(const TTN_Collision& other) = delete;
-		TTN_Collision& operator=(TTN_Collision&& other) = delete;
-
-	public:
-		//constructor
-		TTN_Collision();
-
-		//destructor
-		~TTN_Collision() = default;
-
-		//getters
-		const entt::entity GetBody1() { return b1; }
-		const entt::entity GetBody2() { return b2; }
+		//gets the body that isn't the given one
+		entt::entity GetOther(entt::entity body) const { return (body == Body1) ? Body2 : Body1; }
+	};
 
-		//setters
-		void SetBody1(const entt::entity body);
-		void SetBody2(const entt::entity body);
-
-		//checks if two collisions pointers represent a collision between the same objects
-		static bool same(scolptr collision1, scolptr collision2) {
-			//compare the entity numbers
-			if ((collision1->b1 == collision2->b1 && collision1->b2 == collision2->b2) ||
-				(collision1->b1 == collision2->b2 && collision1->b2 == collision2->b1)) {
-				//if they match across the collisions, then return true
-				return true;
-			}
-			else
-				//otherwise return false
-				return false;
-		}
+	//a ray for the scene's raycasts, from one point to another
+	struct TTN_Ray {
+		glm::vec3 From;
+		glm::vec3 To;
+	};
 
-	protected:
-		//rigidbodies for the colliding objects (which should also contain a reference to the entity)
-		entt::entity b1;
-		entt::entity b2;
+	//the closest thing a ray hit
+	struct TTN_RaycastHit {
+		//wheter or not the ray hit anything, the rest is only set if it did
+		bool Hit;
+		//the entity the body that was hit belongs to
+		entt::entity Entity;
+		//where the ray hit, and the normal of the surface there
+		glm::vec3 Point;
+		glm::vec3 Normal;
+		//how far along the ray the hit was (0 at the start, 1 at the end)
+		float Fraction;
 	};
- 
 }
\ No newline at end of file
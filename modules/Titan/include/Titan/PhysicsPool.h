@@ -0,0 +1,115 @@
+//Titan Engine, by Atlas X Games
+// PhysicsPool.h - header for the class that shares collision shapes between physics bodies and recycles their bullet objects
+#pragma once
+
+//include the physics header for the motion state
+#include "Physics.h"
+//include glm features
+#include "GLM/glm.hpp"
+//import other required features
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+//import the bullet physics engine
+#include <btBulletDynamicsCommon.h>
+
+namespace Titan {
+	//class that hands out the bullet objects for physics bodies
+	//collision shapes are shared between every body with the same type, size, and mesh, and are kept until the pool is cleared
+	//motion states and rigid bodies are built in blocks of memory that go on a free list when they're released instead of being freed,
+	//so spawning and deleting bodies (like cannonballs) doesn't hit the heap once the pool has warmed up
+	class TTN_PhysicsPool {
+	public:
+		//turns recycling on or off, it's on by default, when it's off every motion state and rigid body gets it's own allocation
+		//and is freed when it's released (shapes are still shared)
+		static void SetEnabled(bool enabled);
+		//returns wheter or not recycling is on
+		static bool GetEnabled() { return s_enabled; }
+
+		//gets the shared box shape with the given half extents, making it if no body has used it yet
+		static btCollisionShape* GetBoxShape(glm::vec3 halfExtents);
+
+		//gets the shared convex hull of a mesh's first frame scaled by the scale, returns nullptr if the mesh doesn't have enough vertices
+		//the hull is simplified down to at most a few dozen points and only built the first time a mesh is used
+		static btCollisionShape* GetConvexHullShape(const TTN_Mesh::smptr& mesh, glm::vec3 scale);
+		//gets the shared compound shape for a concave mesh scaled by the scale, returns nullptr if the mesh doesn't have any triangles
+		//the triangles are split into the given number of slabs along the mesh's longest side and each slab gets it's own convex hull
+		static btCollisionShape* GetCompoundShape(const TTN_Mesh::smptr& mesh, glm::vec3 scale, int pieces = 4);
+
+		//makes a motion state starting at the given transform
+		static TTN_MotionState* AcquireMotionState(const btTransform& startTrans);
+		//makes a rigid body from the construction info
+		static btRigidBody* AcquireRigidBody(const btRigidBody::btRigidBodyConstructionInfo& info);
+		//gives a motion state back to the pool, it shouldn't be used after this
+		static void ReleaseMotionState(btMotionState* motionState);
+		//gives a rigid body back to the pool, it has to have been removed from the physics world first, and shouldn't be used after this
+		static void ReleaseRigidBody(btRigidBody* body);
+
+		//deletes every shared shape and everything on the free lists, only call this when no bodies are using them
+		static void Clear();
+
+		//gets the number of shapes being shared
+		static size_t GetNumOfShapes() { return s_shapes.size(); }
+		//gets the number of blocks of memory that have been allocated for motion states and rigid bodies
+		static uint64_t GetNumOfAllocations() { return s_allocations; }
+		//gets the number of motion states and rigid bodies that were built in recycled memory
+		static uint64_t GetNumOfReuses() { return s_reuses; }
+		//resets the allocation and reuse counts
+		static void ResetStats() { s_allocations = 0; s_reuses = 0; }
+
+	protected:
+		TTN_PhysicsPool() = default;
+		~TTN_PhysicsPool() = default;
+
+	private:
+		//the key shapes are shared under, the type, the exact bits of the size, and the mesh (and how many pieces it was split into) if it has one
+		struct ShapeKey {
+			TTN_ShapeType Type;
+			glm::vec3 Size;
+			const TTN_Mesh* Mesh;
+			int Pieces;
+
+			bool operator==(const ShapeKey& other) const {
+				return Type == other.Type && Size == other.Size && Mesh == other.Mesh && Pieces == other.Pieces;
+			}
+		};
+		//hashes a shape key
+		struct ShapeKeyHash {
+			size_t operator()(const ShapeKey& key) const;
+		};
+
+		//the simplified hulls built from a mesh, kept unscaled so any scale of the mesh can reuse them
+		struct MeshHulls {
+			//the mesh they were built from, so a new mesh at the same address isn't given an old mesh's hulls
+			std::weak_ptr<TTN_Mesh> Mesh;
+			//the hull points, keyed by the number of pieces the mesh was split into (1 for a single convex hull)
+			std::unordered_map<int, std::vector<std::vector<btVector3>>> Pieces;
+		};
+
+		//gets the hulls of a mesh split into the given number of pieces, building them if they haven't been yet
+		static const std::vector<std::vector<btVector3>>& GetMeshHulls(const TTN_Mesh::smptr& mesh, int pieces);
+		//deletes a shape, and it's children if it's a compound shape
+		static void DeleteShape(btCollisionShape* shape);
+
+		//gets a block of memory of the given size, off the free list if there is one
+		static void* AcquireBlock(std::vector<void*>& freeList, size_t size);
+		//gives a block of memory back to the free list, or frees it if recycling is off
+		static void ReleaseBlock(std::vector<void*>& freeList, void* block);
+
+		//wheter or not motion states and rigid bodies are recycled
+		inline static bool s_enabled = true;
+		//the shared shapes
+		inline static std::unordered_map<ShapeKey, btCollisionShape*, ShapeKeyHash> s_shapes;
+		//the hulls built from each mesh
+		inline static std::unordered_map<const TTN_Mesh*, MeshHulls> s_meshHulls;
+		//shapes from meshes that have since been deleted, bodies might still be using them so they're kept until the pool is cleared
+		inline static std::vector<btCollisionShape*> s_retiredShapes;
+		//the free lists of memory for motion states and rigid bodies
+		inline static std::vector<void*> s_freeMotionStates;
+		inline static std::vector<void*> s_freeRigidBodies;
+		//the stats
+		inline static uint64_t s_allocations = 0;
+		inline static uint64_t s_reuses = 0;
+	};
+}
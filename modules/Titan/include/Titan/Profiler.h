@@ -0,0 +1,101 @@
+//Titan Engine, by Atlas X Games
+// Profiler.h - header for the class that times the different phases of a frame so they can be benchmarked
+#pragma once
+
+//import required features
+#include <chrono>
+#include <cstdint>
+
+namespace Titan {
+	//enum for the different phases of a frame that titan can time
+	enum class TTN_ProfilePhase {
+		PHYSICS_STEP = 0,
+		PHYSICS_SYNC = 1,
+		CONSTRUCT_COLLISIONS = 2,
+		RENDER_SORT = 3,
+		RENDER_UNIFORMS = 4,
+		RENDER_DRAW = 5,
+		WORLD_MATRICES = 6,
+		SPATIAL_QUERIES = 7,
+		COUNT = 8
+	};
+
+	//enum for the things titan can count over a frame
+	enum class TTN_ProfileCounter {
+		PARTICLE_BYTES_UPLOADED = 0,
+		CONTACT_MANIFOLDS = 1,
+		PHYSICS_BODIES_SYNCED = 2,
+		PHYSICS_SUBSTEPS = 3,
+		RENDER_ENTITIES_TESTED = 4,
+		RENDER_ENTITIES_CULLED = 5,
+		RENDER_ENTITIES_DRAWN = 6,
+		COUNT = 7
+	};
+
+	//class that stores how long each phase of the current frame took
+	class TTN_Profiler {
+	public:
+		//turns the profiler on or off, it's off by default so the game doesn't pay for the timers
+		static void SetEnabled(bool enabled) { s_enabled = enabled; }
+		//returns wheter or not the profiler is on
+		static bool GetEnabled() { return s_enabled; }
+
+		//clears the timings and counters from the last frame, should be called at the start of every frame
+		static void BeginFrame();
+
+		//adds time (in milliseconds) to a phase of the current frame
+		static void AddTime(TTN_ProfilePhase phase, double ms) { s_phaseTimes[(int)phase] += ms; }
+		//gets the time (in milliseconds) spent in a phase during the current frame
+		static double GetTime(TTN_ProfilePhase phase) { return s_phaseTimes[(int)phase]; }
+
+		//gets the name of a phase, for printing results
+		static const char* GetPhaseName(TTN_ProfilePhase phase);
+
+		//adds to one of the counters for the current frame
+		static void AddCount(TTN_ProfileCounter counter, uint64_t amount) { s_counts[(int)counter] += amount; }
+		//gets the value of one of the counters for the current frame
+		static uint64_t GetCount(TTN_ProfileCounter counter) { return s_counts[(int)counter]; }
+
+		//gets the name of a counter, for printing results
+		static const char* GetCounterName(TTN_ProfileCounter counter);
+
+	private:
+		//wheter or not the profiler is timing anything
+		inline static bool s_enabled = false;
+		//the time spent in each phase this frame
+		inline static double s_phaseTimes[(int)TTN_ProfilePhase::COUNT] = {};
+		//the counters for this frame
+		inline static uint64_t s_counts[(int)TTN_ProfileCounter::COUNT] = {};
+	};
+
+	//timer that adds the time between it's construction and destruction to a phase, only does anything when the profiler is on
+	class TTN_ProfileScope {
+	public:
+		//constructor, starts the timer
+		TTN_ProfileScope(TTN_ProfilePhase phase)
+			: m_phase(phase), m_active(TTN_Profiler::GetEnabled())
+		{
+			if (m_active) m_start = std::chrono::high_resolution_clock::now();
+		}
+
+		//destructor, stops the timer and adds the time to the phase
+		~TTN_ProfileScope() {
+			if (m_active) {
+				std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - m_start;
+				TTN_Profiler::AddTime(m_phase, elapsed.count());
+			}
+		}
+
+		//the timer shouldn't be copied or moved
+		TTN_ProfileScope(const TTN_ProfileScope&) = delete;
+		TTN_ProfileScope& operator=(const TTN_ProfileScope&) = delete;
+
+	private:
+		//the phase being timed
+		TTN_ProfilePhase m_phase;
+		//wheter or not the profiler was on when the timer started
+		bool m_active;
+		//when the timer started
+		std::chrono::high_resolution_clock::time_point m_start;
+	};
+}
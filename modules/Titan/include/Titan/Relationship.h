@@ -0,0 +1,48 @@
+//Titan Engine, by Atlas X Games
+// Relationship.h - header for the class that represents the component linking an entity to it's parent, children, and siblings
+#pragma once
+
+//include the entity component system header
+#include "entt.hpp"
+
+namespace Titan {
+	class TTN_Scene;
+
+	//relationship component, stores the scenegraph as entity ids so it stays valid no matter how entt moves the components around
+	//the children of an entity are a linked list, starting at it's first child and going through each child's next sibling
+	//the links are managed by the scene (TTN_Scene::SetParent), so they are read only from here
+	class TTN_Relationship {
+	public:
+		//default constructor, not linked to anything
+		TTN_Relationship() = default;
+
+		//default destructor
+		~TTN_Relationship() = default;
+
+		//copy, move, and assingment constrcutors for ENTT
+		TTN_Relationship(const TTN_Relationship&) = default;
+		TTN_Relationship(TTN_Relationship&&) = default;
+		TTN_Relationship& operator=(const TTN_Relationship&) = default;
+
+		//gets the entity's parent (entt::null if it doesn't have one)
+		entt::entity GetParent() const { return m_Parent; }
+		//gets the entity's first child (entt::null if it doesn't have any)
+		entt::entity GetFirstChild() const { return m_FirstChild; }
+		//gets the next child of this entity's parent (entt::null if this is the last one)
+		entt::entity GetNextSibling() const { return m_NextSibling; }
+		//gets the previous child of this entity's parent (entt::null if this is the first one)
+		entt::entity GetPrevSibling() const { return m_PrevSibling; }
+		//gets how many children the entity has
+		size_t GetNumberOfChildren() const { return m_NumChildren; }
+
+	private:
+		//the scene does all the linking and unlinking
+		friend class TTN_Scene;
+
+		entt::entity m_Parent = entt::null;
+		entt::entity m_FirstChild = entt::null;
+		entt::entity m_NextSibling = entt::null;
+		entt::entity m_PrevSibling = entt::null;
+		size_t m_NumChildren = 0;
+	};
+}
@@ -52,6 +52,9 @@ namespace Titan {
 		const int GetRenderLayer() const { return m_RenderLayer; }
 
 		void Render(glm::mat4 model, glm::mat4 VP);
+		//draws a number of copies of the mesh in one call, the mesh's instanced vao needs to have been set up with SetUpInstancedVao first
+		//the copies read their data from the instance buffer starting at element baseInstance
+		void RenderInstanced(size_t numOfInstances, size_t baseInstance = 0);
 
 	private:
 		//a pointer to the shader that should be used to render this object
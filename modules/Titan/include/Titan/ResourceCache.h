@@ -0,0 +1,131 @@
+//Titan Engine, by Atlas X Games
+// ResourceCache.h - header for the class that shares loaded textures, meshes, and shaders so the same file is only loaded once
+#pragma once
+
+//include the resource classes it shares
+#include "Mesh.h"
+#include "Shader.h"
+#include "Texture2D.h"
+#include "TextureCubeMap.h"
+//import other required features
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace Titan {
+	//the types of resources the cache keeps track of
+	enum class TTN_ResourceType {
+		TEXTURE_2D = 0,
+		TEXTURE_CUBEMAP = 1,
+		MESH = 2,
+		SHADER = 3,
+		COUNT = 4
+	};
+
+	//stats for one type of resource
+	struct TTN_ResourceStats {
+		//the number of resources in the cache that are still alive
+		size_t Count = 0;
+		//roughly how many bytes they take up on the gpu
+		size_t MemorySize = 0;
+		//the number of times a resource was asked for and was already loaded
+		uint64_t Hits = 0;
+		//the number of times a resource was asked for and had to be loaded
+		uint64_t Misses = 0;
+	};
+
+	//class that hands out shared pointers to resources loaded from files, keyed by their path (and whatever else changes what's loaded,
+	//like wheter a texture is flipped), so asking for the same file twice gives back the same resource without touching the disk or opengl
+	//the cache only holds weak pointers, so a resource is freed as soon as nothing else is using it, unless unused resources are retained
+	//everything that's shared is shared, so changing a cached resource (like a texture's filters) changes it for everyone using it
+	//uses opengl, so only call it from the main thread
+	class TTN_ResourceCache {
+	public:
+		//gets a 2D texture loaded from an image (or dds file), loading it if it isn't already
+		static TTN_Texture2D::st2dptr GetTexture2D(const std::string& fileName, bool flipped = true, bool forceRgba = false);
+		//gets a cubemap loaded from 6 images, named the same way as TTN_TextureCubeMap::LoadFromImages expects, loading it if it isn't already
+		static TTN_TextureCubeMap::stcmptr GetTextureCubeMap(const std::string& filePath);
+		//gets a mesh loaded from an obj file, loading it if it isn't already
+		static TTN_Mesh::smptr GetMesh(const std::string& fileName);
+		//gets a mesh with morph targets loaded from a series of obj files named fileName_1.obj, fileName_2.obj, etc., loading it if it isn't already
+		static TTN_Mesh::smptr GetAnimatedMesh(const std::string& fileName, int numOfFiles);
+		//gets a shader program linked from a vertex and fragment shader file, loading it if it isn't already
+		static TTN_Shader::sshptr GetShader(const std::string& vertexFile, const std::string& fragmentFile);
+		//gets a shader program linked from 2 of titan's default shaders, loading it if it isn't already
+		static TTN_Shader::sshptr GetDefaultShader(TTN_DefaultShaders vertexShader, TTN_DefaultShaders fragmentShader);
+
+		//gets the keys the resources are cached under, for loaders that load resources themselves (like the asset loader) and add them with Add
+		//paths are tidied up first, so textures/a.png and textures/../textures/a.png are the same file
+		static std::string GetTexture2DKey(const std::string& fileName, bool flipped, bool forceRgba);
+		static std::string GetTextureCubeMapKey(const std::string& filePath);
+		static std::string GetMeshKey(const std::string& fileName, int numOfFiles = 0);
+		static std::string GetShaderKey(const std::string& vertexFile, const std::string& fragmentFile);
+
+		//finds a resource in the cache, returns nullptr if it isn't there (or has since been freed)
+		template<typename T>
+		static std::shared_ptr<T> Find(TTN_ResourceType type, const std::string& key);
+		//adds a resource to the cache under the given key, replacing whatever was there
+		static void Add(TTN_ResourceType type, const std::string& key, const std::shared_ptr<void>& resource);
+
+		//sets wheter or not the cache keeps resources alive after nothing else is using them, it's off by default
+		//turning it on before swapping or reloading scenes means the new scene finds everything the old one loaded, call
+		//ReleaseUnused once it's set up to free what it didn't use
+		static void SetRetainUnused(bool retain) { s_retainUnused = retain; }
+		//gets wheter or not the cache keeps resources alive after nothing else is using them
+		static bool GetRetainUnused() { return s_retainUnused; }
+		//frees the resources the cache is keeping alive that nothing else is using, and forgets the ones that have been freed
+		static void ReleaseUnused();
+		//forgets every resource, the ones still in use stay alive but won't be handed out again
+		static void Clear();
+
+		//gets the stats for one type of resource
+		static TTN_ResourceStats GetStats(TTN_ResourceType type);
+		//resets the hit and miss counts
+		static void ResetStats();
+
+	protected:
+		TTN_ResourceCache() = default;
+		~TTN_ResourceCache() = default;
+
+	private:
+		//a cached resource
+		struct Entry {
+			//the resource itself
+			std::weak_ptr<void> Resource;
+			//a strong pointer to it, only set when unused resources are retained
+			std::shared_ptr<void> Retained;
+		};
+
+		//gets roughly how many bytes a resource of the given type takes up on the gpu
+		static size_t GetMemorySize(TTN_ResourceType type, const std::shared_ptr<void>& resource);
+
+		//the resources of each type, keyed by their path
+		inline static std::unordered_map<std::string, Entry> s_entries[(int)TTN_ResourceType::COUNT];
+		//the hit and miss counts of each type
+		inline static uint64_t s_hits[(int)TTN_ResourceType::COUNT] = {};
+		inline static uint64_t s_misses[(int)TTN_ResourceType::COUNT] = {};
+		//wheter or not unused resources are kept alive
+		inline static bool s_retainUnused = false;
+	};
+
+	//finds a resource in the cache
+	template<typename T>
+	inline std::shared_ptr<T> TTN_ResourceCache::Find(TTN_ResourceType type, const std::string& key)
+	{
+		std::unordered_map<std::string, Entry>& entries = s_entries[(int)type];
+		auto it = entries.find(key);
+		std::shared_ptr<void> resource = (it != entries.end()) ? it->second.Resource.lock() : nullptr;
+
+		//forget it if it's been freed
+		if (resource == nullptr) {
+			if (it != entries.end())
+				entries.erase(it);
+			s_misses[(int)type]++;
+			return nullptr;
+		}
+
+		s_hits[(int)type]++;
+		return std::static_pointer_cast<T>(resource);
+	}
+}
@@ -5,6 +5,7 @@
 #include "entt.hpp"
 //include all the component class definitions we need
 #include "Transform.h"
+#include "Relationship.h"
 #include "Renderer.h"
 #include "Camera.h"
 #include "Light.h"
@@ -14,26 +15,59 @@
 #include "Particle.h"
 //include all the graphics features we need
 #include "Shader.h"
+#include "UniformBuffer.h"
+#include "ShaderStorageBuffer.h"
+#include "Frustum.h"
+//import other required features
+#include <unordered_map>
+#include <cfloat>
+
+//bullet's task scheduler and broadphase tree nodes, only the scene source needs the whole things
+class btITaskScheduler;
+struct btDbvtNode;
 
 namespace Titan {
 	typedef entt::basic_group<entt::entity, entt::exclude_t<>, entt::get_t<>, TTN_Transform, TTN_Renderer> RenderGroupType;
 
+	//the data the scene uploads once a frame for every shader to read, laid out to match the std140 TTN_SceneData block in the shaders
+	//(everything is a vec4 or mat4 so the c++ and glsl layouts line up without extra padding)
+	struct TTN_SceneUniformData {
+		glm::mat4 View;
+		glm::mat4 Projection;
+		glm::mat4 ViewProjection;
+		//camera position in xyz
+		glm::vec4 CamPos;
+		//ambient color in rgb, ambient strength in a
+		glm::vec4 Ambient;
+		//light positions in xyz
+		glm::vec4 LightPos[16];
+		//light colors in rgb
+		glm::vec4 LightCol[16];
+		//ambient strength in x, specular strength in y
+		glm::vec4 LightStrength[16];
+		//constant attenuation in x, linear in y, quadratic in z
+		glm::vec4 LightAttenuation[16];
+		//how many of the lights are actually in use
+		int NumOfLights;
+		int padding[3];
+	};
+
 	//scene class, handles the ECS, render class, etc. 
 	class TTN_Scene
 	{
 	public:
-		//constructor 
-		TTN_Scene();
+		//constructor, physicsWorkers is the number of threads bullet can split the physics step across (0 keeps the single threaded world)
+		TTN_Scene(int physicsWorkers = 0);
 
-		TTN_Scene(glm::vec3 AmbientLightingColor, float AmbientLightingStrength);
+		TTN_Scene(glm::vec3 AmbientLightingColor, float AmbientLightingStrength, int physicsWorkers = 0);
 
 		//copy, move, and assingment operators
 		TTN_Scene(const TTN_Scene& oldScene) = default;
 		TTN_Scene(TTN_Scene&&) = default;
 		TTN_Scene& operator=(TTN_Scene&) = default;
 
-		//destrutor 
-		~TTN_Scene();
+		//destrutor, virtual as games make their scenes by inheriting from this one
+		virtual ~TTN_Scene();
 
 #pragma region ECS_functions_dec
 		//creates a new entity 
@@ -67,6 +101,11 @@ namespace Titan {
 		//gets the registry
 		entt::registry* GetScene() { return m_Registry; }
 
+		//makes an entity the child of another, pass entt::null as the parent to unparent it
+		void SetParent(entt::entity child, entt::entity parent);
+		//gets an entity's parent (entt::null if it doesn't have one)
+		entt::entity GetParent(entt::entity entity);
+
 		//deletes and clears the scene
 		void Unload();
 
@@ -121,8 +160,84 @@ namespace Titan {
 		//gets the gravity
 		glm::vec3 GetGravity();
 
-		//gets all the collisions for the frame
-		std::vector<TTN_Collision::scolptr> GetCollisions() { return collisions; }
+		//sets the fixed time step (in seconds) physics is simulated with, frame times are split into steps of this length
+		void SetPhysicsTimeStep(float timeStep) { m_physicsTimeStep = timeStep; }
+		//gets the fixed time step physics is simulated with
+		float GetPhysicsTimeStep() { return m_physicsTimeStep; }
+		//sets the most physics steps that can be taken in one frame, any time past that is dropped so a long frame can't cause more
+		//and more steps in the frames after it
+		void SetMaxPhysicsSubSteps(int maxSubSteps) { m_maxPhysicsSubSteps = maxSubSteps; }
+		//gets the most physics steps that can be taken in one frame
+		int GetMaxPhysicsSubSteps() { return m_maxPhysicsSubSteps; }
+		//sets wheter or not the transforms of physics bodies are interpolated between the last two physics steps (on by default)
+		//if it's off bullet predicts them forward from the last step instead
+		void SetPhysicsInterpolation(bool interpolate);
+		//gets wheter or not the transforms of physics bodies are interpolated between the last two physics steps
+		bool GetPhysicsInterpolation();
+		//gets the number of threads bullet is using for this scene's physics, 0 if it's using the single threaded world
+		int GetPhysicsWorkers() { return m_physicsWorkers; }
+		//gets wheter or not bullet was built with threading, if it wasn't the multithreaded world still works but only ever uses one thread
+		static bool GetPhysicsMultithreadingSupported();
+		//gets the number of physics steps taken in the last update
+		int GetLastPhysicsSubSteps() { return m_lastPhysicsSubSteps; }
+		//gets the time (in milliseconds) spent stepping physics in the last update, including building the collision events
+		float GetLastPhysicsStepTime() { return m_lastPhysicsStepTime; }
+
+		//works out the world matrix of every transform that's changed (or has a parent that changed) since the last time, parents before children
+		//called at the start of Render, but can be called earlier if up to date world matrices are needed for transforms with parents
+		void UpdateWorldMatrices();
+		//gets the world matrices from the last pass, in hierarchy order (parents before children)
+		const std::vector<glm::mat4>& GetWorldMatrices() { return m_WorldMatrices; }
+
+		//sets wheter or not entities that share a mesh, shader, and material should be drawn with one instanced draw call
+		void SetInstancingEnabled(bool enabled) { m_InstancingEnabled = enabled; }
+		//gets wheter or not instanced drawing is on
+		bool GetInstancingEnabled() { return m_InstancingEnabled; }
+
+		//sets wheter or not the textured default shaders should read their materials from a storage buffer of bindless texture handles (on by default)
+		//it only does anything if the gpu supports bindless textures, otherwise the textures are bound for each draw like normal
+		//if the gpu can also sample different handles in one draw (GL_NV_gpu_shader5), entities that share a mesh and shader are drawn
+		//in one instanced draw even if their materials are different, otherwise each material still gets it's own draws
+		void SetBindlessEnabled(bool enabled) { m_BindlessEnabled = enabled; }
+		//gets wheter or not bindless materials are on
+		bool GetBindlessEnabled() { return m_BindlessEnabled; }
+		//gets wheter or not bindless materials are acutally being used (they're on and the gpu supports them)
+		bool GetBindlessActive() { return m_BindlessEnabled && TTN_Texture2D::GetBindlessSupported(); }
+		//gets wheter or not entities with different materials are being instanced together (bindless is active and the gpu allows it)
+		bool GetMixedMaterialBatchingActive() { return GetBindlessActive() && TTN_Texture2D::GetNonUniformBindlessSupported(); }
+
+		//sets wheter or not entities whose meshes are completely outside the camera's view are skipped when rendering (on by default)
+		void SetFrustumCullingEnabled(bool enabled) { m_FrustumCullingEnabled = enabled; }
+		//gets wheter or not frustum culling is on
+		bool GetFrustumCullingEnabled() { return m_FrustumCullingEnabled; }
+
+		//gets the collision events from the last update, bodies that start touching get a BEGIN event and ones that stop get an END event
+		//(every physics step taken during the update adds it's events, so a pair can begin and end in the same update)
+		const std::vector<TTN_CollisionEvent>& GetCollisionEvents() { return m_collisionEvents; }
+		//checks if two entities' physics bodies were touching in the last physics update
+		bool GetAreTouching(entt::entity entity1, entt::entity entity2);
+		//sets which collision groups make events, a pair only makes events if both bodies are in one of these groups (all of them by default)
+		void SetCollisionEventMask(uint32_t mask) { m_collisionEventMask = mask; }
+		//gets which collision groups make events
+		uint32_t GetCollisionEventMask() { return m_collisionEventMask; }
+
+		//spatial queries, these all go through bullet's broadphase tree so they only look at bodies near the query
+		//the layer mask is which collision groups can be found, bodies' own masks don't stop them being found
+		//bodies that were attached since the last update aren't in the physics world yet, so they can't be found
+
+		//casts a ray and gets the closest body it hits
+		TTN_RaycastHit Raycast(glm::vec3 from, glm::vec3 to, uint32_t layerMask = UINT32_MAX);
+		//casts a batch of rays, filling hits with the closest hit of each ray in the same order
+		void RaycastBatch(const std::vector<TTN_Ray>& rays, std::vector<TTN_RaycastHit>& hits, uint32_t layerMask = UINT32_MAX);
+		//fills results (clearing it first) with the entities whose bodies touch a sphere
+		void OverlapSphere(glm::vec3 center, float radius, std::vector<entt::entity>& results, uint32_t layerMask = UINT32_MAX);
+		//fills results (clearing it first) with the entities whose bodies touch a box
+		void OverlapBox(glm::vec3 center, glm::vec3 halfExtents, glm::quat rotation, std::vector<entt::entity>& results,
+			uint32_t layerMask = UINT32_MAX);
+		//fills results (clearing it first) with the k entities whose bodies' positions are closest to a point, closest first
+		//only bodies within maxDistance are found
+		void FindNearest(glm::vec3 point, size_t k, std::vector<entt::entity>& results, uint32_t layerMask = UINT32_MAX,
+			float maxDistance = FLT_MAX);
 
 		//variable to store the entities of the lights
 		std::vector<entt::entity> m_Lights;
@@ -149,18 +264,137 @@ namespace Titan {
 		btDefaultCollisionConfiguration* collisionConfig;
 		btCollisionDispatcher* dispatcher;
 		btBroadphaseInterface* overlappingPairCache;
-		btSequentialImpulseConstraintSolver* solver;
+		btConstraintSolver* solver;
 		//physics world
 		btDiscreteDynamicsWorld* m_physicsWorld;
-
-		//vector of titan collision objects, containing pointers to the rigid bodies (from which you can get entity numbers) and glm vec3s for collision normals
-		std::vector<TTN_Collision::scolptr> collisions;
-
-		//constructs the TTN_Collision objects
+		//the number of threads the physics world is using, 0 if it's the single threaded world
+		int m_physicsWorkers = 0;
+
+		//the task scheduler shared by every multithreaded physics world, bullet only has one at a time
+		inline static btITaskScheduler* s_physicsScheduler = nullptr;
+		//gets the task scheduler, making and setting it the first time
+		static btITaskScheduler* GetPhysicsScheduler();
+
+		//makes the physics world, multithreaded if there are any workers
+		void InitPhysics(int physicsWorkers);
+
+		//the fixed time step physics is simulated with
+		float m_physicsTimeStep = 1.0f / 60.0f;
+		//the most physics steps that can be taken in one frame
+		int m_maxPhysicsSubSteps = 4;
+		//the number of physics steps taken in the last update, and how long they took in milliseconds
+		int m_lastPhysicsSubSteps = 0;
+		float m_lastPhysicsStepTime = 0.0f;
+
+		//called by bullet after every physics step, builds the collision events for that step
+		static void PhysicsTickCallback(btDynamicsWorld* world, btScalar timeStep);
+
+		//the entities whose physics bodies bullet has moved since the last sync, filled in by their motion states
+		std::vector<entt::entity> m_movedBodies;
+
+		//the collision events from the last physics update, cleared and refilled every frame so it doesn't have to be reallocated
+		std::vector<TTN_CollisionEvent> m_collisionEvents;
+		//the pairs of bodies that are touching this frame and last frame, keyed by their ordered entity numbers with the bodies' groups as values
+		std::unordered_map<uint64_t, uint64_t> m_contactPairs;
+		std::unordered_map<uint64_t, uint64_t> m_lastContactPairs;
+		//the collision groups that make events
+		uint32_t m_collisionEventMask = UINT32_MAX;
+
+		//the shapes and object the overlap queries test with, kept so the queries don't allocate
+		btSphereShape m_querySphere = btSphereShape(1.0f);
+		btBoxShape m_queryBox = btBoxShape(btVector3(1.0f, 1.0f, 1.0f));
+		btCollisionObject m_queryObject;
+		//a node of bullet's broadphase tree waiting to be searched in the nearest query, with the distance to it's bounds
+		//(or to the body's position once the leaf has been reached)
+		struct NearestNode {
+			float Distance;
+			const btDbvtNode* Node;
+			bool Exact;
+
+			bool operator<(const NearestNode& other) const { return Distance > other.Distance; }
+		};
+		//the nodes being searched in the nearest query, kept so it doesn't allocate
+		std::vector<NearestNode> m_nearestHeap;
+
+		//casts a ray without timing it, Raycast and RaycastBatch time the whole query around it
+		TTN_RaycastHit CastRay(glm::vec3 from, glm::vec3 to, uint32_t layerMask);
+		//finds every body touching the query object
+		void Overlap(std::vector<entt::entity>& results, uint32_t layerMask);
+
+		//the uniform buffer the lights, camera, etc. are sent through once a frame
+		TTN_UniformBuffer::subptr m_SceneUniforms;
+
+		//fills and uploads the per-frame scene uniform buffer
+		void UploadSceneUniforms(const glm::mat4& view, const glm::mat4& proj);
+
+		//wheter or not runs of entities with the same mesh, shader, and material should be drawn with a single instanced draw
+		bool m_InstancingEnabled = true;
+		//the entities waiting to be drawn together
+		std::vector<entt::entity> m_RenderBatch;
+		//the per-instance data of every batch drawn this frame, written straight into gpu memory one batch after the other
+		//(each draw reads it's part with the base instance), it's only remade when there are more entities to render than it can hold
+		TTN_StreamBuffer::ssbptr m_InstanceBuffer;
+
+		//wheter or not materials should come from the material storage buffer when bindless textures are supported
+		bool m_BindlessEnabled = true;
+		//the storage buffer with the data of every material drawn with a textured default shader, indexed by m_MaterialIndices
+		TTN_ShaderStorageBuffer::sssbptr m_MaterialBuffer;
+		//the index of each material in the storage buffer this frame
+		std::unordered_map<TTN_Material*, uint32_t> m_MaterialIndices;
+		//the material data that's in the storage buffer, and the data for this frame, so it's only uploaded when something's changed
+		std::vector<TTN_MaterialData> m_MaterialData;
+		std::vector<TTN_MaterialData> m_NextMaterialData;
+
+		//gathers the materials of everything drawn with a textured default shader and uploads them to the material storage buffer if they've changed
+		void UploadMaterials();
+		//checks if a shader reads it's material from the material storage buffer when bindless materials are being used
+		static bool GetUsesMaterialBuffer(const TTN_Shader::sshptr& shader);
+
+		//wheter or not entities outside the camera's view are skipped
+		bool m_FrustumCullingEnabled = true;
+		//the camera's view frustum for the frame being rendered
+		TTN_Frustum m_Frustum;
+
+		//the entities with transforms, sorted so parents always come before their children
+		std::vector<entt::entity> m_TransformOrder;
+		//the index in m_TransformOrder of each transform's parent (-1 if it doesn't have one)
+		std::vector<int> m_TransformParentIndex;
+		//the world matrices of all the transforms, in the same order as m_TransformOrder
+		std::vector<glm::mat4> m_WorldMatrices;
+		//wheter or not each world matrix changed in the last pass, so children know to update too
+		std::vector<uint8_t> m_WorldChanged;
+		//wheter or not the hierarchy has changed in a way that needs the order to be rebuilt
+		bool m_TransformOrderDirty = true;
+
+		//rebuilds the hierarchy order of the transforms
+		void RebuildTransformOrder();
+		//checks if an entity has a parent with a transform
+		bool GetHasTransformParent(entt::entity entity);
+		//removes an entity from it's parent's list of children
+		void UnlinkFromParent(entt::entity entity);
+
+		//connects the scene's listeners to the registry's transform and relationship events
+		void ConnectRegistryListeners();
+		//called by entt when a transform is added
+		void OnTransformAdded(entt::registry& reg, entt::entity entity);
+		//called by entt when a transform is replaced
+		void OnTransformReplaced(entt::registry& reg, entt::entity entity);
+		//called by entt when a transform is removed
+		void OnTransformRemoved(entt::registry& reg, entt::entity entity);
+		//called by entt when a relationship is removed (including when it's entity is deleted)
+		void OnRelationshipRemoved(entt::registry& reg, entt::entity entity);
+
+		//checks if an entity's mesh might be visible to the camera, using the bounding sphere of the mesh moved into world space
+		bool IsInFrustum(TTN_Transform& transform, TTN_Renderer& renderer);
+		//checks if two entities can be drawn with the same instanced draw call
+		bool CanInstanceTogether(entt::entity first, entt::entity other);
+		//draws all the entities in the current batch
+		void RenderBatch(const glm::mat4& vp, const glm::mat4& viewMat);
+		//binds the entity's shader and sends the uniforms and textures from it's material
+		void SetRenderUniforms(entt::entity entity, TTN_Renderer& renderer, const glm::mat4& viewMat);
+
+		//adds the collision events for a physics step by comparing the pairs of bodies touching in bullet's manifolds to the ones from the last step
 		void ConstructCollisions();
-
-		//reconstructs the scenegraph, use every time entt reshuffles
-		void ReconstructScenegraph();
 	};
 
 #pragma region ECS_functions_def
@@ -169,8 +403,6 @@ namespace Titan {
 	{
 		//assign the component to the entity
 		m_Registry->emplace<T>(entity);
-		//reconstruct scenegraph as entt was shuffled
-		ReconstructScenegraph();
 	}
 
 	template<typename T>
@@ -178,8 +410,6 @@ namespace Titan {
 	{
 		//assign the component to the entity 
 		m_Registry->emplace_or_replace<T>(entity, copy);
-		//reconstruct scenegraph as entt was shuffled
-		ReconstructScenegraph();
 	}
 
 	template<typename T>
@@ -201,8 +431,6 @@ namespace Titan {
 	{
 		//remove the component from the entity
 		m_Registry->remove<T>(entity);
-		//reconstruct scenegraph as entt was shuffled
-		ReconstructScenegraph();
 	}
 #pragma endregion ECS_functions_def
 
@@ -11,6 +11,8 @@
 #include <string>
 //std::unordered_map class
 #include <unordered_map>
+//std::vector class
+#include <vector>
 //GLM types and basic functions
 #include <GLM/glm.hpp>
 //GLM pointers
@@ -37,6 +39,16 @@ namespace Titan {
 		VERT_MORPH_ANIMATION_COLOR = 11
 	};
 
+	//enum for the uniform block binding points titan uploads shared data to
+	enum TTN_UniformBlockBindings {
+		SCENE_DATA_BINDING = 0
+	};
+
+	//enum for the shader storage block binding points titan uploads shared data to
+	enum TTN_StorageBlockBindings {
+		MATERIAL_DATA_BINDING = 0
+	};
+
 	//class to wrap around an opengl shader
 	class TTN_Shader final {
 	public:
@@ -64,6 +76,8 @@ namespace Titan {
 
 		//Loads a single stage on the pipeline (vertix or fragment shader, etc.)
 		//and returns true if successful, false if not
+		//while the shader cache is on the stage is held back until Link, so it's only compiled if the program isn't in the cache
+		//(and any compile errors are reported by Link instead)
 		bool LoadShaderStage(const char* sourceCode, GLenum shaderType);
 
 		//Loads a single stage on the pipeline (vertex or fragment shader, etc.) from an external file
@@ -73,7 +87,12 @@ namespace Titan {
 		//loads a default shader
 		bool LoadDefaultShader(TTN_DefaultShaders shader);
 
-		//Links the stages together creating the pipeline and making the shader program useable
+		//sets the vertex shader outputs that get captured by transform feedback, has to be called before Link
+		//programs that use transform feedback can be linked without a fragment shader
+		void SetTransformFeedbackVaryings(const std::vector<const char*>& varyings, GLenum bufferMode = GL_INTERLEAVED_ATTRIBS);
+
+		//Links the stages together creating the pipeline and making the shader program useable, or loads the linked program from
+		//the shader cache if it's been linked before
 		//returns true if sucessful, false if not
 		bool Link();
 
@@ -85,6 +104,8 @@ namespace Titan {
 
 		//Gets the OpenGL handle that it's wrapping around
 		GLuint GetHandle() const { return _handle; }
+		//Gets roughly how many bytes the linked program takes up, going by the size of it's program binary (0 if it isn't linked)
+		size_t GetMemorySize() const;
 
 		//Gets the default status of the vertex shader
 		int GetVertexShaderDefaultStatus() { return vertexShaderTTNIndentity; }
@@ -154,6 +175,14 @@ namespace Titan {
 			}
 		}
 
+		//sets a bindless texture handle uniform (a sampler declared with GL_ARB_bindless_texture), so the texture doesn't need to be bound
+		//to a texture slot, the handle has to be resident (see TTN_Texture2D::GetBindlessHandle)
+		void SetUniformHandle(const std::string& name, GLuint64 handle) {
+			int location = __GetUniformLocation(name);
+			if (location != -1)
+				glProgramUniformHandleui64ARB(_handle, location, handle);
+		}
+
 	protected:
 		//vertex shader
 		GLuint _vs;
@@ -163,6 +192,22 @@ namespace Titan {
 		//marker if they're using a default shader (and which one), 0 is a custom shader, the rest are default shaders
 		int vertexShaderTTNIndentity, fragShaderTTNIdentity;
 		bool setDefault;
+		//wheter or not the program captures it's vertex shader outputs with transform feedback
+		bool _hasTransformFeedback;
+		//the outputs captured by transform feedback and how they're laid out, part of the program's key in the shader cache
+		std::vector<std::string> _feedbackVaryings;
+		GLenum _feedbackBufferMode;
+
+		//the sources of the stages held back for the shader cache
+		std::string _vsSource;
+		std::string _fsSource;
+		//the files the stages were loaded from, for the logs
+		std::string _name;
+
+		//compiles a stage and sets it as the vertex or fragment shader, returns true if it compiled
+		bool CompileShaderStage(const char* sourceCode, GLenum shaderType);
+		//points the program's uniform and storage blocks at the bindings titan uploads it's shared data to
+		void BindSharedBlocks();
 
 		//handle for the shader program
 		GLuint _handle;
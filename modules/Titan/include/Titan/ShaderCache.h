@@ -0,0 +1,79 @@
+//Titan Engine, by Atlas X Games
+// ShaderCache.h - header for the class that saves linked shader programs to disk as program binaries so they don't have to be compiled again
+#pragma once
+
+//import required features
+#include <glad/glad.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Titan {
+	//stats for the shader cache
+	struct TTN_ShaderCacheStats {
+		//the number of programs loaded from the cache, and how long they took to load altogether (in ms)
+		uint64_t Hits = 0;
+		double HitTime = 0.0;
+		//the number of programs that had to be compiled, and how long they took to compile and link altogether (in ms)
+		uint64_t Misses = 0;
+		double CompileTime = 0.0;
+		//the number of cached programs the driver wouldn't take (usually because the driver was updated), these are counted as misses too
+		uint64_t Rejected = 0;
+	};
+
+	//class that saves the binaries of linked shader programs into a folder and loads them back the next time a program with the same sources
+	//is linked, so warm starts skip compiling glsl entirely, binaries are keyed by a hash of the sources and the driver's vendor, renderer,
+	//and version, so changing a shader or updating the driver just compiles it again, and if the driver rejects a binary it's compiled as normal
+	//uses opengl, so only call it from the main thread
+	class TTN_ShaderCache {
+	public:
+		//turns the cache on or off, it's on by default, shaders hold their stages back until they're linked while it's on
+		static void SetEnabled(bool enabled) { s_enabled = enabled; }
+		//returns wheter or not the cache is on
+		static bool GetEnabled() { return s_enabled; }
+
+		//sets the folder the program binaries are written to and read from (relative to the working directory)
+		static void SetDirectory(const std::string& directory) { s_directory = directory; }
+		//gets the folder the program binaries are written to and read from
+		static const std::string& GetDirectory() { return s_directory; }
+
+		//returns wheter or not the driver can save program binaries at all (some report no binary formats)
+		static bool GetSupported();
+		//returns wheter or not the cache is on and supported, so programs should go through it
+		static bool GetActive() { return s_enabled && GetSupported(); }
+
+		//gets the key for a program linked from the given sources (the fragment source can be empty for transform feedback programs)
+		static uint64_t GetKey(const std::string& vertexSource, const std::string& fragmentSource,
+			const std::vector<std::string>& feedbackVaryings, GLenum feedbackBufferMode);
+		//loads the cached binary for a key into a program, returns wheter or not there was one and the driver linked it
+		static bool Load(GLuint program, uint64_t key);
+		//saves the binary of a linked program under a key, the program needs to have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set
+		//returns wheter or not it was written
+		static bool Save(GLuint program, uint64_t key);
+
+		//gets the path of the file the binary for a key is saved to
+		static std::string GetCachePath(uint64_t key);
+
+		//gets the stats for the programs that have gone through the cache
+		static const TTN_ShaderCacheStats& GetStats() { return s_stats; }
+		//resets the stats
+		static void ResetStats() { s_stats = TTN_ShaderCacheStats(); }
+		//adds a program to the stats, called by TTN_Shader when it's linked
+		static void RecordLink(bool fromCache, double milliseconds);
+
+	protected:
+		TTN_ShaderCache() = default;
+		~TTN_ShaderCache() = default;
+
+	private:
+		//gets the vendor, renderer, and version of the driver, binaries only work on the driver that made them
+		static const std::string& GetDriverString();
+
+		//wheter or not the cache is on
+		inline static bool s_enabled = true;
+		//the folder the binaries are in
+		inline static std::string s_directory = "cache/shaders";
+		//the stats
+		inline static TTN_ShaderCacheStats s_stats;
+	};
+}
@@ -0,0 +1,42 @@
+//Titan Engine, by Atlas X Games
+// ShaderStorageBuffer.h - header for the class that stores a buffer of data shader programs can read as a shader storage block
+#pragma once
+
+//import the buffer base class
+#include "IBuffer.h"
+//import the other features we need
+#include <memory>
+
+namespace Titan {
+
+	//class for the buffer that will back shader storage blocks in shaders, unlike uniform buffers they can be as big as the gpu's memory
+	//and the last array in them can be any length
+	class TTN_ShaderStorageBuffer : public TTN_IBuffer {
+	public:
+		//defines a special easier to use name for shared(smart) pointers to the class
+		typedef std::shared_ptr<TTN_ShaderStorageBuffer> sssbptr;
+
+		//creates and returns a shared(smart) pointer to the class
+		static inline sssbptr Create(GLenum usage = GL_DYNAMIC_DRAW) {
+			return std::make_shared<TTN_ShaderStorageBuffer>(usage);
+		}
+
+	public:
+		//constructor, creates a new shader storage buffer with the given usage, data will be still need be loaded before it can be used though
+		TTN_ShaderStorageBuffer(GLenum usage = GL_DYNAMIC_DRAW) : TTN_IBuffer(GL_SHADER_STORAGE_BUFFER, usage)
+			{ }
+
+		//binds the buffer to the general shader storage buffer target
+		using TTN_IBuffer::Bind;
+
+		//binds the buffer to a shader storage binding point so any shader with a storage block on that binding reads from it
+		void Bind(GLuint bindingPoint) {
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, bindingPoint, _handle);
+		}
+
+		//unbinds whatever shader storage buffer is on a binding point
+		static void UnBind(GLuint bindingPoint) {
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, bindingPoint, 0);
+		}
+	};
+}
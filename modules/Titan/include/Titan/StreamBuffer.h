@@ -0,0 +1,74 @@
+//Titan Engine, by Atlas X Games
+// StreamBuffer.h - header for the class that stores a vertex buffer that gets rewritten every frame (like per-instance data)
+#pragma once
+
+//import the vertex buffer class
+#include "VertexBuffer.h"
+//import the other features we need
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+namespace Titan {
+
+	//class for a vertex buffer whose data is rewritten every frame, the cpu writes straight into mapped gpu memory instead of going through LoadData
+	//when the driver supports it (gl 4.4+) the buffer is persistently mapped and split into regions (3 by default) that are cycled through,
+	//with fences so the cpu never writes into a region the gpu is still drawing from, otherwise it falls back to orphaning the buffer every frame
+	//since the regions are in the same buffer, draws have to use GetBaseElement() as their base instance so the attributes read from the right one
+	//a frame can be written in several parts (like one per instanced draw), each part goes after the last one in the same region
+	class TTN_StreamBuffer : public TTN_VertexBuffer {
+	public:
+		//defines a special easier to use name for shared(smart) pointers to the class
+		typedef std::shared_ptr<TTN_StreamBuffer> ssbptr;
+
+		//creates and returns a shared(smart) pointer to the class
+		static inline ssbptr Create(size_t elementSize, size_t capacity, unsigned numOfRegions = 3) {
+			return std::make_shared<TTN_StreamBuffer>(elementSize, capacity, numOfRegions);
+		}
+
+	public:
+		//constructor, makes a buffer that can hold capacity elements of elementSize bytes each frame
+		TTN_StreamBuffer(size_t elementSize, size_t capacity, unsigned numOfRegions = 3);
+
+		//destructor, unmaps the buffer and deletes the fences
+		virtual ~TTN_StreamBuffer();
+
+		//gets a pointer to write the next part of this frame's data to, with room for count elements (waits if the gpu is still using that memory)
+		void* BeginWrite(size_t count);
+		//finishes writing the current part of this frame's data
+		void EndWrite();
+		//should be called after the draws that use this frame's data, fences the region and moves on to the next one
+		void EndFrame();
+
+		//gets the index of the first element of the last part written, to be used as the base instance of the draw
+		GLuint GetBaseElement() const { return (GLuint)(m_region * m_capacity + m_partStart); }
+		//gets how many elements can be written each frame
+		size_t GetCapacity() const { return m_capacity; }
+		//gets how many more elements can be written this frame
+		size_t GetRemaining() const { return m_capacity - m_written; }
+		//gets wheter or not the buffer is persistently mapped (if not it's orphaned every frame)
+		bool GetIsPersistent() const { return m_persistent; }
+
+		//checks if the current opengl context supports persistently mapped buffers
+		static bool GetPersistentMappingSupported();
+
+	private:
+		//the number of elements that can be written each frame
+		size_t m_capacity;
+		//the number of regions the buffer is split into (1 when orphaning)
+		unsigned m_numOfRegions;
+		//the region being written to this frame
+		unsigned m_region;
+		//the number of elements written to the region so far this frame, and where the last part started
+		size_t m_written;
+		size_t m_partStart;
+		//wheter or not the buffer is persistently mapped
+		bool m_persistent;
+		//the start of the persistently mapped memory
+		uint8_t* m_mapped;
+		//the fences for each region, set when the gpu has been given draws that read from that region
+		std::vector<GLsync> m_fences;
+		//wheter or not the buffer is currently mapped for writing (only used when orphaning)
+		bool m_writing;
+	};
+}
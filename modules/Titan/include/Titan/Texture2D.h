@@ -7,6 +7,7 @@
 #include <memory>
 #include <GLM/glm.hpp>
 #include <string>
+#include <vector>
 
 #include "ITexture.h"
 #include "TextureEnums.h"
@@ -27,10 +28,12 @@ namespace Titan {
 
 		/// Creates a new 2D texture data object
 		TTN_Texture2DData(uint32_t width, uint32_t height, Texture_Pixel_Format format, Texture_Pixel_Data_Type type, void* sourceData, Texture_Internal_Format recommendedFormat = Texture_Internal_Format::Interal_Format_Unknown);
+		/// Creates a new block compressed 2D texture data object with the given number of mip levels, stored one after the other from the biggest
+		TTN_Texture2DData(uint32_t width, uint32_t height, Texture_Internal_Format compressedFormat, uint32_t numOfLevels, const void* sourceData);
 		~TTN_Texture2DData();
 
 
-		/// Loads image data from an external file
+		/// Loads image data from an external file, .dds files are loaded as they are (block compressed, with their mip levels)
 		static TTN_Texture2DData::st2ddptr LoadFromFile(const std::string& file, bool flipped = true, bool forceRgba = false);
 
 		
@@ -57,9 +60,24 @@ namespace Titan {
 		/// Gets a readonly copy of the underlying data in this image for upload
 		const void* GetDataPtr() const { return _data; }
 
+		/// Gets wheter or not the data is block compressed (the recommended format is the compressed format)
+		bool GetIsCompressed() const { return GetIsCompressedFormat(_recommendedFormat); }
+
+		/// Gets the number of mip levels in the data, always 1 for data that isn't compressed
+		uint32_t GetNumOfLevels() const { return (uint32_t)_levelOffsets.size(); }
+
+		/// Gets a readonly pointer to the data for a mip level
+		const void* GetLevelDataPtr(uint32_t level) const { return static_cast<const char*>(_data) + _levelOffsets[level]; }
+
+		/// Gets the size of the data for a mip level, in bytes
+		size_t GetLevelDataSize(uint32_t level) const {
+			return ((level + 1 < _levelOffsets.size()) ? _levelOffsets[level + 1] : _dataSize) - _levelOffsets[level];
+		}
+
 	private:
 		uint32_t    _width, _height;
 		size_t      _dataSize;
+		std::vector<size_t> _levelOffsets;
 		Texture_Pixel_Format _format;
 		Texture_Pixel_Data_Type   _type;
 		Texture_Internal_Format _recommendedFormat;
@@ -113,8 +131,8 @@ namespace Titan {
 		TTN_Texture2D();
 		//constructor that takes in a descpiriton for the texture
 		TTN_Texture2D(const TTN_Texture2DDesc& description);
-		//default destrcutor
-		~TTN_Texture2D() = default;
+		//destrcutor, lets go of the bindless handle if it has one
+		~TTN_Texture2D();
 
 		//loads a texture from a file
 		static st2dptr LoadFromFile(const std::string& fileName, bool flipped = true, bool forceRgba = false);
@@ -138,6 +156,20 @@ namespace Titan {
 		Texture_Wrap_Mode GetVertWrapMode() const { return m_data.vertWrapMode; }
 		//underlying data
 		const TTN_Texture2DDesc& GetDescription() const { return m_data; }
+		//number of mip levels the texture has storage for
+		uint32_t GetNumOfLevels() const { return m_levels; }
+		//roughly how many bytes the texture takes up on the gpu, including it's mip levels
+		size_t GetMemorySize() const;
+
+		//gets a bindless handle for the texture, making it resident the first time it's asked for so shaders can sample it without it being bound
+		//returns 0 if bindless textures aren't supported or the texture has no storage yet (like the default white textures on materials)
+		//once a texture has a handle it's filters and wrap modes can't be changed anymore, so set them up before asking for it
+		GLuint64 GetBindlessHandle();
+		//returns wheter or not the gpu supports bindless textures (GL_ARB_bindless_texture)
+		static bool GetBindlessSupported() { return GLAD_GL_ARB_bindless_texture != 0; }
+		//returns wheter or not shaders can sample a different bindless handle for each instance in the same draw (GL_NV_gpu_shader5)
+		//without it the handles a draw samples have to be the same for the whole draw (dynamically uniform)
+		static bool GetNonUniformBindlessSupported();
 
 
 		//setters for the filters and wrap mode
@@ -154,7 +186,15 @@ namespace Titan {
 
 	private:
 		TTN_Texture2DDesc m_data;
+		//the number of mip levels the texture has storage for, a full chain if it generates mipmaps
+		uint32_t m_levels;
+		//the bindless handle for the texture, 0 until it's asked for
+		GLuint64 m_bindlessHandle = 0;
+		//wheter or not the driver has GL_NV_gpu_shader5, -1 until the extensions have been checked
+		inline static int s_nvGpuShader5 = -1;
 
 		void RecreateTexture();
+		//makes the bindless handle non-resident and forgets it, so the texture can be deleted
+		void ReleaseBindlessHandle();
 	};
 }
\ No newline at end of file
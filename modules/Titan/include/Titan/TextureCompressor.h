@@ -0,0 +1,64 @@
+//Titan Engine, by Atlas X Games
+// TextureCompressor.h - header for the class that block compresses textures and reads and writes them as dds files
+#pragma once
+
+//include the texture data class so it can be compressed
+#include "Texture2D.h"
+//import other required features
+#include <string>
+
+namespace Titan {
+	//class that encodes texture data into BC1 (rgb), BC3 (rgba), or BC5 (rg) with a full mip chain, and bakes the results into dds files
+	//so textures loaded from images only get encoded once, a baked texture is rebaked if the size or timestamp of it's source image changes
+	//compressed textures take 4-8 times less memory on the gpu (and bandwidth when they're sampled) than the images they came from
+	class TTN_TextureCompressor {
+	public:
+		//turns compression on or off for 2D textures loaded from images, it's off by default as it's lossy
+		//cubemaps and images loaded with forceRgba (which are usually read back on the cpu) are never compressed
+		static void SetEnabled(bool enabled) { s_enabled = enabled; }
+		//returns wheter or not compression is on
+		static bool GetEnabled() { return s_enabled; }
+
+		//sets the folder the baked textures are written to and read from (relative to the working directory)
+		static void SetDirectory(const std::string& directory) { s_directory = directory; }
+		//gets the folder the baked textures are written to and read from
+		static const std::string& GetDirectory() { return s_directory; }
+
+		//loads the data for a 2D texture from an image, if compression is on it's the baked compressed copy (which is made if there
+		//isn't an up to date one yet), otherwise, or if the image can't be compressed, it's just the image
+		//doesn't touch opengl, so it can be run on any thread
+		static TTN_Texture2DData::st2ddptr LoadFromFile(const std::string& fileName, bool flipped = true, bool forceRgba = false);
+
+		//picks the format an image would be compressed to, BC3 if it has any alpha, BC1 if it's rgb (or has alpha that's all opaque),
+		//BC5 if it's rg, and Interal_Format_Unknown if it can't be compressed (single channel, or not 8 bits a channel)
+		static Texture_Internal_Format ChooseFormat(const TTN_Texture2DData& image);
+		//compresses an uncompressed image into the given format (or the one ChooseFormat picks), building a full mip chain with a box filter
+		//returns nullptr if the image can't be compressed into that format
+		static TTN_Texture2DData::st2ddptr Compress(const TTN_Texture2DData& image,
+			Texture_Internal_Format format = Texture_Internal_Format::Interal_Format_Unknown);
+
+		//returns wheter or not a file is a dds file, going by it's extension (in any case)
+		static bool GetIsDDSFile(const std::string& fileName);
+		//loads a BC1, BC3, or BC5 dds file (with either the old fourcc header or the dx10 one), returns nullptr if it can't be read
+		//srgb BC1 and BC3 files (which need the dx10 header) keep their srgb format
+		//dds files are stored top row first, so flipped turns them bottom row first like images loaded with flipped
+		static TTN_Texture2DData::st2ddptr LoadDDS(const std::string& fileName, bool flipped = true);
+		//writes compressed data out to a dds file, flipped is wheter or not the data's rows are bottom row first
+		//srgb formats are written with the dx10 header, as the old header has no way to mark them
+		//returns wheter or not it was written
+		static bool SaveDDS(const std::string& fileName, const TTN_Texture2DData& data, bool flipped = true);
+
+		//gets the path of the file the compressed copy of an image is baked to
+		static std::string GetCachePath(const std::string& fileName, bool flipped);
+
+	protected:
+		TTN_TextureCompressor() = default;
+		~TTN_TextureCompressor() = default;
+
+	private:
+		//wheter or not images are compressed
+		inline static bool s_enabled = false;
+		//the folder the baked textures are in
+		inline static std::string s_directory = "cache/textures";
+	};
+}
@@ -128,6 +128,8 @@ namespace Titan {
 		Texture_Min_Filter GetMinFilter() { return m_data.MinificationFilter; }
 		Texture_Mag_Filter GetMagFilter() { return m_data.MagnificationFilter; }
 		const TTN_TextureCubeMapDesc& GetDescription() const { return m_data; }
+		//roughly how many bytes the texture takes up on the gpu, all 6 faces and their mip levels
+		size_t GetMemorySize() const;
 
 		//Setters
 		void SetMinFilter(Texture_Min_Filter filter);
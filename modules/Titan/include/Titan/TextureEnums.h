@@ -5,6 +5,20 @@
 #include "Logging.h"
 #include "glad/glad.h"
 
+//the s3tc formats come from an extension every desktop driver has, but glad wasn't generated with it
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
 namespace Titan {
 	//enums for texture details
 	//enum for some common unsized internal formats
@@ -19,7 +33,14 @@ namespace Titan {
 		RGB10 = GL_RGB10,
 		RGB16 = GL_RGB16,
 		RGBA8 = GL_RGBA8,
-		RGBA16 = GL_RGBA16
+		RGBA16 = GL_RGBA16,
+		//block compressed formats, every 4x4 block of pixels is stored in a fixed number of bytes
+		BC1 = GL_COMPRESSED_RGB_S3TC_DXT1_EXT, //rgb, 8 bytes a block
+		BC3 = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, //rgba, 16 bytes a block
+		BC5 = GL_COMPRESSED_RG_RGTC2, //rg, 16 bytes a block
+		//the same blocks as BC1 and BC3, but the colours are decoded from srgb when they're sampled
+		BC1_SRGB = GL_COMPRESSED_SRGB_S3TC_DXT1_EXT,
+		BC3_SRGB = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
 	};
 	//enum for some common pixel format data
 	enum Texture_Pixel_Format {
@@ -112,4 +133,68 @@ namespace Titan {
 	constexpr size_t GetTexelSize(Texture_Pixel_Format format, Texture_Pixel_Data_Type type) {
 		return GetTexelComponentSize(type) * GetTexelComponentCount(format);
 	}
+
+	//Gets wheter or not an internal format is block compressed
+	constexpr bool GetIsCompressedFormat(Texture_Internal_Format format) {
+		return format == Texture_Internal_Format::BC1 || format == Texture_Internal_Format::BC3 || format == Texture_Internal_Format::BC5
+			|| format == Texture_Internal_Format::BC1_SRGB || format == Texture_Internal_Format::BC3_SRGB;
+	}
+
+	//Gets the linear version of an srgb compressed format, the blocks are laid out the same so anything reading or writing them can use it
+	constexpr Texture_Internal_Format GetLinearCompressedFormat(Texture_Internal_Format format) {
+		return (format == Texture_Internal_Format::BC1_SRGB) ? Texture_Internal_Format::BC1 :
+			(format == Texture_Internal_Format::BC3_SRGB) ? Texture_Internal_Format::BC3 : format;
+	}
+
+	//Gets the number of bytes each 4x4 block takes up in a compressed format (0 if it's not compressed)
+	constexpr size_t GetCompressedBlockSize(Texture_Internal_Format format) {
+		switch (GetLinearCompressedFormat(format)) {
+		case Texture_Internal_Format::BC1:
+			return 8;
+		case Texture_Internal_Format::BC3:
+		case Texture_Internal_Format::BC5:
+			return 16;
+		default:
+			return 0;
+		}
+	}
+
+	//Gets the number of bytes one mip level of a compressed format takes up, partial blocks on the edges still take a whole block
+	constexpr size_t GetCompressedLevelSize(Texture_Internal_Format format, uint32_t width, uint32_t height) {
+		return (size_t)((width + 3) / 4) * ((height + 3) / 4) * GetCompressedBlockSize(format);
+	}
+
+	//Gets roughly the number of bytes one mip level of a texture with the given internal format takes up on the gpu
+	//3 channel formats are counted as 4, as that's how drivers store them
+	constexpr size_t GetInternalFormatLevelSize(Texture_Internal_Format format, uint32_t width, uint32_t height) {
+		if (GetIsCompressedFormat(format))
+			return GetCompressedLevelSize(format, width, height);
+
+		size_t texelSize = 0;
+		switch (format) {
+		case Texture_Internal_Format::R8:
+			texelSize = 1;
+			break;
+		case Texture_Internal_Format::R16:
+		case Texture_Internal_Format::RG8:
+			texelSize = 2;
+			break;
+		case Texture_Internal_Format::RGB16:
+		case Texture_Internal_Format::RGBA16:
+			texelSize = 8;
+			break;
+		default:
+			texelSize = 4;
+			break;
+		}
+		return (size_t)width * height * texelSize;
+	}
+
+	//Gets the number of levels in a full mip chain for a texture of the given size, down to 1x1
+	constexpr uint32_t GetNumOfMipLevels(uint32_t width, uint32_t height) {
+		uint32_t levels = 1;
+		for (uint32_t size = (width > height) ? width : height; size > 1; size >>= 1)
+			levels++;
+		return levels;
+	}
 }
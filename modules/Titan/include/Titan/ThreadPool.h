@@ -0,0 +1,67 @@
+//Titan Engine, by Atlas X Games
+// ThreadPool.h - header for the class that keeps a set of worker threads around to run jobs on
+#pragma once
+
+//import required features
+#include <memory>
+#include <functional>
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace Titan {
+	//class for a pool of worker threads, the threads are made once and then wait for jobs so nothing has to spin up a thread mid-frame
+	class TTN_ThreadPool {
+	public:
+		//defines a special easier to use name for shared(smart) pointers to the class
+		typedef std::shared_ptr<TTN_ThreadPool> stpptr;
+
+		//creates and returns a shared(smart) pointer to the class
+		static inline stpptr Create(unsigned numOfThreads = 0) {
+			return std::make_shared<TTN_ThreadPool>(numOfThreads);
+		}
+
+		//gets the pool shared by the whole engine, it's made the first time it's needed
+		static TTN_ThreadPool& GetShared();
+
+	public:
+		//ensuring moving and copying is not allowed, the workers hold a pointer to the pool
+		TTN_ThreadPool(const TTN_ThreadPool& other) = delete;
+		TTN_ThreadPool(TTN_ThreadPool&& other) = delete;
+		TTN_ThreadPool& operator=(const TTN_ThreadPool& other) = delete;
+		TTN_ThreadPool& operator=(TTN_ThreadPool&& other) = delete;
+
+		//constructor, starts the worker threads (0 means one less than the number of cores, leaving one for the main thread)
+		TTN_ThreadPool(unsigned numOfThreads = 0);
+
+		//destructor, finishes the queued jobs and stops the workers
+		~TTN_ThreadPool();
+
+		//adds a job to the queue, it will be run on whichever worker is free first
+		void Push(std::function<void()> job);
+
+		//splits the range [0, count) into chunks of at least minChunkSize and runs function(begin, end) on each one
+		//the calling thread runs chunks too (only this call's, never other jobs in the queue), and it only returns once every chunk is done
+		void ParallelFor(size_t count, size_t minChunkSize, const std::function<void(size_t, size_t)>& function);
+
+		//gets how many worker threads the pool has
+		unsigned GetNumOfThreads() { return (unsigned)m_workers.size(); }
+
+	private:
+		//the loop each worker runs, waiting for and then running jobs
+		void WorkerLoop();
+
+		//the worker threads
+		std::vector<std::thread> m_workers;
+		//the jobs waiting to be run
+		std::queue<std::function<void()>> m_jobs;
+		//lock for the job queue
+		std::mutex m_mutex;
+		//used to wake the workers up when there's a new job (or it's time to stop)
+		std::condition_variable m_jobAdded;
+		//wheter or not the workers should stop
+		bool m_stopping = false;
+	};
+}
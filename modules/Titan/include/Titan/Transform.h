@@ -11,15 +11,17 @@
 #include <vector>
 
 namespace Titan {
+	class TTN_Scene;
 
 	//transform class, defines the transform component 
+	//changes only mark the transform as dirty, the world matrices are rebuilt once a frame by the scene (parents before children)
 	class TTN_Transform {
 	public:
 		//constructor 
 		TTN_Transform();
 
 		//constructor that takes all the data and makes a transform out of it
-		TTN_Transform(glm::vec3 pos, glm::vec3 rotation, glm::vec3 scale, TTN_Transform* parent = nullptr, entt::entity* parentEntity = nullptr);
+		TTN_Transform(glm::vec3 pos, glm::vec3 rotation, glm::vec3 scale);
 
 		//destructor 
 		~TTN_Transform();
@@ -31,8 +33,6 @@ namespace Titan {
 		void SetScale(glm::vec3 scale);
 		//rotation
 		void SetRotationQuat(glm::quat rotationQuat);
-		//parent
-		void SetParent(TTN_Transform* parent, entt::entity* parentEntity);
 
 
 		//GETTERS
@@ -46,11 +46,12 @@ namespace Titan {
 		glm::quat GetRotQuat() { return m_rotation; }
 		//transform matrix 
 		glm::mat4 GetMatrix();
-		//global transform matrix
+		//global transform matrix, for transforms with a parent this is from the scene's last world matrix pass (see TTN_Scene::UpdateWorldMatrices)
 		glm::mat4 GetGlobal();
-		//parent 
-		TTN_Transform* GetParent();
-		entt::entity* GetParentEntity() { return m_parentEntity; }
+		//wheter or not the transform has a parent (parents are set through TTN_Scene::SetParent)
+		bool GetHasParent() { return m_hasParent; }
+		//wheter or not the transform has changed since the scene last rebuilt the world matrices
+		bool GetHasChanged() { return m_changed; }
 
 		//rotates by inputed value
 		void RotateRelative(glm::vec3 rotation);
@@ -62,18 +63,18 @@ namespace Titan {
 		void LookAlong(glm::vec3 direction, glm::vec3 up);
 
 	protected:
-		//function that will recalculate the transformation matrix, call from the setters (so whenever a change is made to the object) 
+		//marks the transform as changed, called from the setters (so whenever a change is made to the object) 
 		void Recompute();
+		//rebuilds the local transformation matrix if it's out of date
+		void RecomputeLocal();
 
-		//functions to add or remove children (handled by setParent)
-		void AddChild(TTN_Transform* child);
-		void RemoveChild(TTN_Transform* child);
+		//the scene does the parenting and the per-frame world matrix pass
+		friend class TTN_Scene;
 
 	private:
 		/// Hierararchy ///
-		TTN_Transform* m_Parent;
-		entt::entity* m_parentEntity; //needed to reconstruct the parenting relationship when entt's interal stuff changes 
-		std::vector<TTN_Transform*> m_Children;
+		//wheter or not the entity has a parent with a transform, the actual links are in it's TTN_Relationship component
+		bool m_hasParent;
 
 		/// LOCAL /// 
 		//stores the position
@@ -88,5 +89,11 @@ namespace Titan {
 
 		/// GLOBAL ///
 		glm::mat4 m_global; //stores a 4x4 matrix that represents the transform of the object relative to global space, used for rendering
+
+		/// DIRTY FLAGS ///
+		//wheter or not the local matrix needs to be rebuilt
+		bool m_localDirty;
+		//wheter or not the transform has changed since the scene's last world matrix pass
+		bool m_changed;
 	};
 }
\ No newline at end of file
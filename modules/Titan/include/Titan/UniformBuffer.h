@@ -0,0 +1,41 @@
+//Titan Engine, by Atlas X Games
+// UniformBuffer.h - header for the class that stores a buffer of data that can be shared between shader programs as a uniform block
+#pragma once
+
+//import the buffer base class
+#include "IBuffer.h"
+//import the other features we need
+#include <memory>
+
+namespace Titan {
+
+	//class for the buffer that will back uniform blocks in shaders
+	class TTN_UniformBuffer : public TTN_IBuffer {
+	public:
+		//defines a special easier to use name for shared(smart) pointers to the class
+		typedef std::shared_ptr<TTN_UniformBuffer> subptr;
+
+		//creates and returns a shared(smart) pointer to the class
+		static inline subptr Create(GLenum usage = GL_DYNAMIC_DRAW) {
+			return std::make_shared<TTN_UniformBuffer>(usage);
+		}
+
+	public:
+		//constructor, creates a new uniform buffer with the given usage, data will be still need be loaded before it can be used though
+		TTN_UniformBuffer(GLenum usage = GL_DYNAMIC_DRAW) : TTN_IBuffer(GL_UNIFORM_BUFFER, usage)
+			{ }
+
+		//binds the buffer to the general uniform buffer target
+		using TTN_IBuffer::Bind;
+
+		//binds the buffer to a uniform block binding point so any shader with a block on that binding reads from it
+		void Bind(GLuint bindingPoint) {
+			glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, _handle);
+		}
+
+		//unbinds whatever uniform buffer is on a binding point
+		static void UnBind(GLuint bindingPoint) {
+			glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, 0);
+		}
+	};
+}
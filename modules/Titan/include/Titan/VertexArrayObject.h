@@ -101,7 +101,8 @@ namespace Titan {
 
 		//Renders the VAO
 		void Render() const;
-		void RenderInstanced(size_t numOfObjects, size_t numOfVerts = 0) const;
+		//Renders the VAO numOfObjects times, the instanced attributes start reading from element baseInstance
+		void RenderInstanced(size_t numOfObjects, size_t numOfVerts = 0, size_t baseInstance = 0) const;
 
 	private:
 		//structure to store a VBO and it's attributes
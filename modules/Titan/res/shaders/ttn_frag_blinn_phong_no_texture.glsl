@@ -9,23 +9,24 @@ layout(location = 3) in vec3 inColor;
 //material stuff
 uniform float u_Shininess;
 
-//scene ambient lighting
-uniform vec3  u_AmbientCol;
-uniform float u_AmbientStrength;
-
-//Specfic light stuff
-uniform vec3  u_LightPos[16];
-uniform vec3  u_LightCol[16];
-uniform float u_AmbientLightStrength[16];
-uniform float u_SpecularLightStrength[16];
-uniform float u_LightAttenuationConstant[16];
-uniform float u_LightAttenuationLinear[16];
-uniform float u_LightAttenuationQuadratic[16];
-
-uniform int u_NumOfLights;
-
-//camera data
-uniform vec3  u_CamPos;
+//per-frame scene data, filled once a frame by TTN_Scene and shared by every shader (std140, see TTN_SceneUniformData)
+layout(std140) uniform TTN_SceneData {
+	mat4  u_View;
+	mat4  u_Projection;
+	mat4  u_ViewProjection;
+	//camera position in xyz
+	vec4  u_CamPos;
+	//scene ambient color in rgb, strength in a
+	vec4  u_Ambient;
+	//specfic light stuff, position and color in xyz/rgb
+	vec4  u_LightPos[16];
+	vec4  u_LightCol[16];
+	//ambient strength in x, specular strength in y
+	vec4  u_LightStrength[16];
+	//constant attenuation in x, linear in y, quadratic in z
+	vec4  u_LightAttenuation[16];
+	int   u_NumOfLights;
+};
 
 //result
 out vec4 frag_color;
@@ -37,15 +38,15 @@ vec3 CalcLight(vec3 pos, vec3 col, float ambStr, float specStr, float attenConst
 void main() {
 	//calcualte the vectors needed for lighting
 	vec3 N = normalize(inNormal);
-	vec3 viewDir  = normalize(u_CamPos - inPos);
+	vec3 viewDir  = normalize(u_CamPos.xyz - inPos);
 
 	//combine everything
-	vec3 result = u_AmbientCol * u_AmbientStrength; // global ambient light
+	vec3 result = u_Ambient.rgb * u_Ambient.a; // global ambient light
 
 	//add the results from all the lights
 	for(int i = 0; i < u_NumOfLights; i++) {
-		result = result + CalcLight(u_LightPos[i], u_LightCol[i], u_AmbientLightStrength[i], u_SpecularLightStrength[i], 
-					u_LightAttenuationConstant[i], u_LightAttenuationLinear[i], u_LightAttenuationQuadratic[i], 
+		result = result + CalcLight(u_LightPos[i].xyz, u_LightCol[i].rgb, u_LightStrength[i].x, u_LightStrength[i].y, 
+					u_LightAttenuation[i].x, u_LightAttenuation[i].y, u_LightAttenuation[i].z, 
 					N, viewDir, 1.0);
 	}
 
@@ -1,33 +1,59 @@
-#version 410
+#version 450
+#extension GL_ARB_bindless_texture : enable
+//lets each instance sample it's own material's handles when TTN_Scene draws different materials together (only done if the driver has it)
+#extension GL_NV_gpu_shader5 : enable
 
 //mesh data from vert shader
 layout(location = 0) in vec3 inPos;
 layout(location = 1) in vec3 inNormal;
 layout(location = 2) in vec2 inUV;
 layout(location = 3) in vec3 inColor;
+//the index of the material in the material storage buffer
+layout(location = 4) flat in uint inMaterial;
 
 //material data
 uniform sampler2D s_Diffuse;
 uniform sampler2D s_Specular;
 uniform float u_Shininess;
-
-//scene ambient lighting
-uniform vec3  u_AmbientCol;
-uniform float u_AmbientStrength;
-
-//Specfic light stuff
-uniform vec3  u_LightPos[16];
-uniform vec3  u_LightCol[16];
-uniform float u_AmbientLightStrength[16];
-uniform float u_SpecularLightStrength[16];
-uniform float u_LightAttenuationConstant[16];
-uniform float u_LightAttenuationLinear[16];
-uniform float u_LightAttenuationQuadratic[16];
-
-uniform int u_NumOfLights;
-
-//camera data
-uniform vec3  u_CamPos;
+//1 if the material should come from the material storage buffer instead of the uniforms above
+uniform int u_Bindless;
+
+#ifdef GL_ARB_bindless_texture
+//every material in the scene, filled once a frame by TTN_Scene (std430, see TTN_MaterialData), the textures are bindless handles
+//and a handle of 0 means the texture should be all white
+struct TTN_MaterialData {
+	uvec2 Albedo;
+	uvec2 Specular;
+	float Shininess;
+	float padding;
+};
+
+layout(std430) readonly buffer TTN_Materials {
+	TTN_MaterialData u_Materials[];
+};
+#endif
+
+//the shininess of the material being drawn
+float shininess;
+
+//per-frame scene data, filled once a frame by TTN_Scene and shared by every shader (std140, see TTN_SceneUniformData)
+layout(std140) uniform TTN_SceneData {
+	mat4  u_View;
+	mat4  u_Projection;
+	mat4  u_ViewProjection;
+	//camera position in xyz
+	vec4  u_CamPos;
+	//scene ambient color in rgb, strength in a
+	vec4  u_Ambient;
+	//specfic light stuff, position and color in xyz/rgb
+	vec4  u_LightPos[16];
+	vec4  u_LightCol[16];
+	//ambient strength in x, specular strength in y
+	vec4  u_LightStrength[16];
+	//constant attenuation in x, linear in y, quadratic in z
+	vec4  u_LightAttenuation[16];
+	int   u_NumOfLights;
+};
 
 //result
 out vec4 frag_color;
@@ -39,21 +65,35 @@ vec3 CalcLight(vec3 pos, vec3 col, float ambStr, float specStr, float attenConst
 void main() {
 	//calcualte the vectors needed for lighting
 	vec3 N = normalize(inNormal);
-	vec3 viewDir  = normalize(u_CamPos - inPos);
-	//sample the textures
-	float texSpec = texture(s_Specular, inUV).x;
-	vec4 textureColor = texture(s_Diffuse, inUV);
+	vec3 viewDir  = normalize(u_CamPos.xyz - inPos);
+	//sample the textures, either from the material storage buffer or the bound samplers
+	float texSpec;
+	vec4 textureColor;
+	shininess = u_Shininess;
+#ifdef GL_ARB_bindless_texture
+	if (u_Bindless == 1) {
+		TTN_MaterialData material = u_Materials[inMaterial];
+		texSpec = (material.Specular != uvec2(0)) ? texture(sampler2D(material.Specular), inUV).x : 1.0;
+		textureColor = (material.Albedo != uvec2(0)) ? texture(sampler2D(material.Albedo), inUV) : vec4(1.0);
+		shininess = material.Shininess;
+	}
+	else
+#endif
+	{
+		texSpec = texture(s_Specular, inUV).x;
+		textureColor = texture(s_Diffuse, inUV);
+	}
 
 	if(textureColor.a < 0.01)
 		discard;
 
 	//combine everything
-	vec3 result = u_AmbientCol * u_AmbientStrength; // global ambient light
+	vec3 result = u_Ambient.rgb * u_Ambient.a; // global ambient light
 
 	//add the results from all the lights
 	for(int i = 0; i < u_NumOfLights; i++) {
-		result = result + CalcLight(u_LightPos[i], u_LightCol[i], u_AmbientLightStrength[i], u_SpecularLightStrength[i], 
-					u_LightAttenuationConstant[i], u_LightAttenuationLinear[i], u_LightAttenuationQuadratic[i], 
+		result = result + CalcLight(u_LightPos[i].xyz, u_LightCol[i].rgb, u_LightStrength[i].x, u_LightStrength[i].y, 
+					u_LightAttenuation[i].x, u_LightAttenuation[i].y, u_LightAttenuation[i].z, 
 					N, viewDir, texSpec);
 	}
 
@@ -82,7 +122,7 @@ vec3 CalcLight(vec3 pos, vec3 col, float ambStr, float specStr, float attenConst
 
 	//specular
 	vec3 halfWay =  normalize(lightDir + viewDir);
-	float spec = pow(max(dot(norm, halfWay), 0.0), u_Shininess); 
+	float spec = pow(max(dot(norm, halfWay), 0.0), shininess); 
 	vec3 specular = specStr * textSpec * spec * col;
 	
 	//combine and return it all
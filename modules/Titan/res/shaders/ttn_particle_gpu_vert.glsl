@@ -0,0 +1,47 @@
+#version 410
+
+//data from c++
+//regular vbos
+layout(location = 0) in vec3 inVertPos;
+layout(location = 1) in vec3 inVertNorm;
+layout(location = 2) in vec2 inVertUV;
+//instanced vbos, the particle state written by the update shader
+layout(location = 3) in vec4 inStartColor;
+layout(location = 4) in vec4 inEndColor;
+layout(location = 5) in vec3 inInstancePosition;
+layout(location = 6) in float inTimeAlive;
+layout(location = 7) in float inLifeTime;
+layout(location = 8) in float inStartScale;
+layout(location = 9) in float inEndScale;
+
+//mesh data to pass to the frag shader
+layout(location = 0) out vec3 outPos;
+layout(location = 1) out vec3 outNormal;
+layout(location = 2) out vec2 outUV;
+layout(location = 3) out vec4 outColor;
+
+uniform mat4 u_model;
+uniform mat4 u_mvp;
+uniform mat3 u_normalMat;
+//the position of the emitter, added to every particle like the cpu particles do
+uniform vec3 u_emitterPosition;
+
+void main() {
+	//get a t value for interpolation
+	float t = clamp(inTimeAlive / max(inLifeTime, 0.0001), 0.0, 1.0);
+
+	//interpolate the scale, dead particles are scaled down to nothing so they don't make any fragments
+	float scale = (inTimeAlive < inLifeTime) ? mix(inStartScale, inEndScale, t) : 0.0;
+
+	//calculate the position
+	vec3 ParticlePos = inVertPos * scale + inInstancePosition + u_emitterPosition;
+
+	//pass data onto the frag shader
+	outPos = (u_model * vec4(ParticlePos, 1.0)).xyz;
+	outNormal = u_normalMat * inVertNorm;
+	outUV = inVertUV;
+	outColor = mix(inStartColor, inEndColor, t);
+
+	//set the position of the vertex
+	gl_Position = u_mvp * vec4(ParticlePos, 1.0);
+}
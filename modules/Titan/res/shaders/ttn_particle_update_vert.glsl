@@ -0,0 +1,159 @@
+#version 410
+
+//data from c++
+//the particle's state from last frame
+layout(location = 0) in vec4 inStartColor;
+layout(location = 1) in vec4 inEndColor;
+layout(location = 2) in vec3 inPosition;
+layout(location = 3) in float inTimeAlive;
+layout(location = 4) in vec3 inStartVelocity;
+layout(location = 5) in float inLifeTime;
+layout(location = 6) in vec3 inEndVelocity;
+layout(location = 7) in float inStartScale;
+layout(location = 8) in float inEndScale;
+
+//the particle's state this frame, captured by transform feedback in the same order as TTN_GPUParticle
+out vec4 tfStartColor;
+out vec4 tfEndColor;
+out vec3 tfPosition;
+out float tfTimeAlive;
+out vec3 tfStartVelocity;
+out float tfLifeTime;
+out vec3 tfEndVelocity;
+out float tfStartScale;
+out float tfEndScale;
+
+//frame data
+uniform float u_deltaTime;
+uniform int u_seed;
+//the range of particles being replaced by newly emitted ones this frame (wraps around the end of the buffer)
+uniform int u_maxParticles;
+uniform int u_spawnStart;
+uniform int u_spawnCount;
+
+//emitter data
+uniform int u_emitterShape;
+uniform float u_emitterAngle;
+uniform vec3 u_emitterScale;
+uniform mat3 u_emitterRotation;
+
+//particle template data, the 2 values of each pair are the range that's randomly picked from
+uniform vec4 u_startColor;
+uniform vec4 u_startColor2;
+uniform vec4 u_endColor;
+uniform vec4 u_endColor2;
+uniform vec2 u_startSizes;
+uniform vec2 u_endSizes;
+uniform vec2 u_startSpeeds;
+uniform vec2 u_endSpeeds;
+uniform vec2 u_lifeTimes;
+
+//the emitter shapes, same values as TTN_ParticleEmitterShape
+const int CONE = 0;
+const int SPHERE = 1;
+const int CIRCLE = 2;
+const int CUBE = 3;
+
+//random number generation, a hash of the particle's index and the frame's seed
+uint randomState;
+
+uint Hash(uint x) {
+	x ^= x >> 16;
+	x *= 0x7feb352du;
+	x ^= x >> 15;
+	x *= 0x846ca68bu;
+	x ^= x >> 16;
+	return x;
+}
+
+float RandomFloat(float minimum, float maximum) {
+	randomState = Hash(randomState);
+	return mix(minimum, maximum, float(randomState) / 4294967295.0);
+}
+
+vec4 RandomVec4(vec4 minimum, vec4 maximum) {
+	return vec4(RandomFloat(minimum.x, maximum.x), RandomFloat(minimum.y, maximum.y),
+		RandomFloat(minimum.z, maximum.z), RandomFloat(minimum.w, maximum.w));
+}
+
+//rotates a vector by euler angles (in radians) the same way glm::quat(eulerAngles) does
+vec3 RotateByEuler(vec3 v, vec3 euler) {
+	vec3 c = cos(euler * 0.5);
+	vec3 s = sin(euler * 0.5);
+	vec4 q = vec4(s.x * c.y * c.z - c.x * s.y * s.z,
+		c.x * s.y * c.z + s.x * c.y * s.z,
+		c.x * c.y * s.z - s.x * s.y * c.z,
+		c.x * c.y * c.z + s.x * s.y * s.z);
+	return v + 2.0 * cross(q.xyz, cross(q.xyz, v) + q.w * v);
+}
+
+//sets up a newly emitted particle, the same way TTN_ParticleSystem::Emit does on the cpu
+void Emit() {
+	//position
+	tfPosition = vec3(0.0);
+	if (u_emitterShape == CUBE)
+		tfPosition = vec3(RandomFloat(-u_emitterScale.x / 2.0, u_emitterScale.x / 2.0),
+			RandomFloat(-u_emitterScale.y / 2.0, u_emitterScale.y / 2.0),
+			RandomFloat(-u_emitterScale.z / 2.0, u_emitterScale.z / 2.0));
+
+	//colors
+	tfStartColor = RandomVec4(u_startColor, u_startColor2);
+	tfEndColor = RandomVec4(u_endColor, u_endColor2);
+
+	//direction
+	vec3 dir = vec3(0.0, 1.0, 0.0);
+	if (u_emitterShape == SPHERE) {
+		dir = normalize(vec3(RandomFloat(-1.0, 1.0), RandomFloat(-1.0, 1.0), RandomFloat(-1.0, 1.0)));
+	}
+	else if (u_emitterShape == CIRCLE) {
+		dir = u_emitterRotation * normalize(vec3(RandomFloat(-1.0, 1.0), RandomFloat(-1.0, 1.0), 0.0));
+	}
+	else if (u_emitterShape == CONE) {
+		vec3 coneRot = vec3(RandomFloat(-u_emitterAngle, u_emitterAngle), 0.0, RandomFloat(-u_emitterAngle, u_emitterAngle));
+		dir = u_emitterRotation * RotateByEuler(dir, coneRot);
+	}
+	else if (u_emitterShape == CUBE) {
+		dir = u_emitterRotation * dir;
+	}
+
+	//velocities
+	tfStartVelocity = dir * RandomFloat(u_startSpeeds.x, u_startSpeeds.y);
+	tfEndVelocity = dir * RandomFloat(u_endSpeeds.x, u_endSpeeds.y);
+
+	//scales
+	tfStartScale = RandomFloat(u_startSizes.x, u_startSizes.y);
+	tfEndScale = RandomFloat(u_endSizes.x, u_endSizes.y);
+
+	//lifetime
+	tfTimeAlive = 0.0;
+	tfLifeTime = RandomFloat(u_lifeTimes.x, u_lifeTimes.y);
+}
+
+void main() {
+	//copy the old state over
+	tfStartColor = inStartColor;
+	tfEndColor = inEndColor;
+	tfPosition = inPosition;
+	tfTimeAlive = inTimeAlive;
+	tfStartVelocity = inStartVelocity;
+	tfLifeTime = inLifeTime;
+	tfEndVelocity = inEndVelocity;
+	tfStartScale = inStartScale;
+	tfEndScale = inEndScale;
+
+	//if this particle is being replaced this frame, emit a new one in it's place
+	int spawnOffset = (gl_VertexID - u_spawnStart + u_maxParticles) % u_maxParticles;
+	if (spawnOffset < u_spawnCount) {
+		randomState = Hash(uint(gl_VertexID) ^ Hash(uint(u_seed)));
+		Emit();
+	}
+
+	//dead particles just stay where they are
+	if (tfTimeAlive >= tfLifeTime)
+		return;
+
+	//age it and move it based on the interpolation of the velocities
+	tfTimeAlive += u_deltaTime;
+	float t = clamp(tfTimeAlive / tfLifeTime, 0.0, 1.0);
+	tfPosition += mix(tfStartVelocity, tfEndVelocity, t) * u_deltaTime;
+}
@@ -6,11 +6,32 @@ layout(location = 1) in vec3 inNormal;
 layout(location = 2) in vec2 inUV;
 layout(location = 3) in vec3 inColor;
 
+//per-instance data, only read when the mesh is drawn instanced
+layout(location = 6) in mat4 inInstanceModel;
+layout(location = 10) in mat3 inInstanceNormalMat;
+layout(location = 13) in uint inInstanceMaterial;
+
+//per-frame scene data, filled once a frame by TTN_Scene (std140, see TTN_SceneUniformData)
+layout(std140) uniform TTN_SceneData {
+	mat4  u_View;
+	mat4  u_Projection;
+	mat4  u_ViewProjection;
+	vec4  u_CamPos;
+	vec4  u_Ambient;
+	vec4  u_LightPos[16];
+	vec4  u_LightCol[16];
+	vec4  u_LightStrength[16];
+	vec4  u_LightAttenuation[16];
+	int   u_NumOfLights;
+};
+
 //mesh data to pass to the frag shader
 layout(location = 0) out vec3 outPos;
 layout(location = 1) out vec3 outNormal;
 layout(location = 2) out vec2 outUV;
 layout(location = 3) out vec3 outColor;
+//the index of the material in the scene's material storage buffer
+layout(location = 4) flat out uint outMaterial;
 
 //model, view, projection matrix
 uniform mat4 MVP;
@@ -18,14 +39,31 @@ uniform mat4 MVP;
 uniform mat4 Model; 
 //normal matrix
 uniform mat3 NormalMat;
+//1 if the matrices should come from the instance attributes instead of the uniforms above
+uniform int u_Instanced;
+//the index of the material in the scene's material storage buffer, for draws that aren't instanced
+uniform int u_MaterialIndex;
 
 void main() {
-	//calculate the position
-	vec4 newPos = MVP * vec4(inPos, 1.0);
+	//pick the matrices for this draw
+	mat4 model = Model;
+	mat3 normalMat = NormalMat;
+	vec4 newPos;
+	outMaterial = uint(u_MaterialIndex);
+	if (u_Instanced == 1) {
+		model = inInstanceModel;
+		outMaterial = inInstanceMaterial;
+		normalMat = inInstanceNormalMat;
+		newPos = u_ViewProjection * model * vec4(inPos, 1.0);
+	}
+	else {
+		//calculate the position
+		newPos = MVP * vec4(inPos, 1.0);
+	}
 
 	//pass data onto the frag shader
-	outPos = (Model * vec4(inPos, 1.0)).xyz;
-	outNormal = NormalMat * inNormal;
+	outPos = (model * vec4(inPos, 1.0)).xyz;
+	outNormal = normalMat * inNormal;
 	outUV = inUV;
 	outColor = inColor;
 
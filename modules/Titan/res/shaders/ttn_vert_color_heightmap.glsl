@@ -10,6 +10,8 @@ layout(location = 0) out vec3 outPos;
 layout(location = 1) out vec3 outNormal;
 layout(location = 2) out vec2 outUV;
 layout(location = 3) out vec3 outColor;
+//the index of the material in the scene's material storage buffer
+layout(location = 4) flat out uint outMaterial;
 
 //texture
 uniform sampler2D Texture;
@@ -23,6 +25,8 @@ uniform mat4 MVP;
 uniform mat4 Model; 
 //normal matrix
 uniform mat3 NormalMat;
+//the index of the material in the scene's material storage buffer
+uniform int u_MaterialIndex;
 
 void main() {
 
@@ -32,6 +36,7 @@ void main() {
 	outUV = inUV;
 	//outColor = vec3(0.5, 0.5, 0.5);
 	outColor = inColor;
+	outMaterial = uint(u_MaterialIndex);
 
 	vec3 vert = inPos;
 	vert = vert + texture(Texture, inUV).r * u_influence * outNormal;
@@ -13,6 +13,8 @@ layout(location = 0) out vec3 outPos;
 layout(location = 1) out vec3 outNormal;
 layout(location = 2) out vec2 outUV;
 layout(location = 3) out vec3 outColor;
+//the index of the material in the scene's material storage buffer
+layout(location = 4) flat out uint outMaterial;
 
 //model, view, projection matrix
 uniform mat4 MVP;
@@ -20,6 +22,8 @@ uniform mat4 MVP;
 uniform mat4 Model; 
 //normal matrix
 uniform mat3 NormalMat;
+//the index of the material in the scene's material storage buffer
+uniform int u_MaterialIndex;
 
 //uniform with the value of the interpolation 
 uniform float t; 
@@ -37,6 +41,7 @@ void main() {
 	outNormal = NormalMat * normal;
 	outUV = inUV;
 	outColor = inColor;
+	outMaterial = uint(u_MaterialIndex);
 
 	//set the position of the vertex
 	gl_Position = newPos;
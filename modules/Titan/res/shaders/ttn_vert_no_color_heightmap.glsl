@@ -9,6 +9,8 @@ layout(location = 0) out vec3 outPos;
 layout(location = 1) out vec3 outNormal;
 layout(location = 2) out vec2 outUV;
 layout(location = 3) out vec3 outColor;
+//the index of the material in the scene's material storage buffer
+layout(location = 4) flat out uint outMaterial;
 
 //texture
 uniform sampler2D Texture;
@@ -22,6 +24,8 @@ uniform mat4 MVP;
 uniform mat4 Model; 
 //normal matrix
 uniform mat3 NormalMat;
+//the index of the material in the scene's material storage buffer
+uniform int u_MaterialIndex;
 
 void main() {
 
@@ -30,6 +34,7 @@ void main() {
 	outNormal = NormalMat * inNormal;
 	outUV = inUV;
 	outColor = vec3(1.0, 1.0, 1.0);
+	outMaterial = uint(u_MaterialIndex);
 
 	vec3 vert = inPos;
 	vert = vert + texture(Texture, inUV).r * u_influence * outNormal;
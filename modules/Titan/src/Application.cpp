@@ -3,6 +3,7 @@
 
 //include the header 
 #include "Titan/Application.h"
+#include "Titan/AssetLoader.h"
 //import other required features
 #include <stdio.h>
 
@@ -125,6 +126,9 @@ namespace Titan {
 		//check for events from glfw 
 		glfwPollEvents();
 
+		//send any assets that have finished loading in the background to opengl, a few at a time so the frame isn't held up
+		TTN_AssetLoader::ProcessUploads();
+
 		//go through each scene 
 		for (int i = 0; i < TTN_Application::scenes.size(); i++) {
 			//and check if they should be rendered
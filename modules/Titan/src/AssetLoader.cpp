@@ -0,0 +1,120 @@
+//Titan Engine, by Atlas X Games
+// AssetLoader.cpp - source file for the class that reads meshes and textures on worker threads and sends them to opengl a few at a time on the main thread
+
+//include the header
+#include "Titan/AssetLoader.h"
+#include "Titan/ObjLoader.h"
+#include "Titan/TextureCompressor.h"
+//import other required features
+#include <chrono>
+
+namespace Titan {
+	//starts loading a mesh from an obj file
+	TTN_Asset<TTN_Mesh> TTN_AssetLoader::LoadMesh(const std::string& fileName)
+	{
+		return Start<TTN_Mesh>(TTN_ResourceType::MESH, TTN_ResourceCache::GetMeshKey(fileName), [fileName]() {
+			return TTN_ObjLoader::ReadFromFile(fileName);
+		});
+	}
+
+	//starts loading a mesh with morph targets from a series of obj files
+	TTN_Asset<TTN_Mesh> TTN_AssetLoader::LoadAnimatedMesh(const std::string& fileName, int numOfFiles)
+	{
+		return Start<TTN_Mesh>(TTN_ResourceType::MESH, TTN_ResourceCache::GetMeshKey(fileName, numOfFiles), [fileName, numOfFiles]() {
+			return TTN_ObjLoader::ReadAnimatedMeshFromFiles(fileName, numOfFiles);
+		});
+	}
+
+	//starts loading a 2D texture from an image file
+	TTN_Asset<TTN_Texture2D> TTN_AssetLoader::LoadTexture2D(const std::string& fileName, bool flipped, bool forceRgba)
+	{
+		return Start<TTN_Texture2D>(TTN_ResourceType::TEXTURE_2D, TTN_ResourceCache::GetTexture2DKey(fileName, flipped, forceRgba),
+			[fileName, flipped, forceRgba]() -> std::function<TTN_Texture2D::st2dptr()> {
+			//decode (and compress, if that's on) the image here, then make the texture and upload it on the main thread
+			TTN_Texture2DData::st2ddptr data = TTN_TextureCompressor::LoadFromFile(fileName, flipped, forceRgba);
+			if (data == nullptr)
+				return nullptr;
+
+			return [data]() {
+				TTN_Texture2D::st2dptr texture = TTN_Texture2D::Create();
+				texture->LoadData(data);
+				return texture;
+			};
+		});
+	}
+
+	//starts loading a cubemap from 6 images
+	TTN_Asset<TTN_TextureCubeMap> TTN_AssetLoader::LoadTextureCubeMap(const std::string& filePath)
+	{
+		return Start<TTN_TextureCubeMap>(TTN_ResourceType::TEXTURE_CUBEMAP, TTN_ResourceCache::GetTextureCubeMapKey(filePath),
+			[filePath]() -> std::function<TTN_TextureCubeMap::stcmptr()> {
+			//decode all 6 faces here, then make the cubemap and upload it on the main thread
+			TTN_TextureCubeMapData::stcmdptr data = TTN_TextureCubeMapData::LoadFromImages(filePath);
+			if (data == nullptr)
+				return nullptr;
+
+			return [data]() {
+				TTN_TextureCubeMap::stcmptr cubemap = TTN_TextureCubeMap::Create();
+				cubemap->LoadData(data);
+				return cubemap;
+			};
+		});
+	}
+
+	//runs the uploads that are ready until this frame's budget is used up
+	void TTN_AssetLoader::ProcessUploads()
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+		while (RunNextUpload(false)) {
+			std::chrono::duration<float, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+			if (elapsed.count() >= s_uploadBudget)
+				break;
+		}
+	}
+
+	//runs uploads until everything that's been started has finished loading
+	void TTN_AssetLoader::WaitForAll()
+	{
+		while (s_pending > 0)
+			RunNextUpload(true);
+	}
+
+	//gets the pool the files are read on
+	TTN_ThreadPool& TTN_AssetLoader::GetPool()
+	{
+		if (s_pool == nullptr)
+			s_pool = TTN_ThreadPool::Create();
+		return *s_pool;
+	}
+
+	//queues up a function to be run on the main thread
+	void TTN_AssetLoader::PushUpload(std::function<void()> upload)
+	{
+		{
+			std::lock_guard<std::mutex> lock(s_uploadMutex);
+			s_uploads.push_back(std::move(upload));
+		}
+		s_uploadAdded.notify_one();
+	}
+
+	//runs the next queued upload
+	bool TTN_AssetLoader::RunNextUpload(bool wait)
+	{
+		std::function<void()> upload;
+		{
+			std::unique_lock<std::mutex> lock(s_uploadMutex);
+			//only wait if something's still loading, otherwise nothing would ever wake us up
+			if (wait)
+				s_uploadAdded.wait(lock, []() { return !s_uploads.empty() || s_pending == 0; });
+			if (s_uploads.empty())
+				return false;
+
+			upload = std::move(s_uploads.front());
+			s_uploads.pop_front();
+		}
+
+		//run it outside the lock so the workers can keep queueing while it uploads
+		upload();
+		return true;
+	}
+}
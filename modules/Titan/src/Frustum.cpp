@@ -0,0 +1,78 @@
+//Titan Engine, by Atlas X Games
+// Frustum.cpp - source file for the class that represents the volume a camera can see, used to skip drawing things that are off screen
+
+//include the header
+#include "Titan/Frustum.h"
+
+//use sse for the plane tests when building for a cpu that has it
+#if defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1) || defined(__SSE__)
+#define TTN_FRUSTUM_SSE 1
+#include <xmmintrin.h>
+#endif
+
+namespace Titan {
+	namespace {
+		//a plane distance so big nothing can be behind it, used for the padding planes
+		const float c_alwaysInside = 1e30f;
+	}
+
+	//constructor, makes a frustum that everything is inside
+	TTN_Frustum::TTN_Frustum()
+	{
+		for (int i = 0; i < 8; i++) {
+			m_planeX[i] = 0.0f;
+			m_planeY[i] = 0.0f;
+			m_planeZ[i] = 0.0f;
+			m_planeW[i] = c_alwaysInside;
+		}
+	}
+
+	//builds the planes out of a view projection matrix
+	void TTN_Frustum::SetFromViewProjection(const glm::mat4& viewProjection)
+	{
+		//glm matrices are column major, so pull the rows out first
+		glm::vec4 rows[4];
+		for (int i = 0; i < 4; i++)
+			rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+
+		//left, right, bottom, top, near, far
+		glm::vec4 planes[6] = { rows[3] + rows[0], rows[3] - rows[0], rows[3] + rows[1], rows[3] - rows[1], rows[3] + rows[2], rows[3] - rows[2] };
+
+		for (int i = 0; i < 6; i++) {
+			//normalize them so the distances are in world units and can be compared to sphere radii
+			float length = glm::length(glm::vec3(planes[i]));
+			if (length > 0.0f) planes[i] /= length;
+
+			m_planeX[i] = planes[i].x;
+			m_planeY[i] = planes[i].y;
+			m_planeZ[i] = planes[i].z;
+			m_planeW[i] = planes[i].w;
+		}
+	}
+
+	//checks if any part of a sphere might be inside the frustum
+	bool TTN_Frustum::TestSphere(glm::vec3 center, float radius) const
+	{
+#if TTN_FRUSTUM_SSE
+		__m128 centerX = _mm_set1_ps(center.x);
+		__m128 centerY = _mm_set1_ps(center.y);
+		__m128 centerZ = _mm_set1_ps(center.z);
+		__m128 negRadius = _mm_set1_ps(-radius);
+
+		//the signed distance from 4 planes to the center at once, if it's further than the radius behind any of them it's outside
+		for (int i = 0; i < 8; i += 4) {
+			__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_load_ps(m_planeX + i), centerX), _mm_mul_ps(_mm_load_ps(m_planeY + i), centerY)),
+				_mm_add_ps(_mm_mul_ps(_mm_load_ps(m_planeZ + i), centerZ), _mm_load_ps(m_planeW + i)));
+			if (_mm_movemask_ps(_mm_cmplt_ps(distance, negRadius)) != 0)
+				return false;
+		}
+		return true;
+#else
+		for (int i = 0; i < 6; i++) {
+			if (m_planeX[i] * center.x + m_planeY[i] * center.y + m_planeZ[i] * center.z + m_planeW[i] < -radius)
+				return false;
+		}
+		return true;
+#endif
+	}
+}
@@ -0,0 +1,41 @@
+//Titan Engine, by Atlas X Games
+// Hash.cpp - source file for the class with the hashing and file checking functions the asset caches use to tell if their sources changed
+
+#include "Titan/Hash.h"
+#include "Titan/MappedFile.h"
+
+//import other required features
+#include <filesystem>
+
+namespace Titan {
+	//64 bit FNV-1a hash
+	uint64_t TTN_Hash::FNV1a(const void* data, size_t size, uint64_t hash)
+	{
+		const unsigned char* bytes = (const unsigned char*)data;
+		for (size_t i = 0; i < size; i++) {
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	//hashes the contents of a file, mapping it so it doesn't have to be copied into memory first
+	bool TTN_Hash::HashFile(const std::string& fileName, uint64_t& hash)
+	{
+		TTN_MappedFile file(fileName);
+		if (!file.GetIsOpen())
+			return false;
+		hash = FNV1a(file.GetData(), file.GetSize());
+		return true;
+	}
+
+	//gets the size and last write time of a file
+	bool TTN_Hash::GetFileInfo(const std::string& fileName, uint64_t& size, int64_t& timestamp)
+	{
+		std::error_code error;
+		size = (uint64_t)std::filesystem::file_size(fileName, error);
+		if (error) return false;
+		timestamp = (int64_t)std::filesystem::last_write_time(fileName, error).time_since_epoch().count();
+		return !error;
+	}
+}
@@ -0,0 +1,221 @@
+//Titan Engine, by Atlas X Games
+// HeadlessGL.cpp - source file for the stand-in OpenGL backend that counts calls instead of sending them to a GPU, used to benchmark without a window
+
+#include "Titan/HeadlessGL.h"
+
+//import other required features
+#include <unordered_map>
+#include <vector>
+
+namespace Titan {
+	//the next handle the stubs will give out for a shader, buffer, texture, etc.
+	static GLuint s_nextHandle = 1;
+	//the next uniform location the stubs will give out, the shaders cache these so they just have to be valid
+	static GLint s_nextUniformLocation = 0;
+	//memory standing in for the buffers that get mapped, only made when a buffer is acutally mapped
+	//(never freed, so buffers deleted during shutdown don't touch an already destroyed map)
+	static std::unordered_map<GLuint, std::vector<uint8_t>>& GetMappedMemory() {
+		static std::unordered_map<GLuint, std::vector<uint8_t>>* mappedMemory = new std::unordered_map<GLuint, std::vector<uint8_t>>();
+		return *mappedMemory;
+	}
+
+	//hands out n new handles
+	static void GenerateHandles(GLsizei n, GLuint* handles) {
+		for (GLsizei i = 0; i < n; i++)
+			handles[i] = s_nextHandle++;
+	}
+
+	//points all of the OpenGL functions titan uses at the counting stubs
+	void TTN_HeadlessGL::Install()
+	{
+		//shaders and shader programs, everything compiles and links succesfully
+		glad_glCreateShader = [](GLenum) -> GLuint { s_stats.TotalCalls++; return s_nextHandle++; };
+		glad_glShaderSource = [](GLuint, GLsizei, const GLchar* const*, const GLint*) { s_stats.TotalCalls++; };
+		glad_glCompileShader = [](GLuint) { s_stats.TotalCalls++; };
+		glad_glGetShaderiv = [](GLuint, GLenum pname, GLint* params) {
+			s_stats.TotalCalls++;
+			*params = (pname == GL_COMPILE_STATUS) ? GL_TRUE : 0;
+		};
+		glad_glGetShaderInfoLog = [](GLuint, GLsizei, GLsizei* length, GLchar* infoLog) {
+			s_stats.TotalCalls++;
+			if (length != nullptr) *length = 0;
+			if (infoLog != nullptr) infoLog[0] = '\0';
+		};
+		glad_glDeleteShader = [](GLuint) { s_stats.TotalCalls++; };
+		glad_glCreateProgram = []() -> GLuint { s_stats.TotalCalls++; return s_nextHandle++; };
+		glad_glAttachShader = [](GLuint, GLuint) { s_stats.TotalCalls++; };
+		glad_glDetachShader = [](GLuint, GLuint) { s_stats.TotalCalls++; };
+		glad_glLinkProgram = [](GLuint) { s_stats.TotalCalls++; };
+		glad_glTransformFeedbackVaryings = [](GLuint, GLsizei, const GLchar* const*, GLenum) { s_stats.TotalCalls++; };
+		glad_glGetProgramiv = [](GLuint, GLenum pname, GLint* params) {
+			s_stats.TotalCalls++;
+			*params = (pname == GL_LINK_STATUS) ? GL_TRUE : 0;
+		};
+		glad_glGetProgramInfoLog = [](GLuint, GLsizei, GLsizei* length, GLchar* infoLog) {
+			s_stats.TotalCalls++;
+			if (length != nullptr) *length = 0;
+			if (infoLog != nullptr) infoLog[0] = '\0';
+		};
+		glad_glDeleteProgram = [](GLuint) { s_stats.TotalCalls++; };
+		glad_glUseProgram = [](GLuint) { s_stats.TotalCalls++; s_stats.ShaderBinds++; };
+		glad_glGetUniformLocation = [](GLuint, const GLchar*) -> GLint { s_stats.TotalCalls++; return s_nextUniformLocation++; };
+		glad_glGetUniformBlockIndex = [](GLuint, const GLchar*) -> GLuint { s_stats.TotalCalls++; return 0; };
+		glad_glUniformBlockBinding = [](GLuint, GLuint, GLuint) { s_stats.TotalCalls++; };
+		glad_glGetProgramResourceIndex = [](GLuint, GLenum, const GLchar*) -> GLuint { s_stats.TotalCalls++; return 0; };
+		glad_glShaderStorageBlockBinding = [](GLuint, GLuint, GLuint) { s_stats.TotalCalls++; };
+
+		//uniforms
+		glad_glProgramUniform1fv = [](GLuint, GLint, GLsizei, const GLfloat*) { s_stats.TotalCalls++; s_stats.UniformUploads++; };
+		glad_glProgramUniform2fv = [](GLuint, GLint, GLsizei, const GLfloat*) { s_stats.TotalCalls++; s_stats.UniformUploads++; };
+		glad_glProgramUniform3fv = [](GLuint, GLint, GLsizei, const GLfloat*) { s_stats.TotalCalls++; s_stats.UniformUploads++; };
+		glad_glProgramUniform4fv = [](GLuint, GLint, GLsizei, const GLfloat*) { s_stats.TotalCalls++; s_stats.UniformUploads++; };
+		glad_glProgramUniform1iv = [](GLuint, GLint, GLsizei, const GLint*) { s_stats.TotalCalls++; s_stats.UniformUploads++; };
+		glad_glProgramUniform2iv = [](GLuint, GLint, GLsizei, const GLint*) { s_stats.TotalCalls++; s_stats.UniformUploads++; };
+		glad_glProgramUniform3iv = [](GLuint, GLint, GLsizei, const GLint*) { s_stats.TotalCalls++; s_stats.UniformUploads++; };
+		glad_glProgramUniform4iv = [](GLuint, GLint, GLsizei, const GLint*) { s_stats.TotalCalls++; s_stats.UniformUploads++; };
+		glad_glProgramUniform1i = [](GLuint, GLint, GLint) { s_stats.TotalCalls++; s_stats.UniformUploads++; };
+		glad_glProgramUniform2i = [](GLuint, GLint, GLint, GLint) { s_stats.TotalCalls++; s_stats.UniformUploads++; };
+		glad_glProgramUniform3i = [](GLuint, GLint, GLint, GLint, GLint) { s_stats.TotalCalls++; s_stats.UniformUploads++; };
+		glad_glProgramUniform4i = [](GLuint, GLint, GLint, GLint, GLint, GLint) { s_stats.TotalCalls++; s_stats.UniformUploads++; };
+		glad_glProgramUniformMatrix3fv = [](GLuint, GLint, GLsizei, GLboolean, const GLfloat*) { s_stats.TotalCalls++; s_stats.UniformUploads++; };
+		glad_glProgramUniformMatrix4fv = [](GLuint, GLint, GLsizei, GLboolean, const GLfloat*) { s_stats.TotalCalls++; s_stats.UniformUploads++; };
+		glad_glProgramUniformHandleui64ARB = [](GLuint, GLint, GLuint64) { s_stats.TotalCalls++; s_stats.UniformUploads++; };
+
+		//buffers and vertex array objects
+		glad_glCreateBuffers = [](GLsizei n, GLuint* buffers) { s_stats.TotalCalls++; GenerateHandles(n, buffers); };
+		glad_glDeleteBuffers = [](GLsizei n, const GLuint* buffers) {
+			s_stats.TotalCalls++;
+			for (GLsizei i = 0; i < n; i++)
+				GetMappedMemory().erase(buffers[i]);
+		};
+		glad_glBindBuffer = [](GLenum, GLuint) { s_stats.TotalCalls++; s_stats.BufferBinds++; };
+		glad_glBindBufferBase = [](GLenum, GLuint, GLuint) { s_stats.TotalCalls++; s_stats.BufferBinds++; };
+		glad_glNamedBufferData = [](GLuint, GLsizeiptr size, const void*, GLenum) {
+			s_stats.TotalCalls++;
+			s_stats.BufferUploads++;
+			s_stats.BufferBytes += (uint64_t)size;
+		};
+		glad_glNamedBufferSubData = [](GLuint, GLintptr, GLsizeiptr size, const void*) {
+			s_stats.TotalCalls++;
+			s_stats.BufferUploads++;
+			s_stats.BufferBytes += (uint64_t)size;
+		};
+		glad_glNamedBufferStorage = [](GLuint, GLsizeiptr size, const void* data, GLbitfield) {
+			s_stats.TotalCalls++;
+			if (data != nullptr) {
+				s_stats.BufferUploads++;
+				s_stats.BufferBytes += (uint64_t)size;
+			}
+		};
+		glad_glMapNamedBufferRange = [](GLuint buffer, GLintptr offset, GLsizeiptr length, GLbitfield) -> void* {
+			s_stats.TotalCalls++;
+			std::vector<uint8_t>& memory = GetMappedMemory()[buffer];
+			if (memory.size() < (size_t)(offset + length))
+				memory.resize((size_t)(offset + length));
+			return memory.data() + offset;
+		};
+		glad_glUnmapNamedBuffer = [](GLuint) -> GLboolean { s_stats.TotalCalls++; return GL_TRUE; };
+		glad_glFenceSync = [](GLenum, GLbitfield) -> GLsync { s_stats.TotalCalls++; return (GLsync)(uintptr_t)(s_nextHandle++); };
+		glad_glClientWaitSync = [](GLsync, GLbitfield, GLuint64) -> GLenum { s_stats.TotalCalls++; return GL_ALREADY_SIGNALED; };
+		glad_glDeleteSync = [](GLsync) { s_stats.TotalCalls++; };
+		glad_glCreateVertexArrays = [](GLsizei n, GLuint* arrays) { s_stats.TotalCalls++; GenerateHandles(n, arrays); };
+		glad_glDeleteVertexArrays = [](GLsizei, const GLuint*) { s_stats.TotalCalls++; };
+		glad_glBindVertexArray = [](GLuint) { s_stats.TotalCalls++; s_stats.VaoBinds++; };
+		glad_glEnableVertexArrayAttrib = [](GLuint, GLuint) { s_stats.TotalCalls++; };
+		glad_glDisableVertexArrayAttrib = [](GLuint, GLuint) { s_stats.TotalCalls++; };
+		glad_glVertexAttribPointer = [](GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) { s_stats.TotalCalls++; };
+		glad_glVertexAttribIPointer = [](GLuint, GLint, GLenum, GLsizei, const void*) { s_stats.TotalCalls++; };
+		glad_glVertexAttribDivisor = [](GLuint, GLuint) { s_stats.TotalCalls++; };
+
+		//transform feedback
+		glad_glCreateTransformFeedbacks = [](GLsizei n, GLuint* ids) { s_stats.TotalCalls++; GenerateHandles(n, ids); };
+		glad_glDeleteTransformFeedbacks = [](GLsizei, const GLuint*) { s_stats.TotalCalls++; };
+		glad_glTransformFeedbackBufferBase = [](GLuint, GLuint, GLuint) { s_stats.TotalCalls++; };
+		glad_glBindTransformFeedback = [](GLenum, GLuint) { s_stats.TotalCalls++; };
+		glad_glBeginTransformFeedback = [](GLenum) { s_stats.TotalCalls++; };
+		glad_glEndTransformFeedback = []() { s_stats.TotalCalls++; };
+
+		//textures
+		glad_glCreateTextures = [](GLenum, GLsizei n, GLuint* textures) { s_stats.TotalCalls++; GenerateHandles(n, textures); };
+		glad_glDeleteTextures = [](GLsizei, const GLuint*) { s_stats.TotalCalls++; };
+		glad_glIsTexture = [](GLuint texture) -> GLboolean { s_stats.TotalCalls++; return (texture != 0) ? GL_TRUE : GL_FALSE; };
+		glad_glBindTextureUnit = [](GLuint, GLuint) { s_stats.TotalCalls++; s_stats.TextureBinds++; };
+		glad_glTextureStorage2D = [](GLuint, GLsizei, GLenum, GLsizei, GLsizei) { s_stats.TotalCalls++; };
+		glad_glTextureSubImage2D = [](GLuint, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, const void*) { s_stats.TotalCalls++; };
+		glad_glCompressedTextureSubImage2D = [](GLuint, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLsizei, const void*) { s_stats.TotalCalls++; };
+		glad_glTextureSubImage3D = [](GLuint, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLenum, const void*) { s_stats.TotalCalls++; };
+		glad_glClearTexImage = [](GLuint, GLint, GLenum, GLenum, const void*) { s_stats.TotalCalls++; };
+		glad_glGenerateTextureMipmap = [](GLuint) { s_stats.TotalCalls++; };
+		glad_glTextureParameteri = [](GLuint, GLenum, GLint) { s_stats.TotalCalls++; };
+		glad_glTextureParameterf = [](GLuint, GLenum, GLfloat) { s_stats.TotalCalls++; };
+		glad_glPixelStorei = [](GLenum, GLint) { s_stats.TotalCalls++; };
+		glad_glObjectLabel = [](GLenum, GLuint, GLsizei, const GLchar*) { s_stats.TotalCalls++; };
+		//bindless textures, every texture's handle is just it's name
+		GLAD_GL_ARB_bindless_texture = 1;
+		glad_glGetTextureHandleARB = [](GLuint texture) -> GLuint64 { s_stats.TotalCalls++; return (GLuint64)texture; };
+		glad_glMakeTextureHandleResidentARB = [](GLuint64) { s_stats.TotalCalls++; };
+		glad_glMakeTextureHandleNonResidentARB = [](GLuint64) { s_stats.TotalCalls++; };
+
+		//draw calls
+		glad_glDrawArrays = [](GLenum, GLint, GLsizei) { s_stats.TotalCalls++; s_stats.DrawCalls++; };
+		glad_glDrawElements = [](GLenum, GLsizei, GLenum, const void*) { s_stats.TotalCalls++; s_stats.DrawCalls++; };
+		glad_glDrawArraysInstanced = [](GLenum, GLint, GLsizei, GLsizei instancecount) {
+			s_stats.TotalCalls++;
+			s_stats.DrawCalls++;
+			s_stats.InstancedDrawCalls++;
+			s_stats.InstancesDrawn += (uint64_t)instancecount;
+		};
+		glad_glDrawElementsInstanced = [](GLenum, GLsizei, GLenum, const void*, GLsizei instancecount) {
+			s_stats.TotalCalls++;
+			s_stats.DrawCalls++;
+			s_stats.InstancedDrawCalls++;
+			s_stats.InstancesDrawn += (uint64_t)instancecount;
+		};
+		glad_glDrawArraysInstancedBaseInstance = [](GLenum, GLint, GLsizei, GLsizei instancecount, GLuint) {
+			s_stats.TotalCalls++;
+			s_stats.DrawCalls++;
+			s_stats.InstancedDrawCalls++;
+			s_stats.InstancesDrawn += (uint64_t)instancecount;
+		};
+		glad_glDrawElementsInstancedBaseInstance = [](GLenum, GLsizei, GLenum, const void*, GLsizei instancecount, GLuint) {
+			s_stats.TotalCalls++;
+			s_stats.DrawCalls++;
+			s_stats.InstancedDrawCalls++;
+			s_stats.InstancesDrawn += (uint64_t)instancecount;
+		};
+
+		//general state and queries, give back limits that are common on desktop hardware
+		glad_glEnable = [](GLenum) { s_stats.TotalCalls++; };
+		glad_glDisable = [](GLenum) { s_stats.TotalCalls++; };
+		glad_glDepthFunc = [](GLenum) { s_stats.TotalCalls++; };
+		glad_glBlendFunc = [](GLenum, GLenum) { s_stats.TotalCalls++; };
+		glad_glClear = [](GLbitfield) { s_stats.TotalCalls++; };
+		glad_glClearColor = [](GLfloat, GLfloat, GLfloat, GLfloat) { s_stats.TotalCalls++; };
+		glad_glGetIntegerv = [](GLenum pname, GLint* data) {
+			s_stats.TotalCalls++;
+			switch (pname) {
+			case GL_MAX_TEXTURE_SIZE:
+				*data = 16384;
+				break;
+			case GL_MAX_3D_TEXTURE_SIZE:
+				*data = 2048;
+				break;
+			case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
+				*data = 192;
+				break;
+			case GL_MAX_TEXTURE_IMAGE_UNITS:
+				*data = 32;
+				break;
+			default:
+				*data = 0;
+				break;
+			}
+		};
+		glad_glGetFloatv = [](GLenum pname, GLfloat* data) {
+			s_stats.TotalCalls++;
+			*data = (pname == GL_MAX_TEXTURE_MAX_ANISOTROPY) ? 16.0f : 0.0f;
+		};
+
+		s_installed = true;
+	}
+}
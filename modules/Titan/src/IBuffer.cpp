@@ -33,6 +33,12 @@ namespace Titan {
 		_elementSize = elementSize;
 	}
 
+	//updates part of the data in the buffer without reallocating it's storage
+	void TTN_IBuffer::UpdateData(const void* data, size_t size, size_t offset)
+	{
+		glNamedBufferSubData(_handle, offset, size, data);
+	}
+
 	//bind the buffer so it can be used
 	void TTN_IBuffer::Bind()
 	{
@@ -0,0 +1,86 @@
+//Titan Engine, by Atlas X Games
+// MappedFile.cpp - source file for the class that maps a file into memory so it can be read without copying it into a buffer first
+
+#include "Titan/MappedFile.h"
+
+//import the os's file mapping functions
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Titan {
+	//constructor, maps the file
+	TTN_MappedFile::TTN_MappedFile(const std::string& fileName)
+		: m_data(nullptr), m_size(0), m_isOpen(false)
+	{
+#ifdef _WIN32
+		m_mappingHandle = nullptr;
+		m_fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (m_fileHandle == INVALID_HANDLE_VALUE) {
+			m_fileHandle = nullptr;
+			return;
+		}
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(m_fileHandle, &size))
+			return;
+		m_size = (size_t)size.QuadPart;
+
+		//empty files can't be mapped, but they still opened fine
+		if (m_size > 0) {
+			m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (m_mappingHandle == nullptr)
+				return;
+			m_data = (const char*)MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+			if (m_data == nullptr)
+				return;
+		}
+#else
+		m_fileDescriptor = open(fileName.c_str(), O_RDONLY);
+		if (m_fileDescriptor < 0)
+			return;
+
+		struct stat info;
+		if (fstat(m_fileDescriptor, &info) != 0)
+			return;
+		m_size = (size_t)info.st_size;
+
+		//empty files can't be mapped, but they still opened fine
+		if (m_size > 0) {
+			void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fileDescriptor, 0);
+			if (data == MAP_FAILED)
+				return;
+			m_data = (const char*)data;
+			//it's read front to back, so let the os read ahead
+			madvise(data, m_size, MADV_SEQUENTIAL);
+		}
+#endif
+		m_isOpen = true;
+	}
+
+	//destructor, unmaps the file
+	TTN_MappedFile::~TTN_MappedFile()
+	{
+#ifdef _WIN32
+		if (m_data != nullptr)
+			UnmapViewOfFile(m_data);
+		if (m_mappingHandle != nullptr)
+			CloseHandle(m_mappingHandle);
+		if (m_fileHandle != nullptr)
+			CloseHandle(m_fileHandle);
+#else
+		if (m_data != nullptr)
+			munmap((void*)m_data, m_size);
+		if (m_fileDescriptor >= 0)
+			close(m_fileDescriptor);
+#endif
+	}
+}
@@ -64,4 +64,15 @@ namespace Titan {
 	{
 		m_HeightInfluence = influence;
 	}
+
+	//gets the data for the material storage buffer
+	TTN_MaterialData TTN_Material::GetBindlessData()
+	{
+		TTN_MaterialData data;
+		data.Albedo = (m_Albedo != nullptr) ? m_Albedo->GetBindlessHandle() : 0;
+		data.Specular = (m_SpecularMap != nullptr) ? m_SpecularMap->GetBindlessHandle() : 0;
+		data.Shininess = m_Shininess;
+		data.padding = 0.0f;
+		return data;
+	}
 }
\ No newline at end of file
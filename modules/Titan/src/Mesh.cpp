@@ -3,6 +3,12 @@
 
 //include the header
 #include "Titan/Mesh.h"
+//include glm's packing functions, for unpacking quantized normals and uvs
+#include "GLM/gtc/packing.hpp"
+//import other required features
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 
 namespace Titan {
 	//constructor, creates a mesh
@@ -13,6 +19,16 @@ namespace Titan {
 
 		//set the mesh to not having vertex colors
 		m_HasVertColors = false;
+		m_halfFloatUvs = false;
+
+		//no vertices yet, so the bounds are empty
+		m_boundsMin = glm::vec3(0.0f);
+		m_boundsMax = glm::vec3(0.0f);
+		m_hasBounds = false;
+		m_sphereCenter = glm::vec3(0.0f);
+		m_sphereRadius = 0.0f;
+		m_sphereDirty = false;
+		m_instancedVaoDirty = false;
 	}
 
 	//destructor
@@ -20,6 +36,29 @@ namespace Titan {
 	{
 	}
 
+	//creates a mesh out of data that was read ahead of time
+	TTN_Mesh::smptr TTN_Mesh::Create(TTN_MeshData& data)
+	{
+		smptr newMesh = Create();
+		for (size_t frame = 0; frame < data.Positions.size(); frame++) {
+			newMesh->AddVertices(data.Positions[frame]);
+			newMesh->AddNormals(data.Normals[frame]);
+		}
+		newMesh->SetUVs(data.Uvs);
+		newMesh->SetIndices(data.Indices);
+		newMesh->UpdateBoundingSphere();
+		return newMesh;
+	}
+
+	//gets the attribute for reading the normals of a frame with the given layout into a slot
+	BufferAttribute TTN_Mesh::NormalAttribute(GLuint slot, const FrameLayout& layout)
+	{
+		//packed normals are 4 signed normalized components in one int, the shaders only read the first 3
+		if (layout.PackedNormals)
+			return BufferAttribute(slot, 4, GL_INT_2_10_10_10_REV, true, layout.Stride, layout.NormalOffset, AttribUsage::Normal);
+		return BufferAttribute(slot, 3, GL_FLOAT, false, layout.Stride, layout.NormalOffset, AttribUsage::Normal);
+	}
+
 	//sets up the VAO for the mesh so it can acutally be rendered, needs to be called by the user in case they change the mesh
 	void TTN_Mesh::SetUpVao(int currentFrame, int nextFrame)
 	{
@@ -30,17 +69,63 @@ namespace Titan {
 		else
 			m_vao->ClearVertexBuffers();
 
+		AddMeshBuffers(m_vao, currentFrame, nextFrame);
+	}
+
+	//adds the mesh's vbos and ibo to a vao, reading the given frames
+	void TTN_Mesh::AddMeshBuffers(const TTN_VertexArrayObject::svaptr& vao, int currentFrame, int nextFrame)
+	{
+		//frames that weren't added interleaved just use the default layout
+		FrameLayout current = (currentFrame < (int)m_frameLayouts.size()) ? m_frameLayouts[currentFrame] : FrameLayout();
+		FrameLayout next = (nextFrame < (int)m_frameLayouts.size()) ? m_frameLayouts[nextFrame] : FrameLayout();
+
 		//load the vbos from the mesh into the vao 
-		m_vao->AddVertexBuffer(m_vertVbos[currentFrame], { BufferAttribute(0, 3, GL_FLOAT, false, sizeof(float) * 3, 0, AttribUsage::Position) });
-		m_vao->AddVertexBuffer(m_normVbos[currentFrame], { BufferAttribute(1, 3, GL_FLOAT, false, sizeof(float) * 3, 0, AttribUsage::Normal) });
-		m_vao->AddVertexBuffer(m_UVsVbo, { BufferAttribute(2, 2, GL_FLOAT, false, sizeof(float) * 2, 0, AttribUsage::Texture) });
-		if (m_HasVertColors) m_vao->AddVertexBuffer(m_ColVbo, { BufferAttribute(3, 3, GL_FLOAT, false, sizeof(float) * 2, 0, AttribUsage::Color) });
-		m_vao->AddVertexBuffer(m_vertVbos[nextFrame], {BufferAttribute(4, 3, GL_FLOAT, false, sizeof(float) * 3, 0, AttribUsage::Position) });
-		m_vao->AddVertexBuffer(m_normVbos[nextFrame], { BufferAttribute(5, 3, GL_FLOAT, false, sizeof(float) * 3, 0, AttribUsage::Normal) });
+		vao->AddVertexBuffer(m_vertVbos[currentFrame], { BufferAttribute(0, 3, GL_FLOAT, false, current.Stride, 0, AttribUsage::Position) });
+		vao->AddVertexBuffer(m_normVbos[currentFrame], { NormalAttribute(1, current) });
+		if (m_halfFloatUvs) vao->AddVertexBuffer(m_UVsVbo, { BufferAttribute(2, 2, GL_HALF_FLOAT, false, sizeof(uint16_t) * 2, 0, AttribUsage::Texture) });
+		else vao->AddVertexBuffer(m_UVsVbo, { BufferAttribute(2, 2, GL_FLOAT, false, sizeof(float) * 2, 0, AttribUsage::Texture) });
+		if (m_HasVertColors) vao->AddVertexBuffer(m_ColVbo, { BufferAttribute(3, 3, GL_FLOAT, false, sizeof(float) * 2, 0, AttribUsage::Color) });
+		vao->AddVertexBuffer(m_vertVbos[nextFrame], {BufferAttribute(4, 3, GL_FLOAT, false, next.Stride, 0, AttribUsage::Position) });
+		vao->AddVertexBuffer(m_normVbos[nextFrame], { NormalAttribute(5, next) });
+
+		//and the indices, if it has them
+		if (m_ibo != nullptr)
+			vao->SetIndexBuffer(m_ibo);
+	}
+
+	//sets up the VAO to draw many copies of the mesh in one call
+	void TTN_Mesh::SetUpInstancedVao(const TTN_StreamBuffer::ssbptr& instanceBuffer)
+	{
+		//the layout only changes if the mesh or the instance buffer does, so it's only built once rather than for every draw
+		if (m_instancedVao != nullptr && !m_instancedVaoDirty && m_InstanceVbo == instanceBuffer)
+			return;
+
+		m_instancedVao = TTN_VertexArrayObject::Create();
+		m_InstanceVbo = instanceBuffer;
+		m_instancedVaoDirty = false;
+
+		//set up the normal mesh data first, instances are never morph animated so it's always the first frame
+		AddMeshBuffers(m_instancedVao, 0, 0);
+
+		//and add the instance buffer to it, a mat4 takes up 4 attribute slots and a mat3 takes 3, and all of them advance once per instance
+		const GLsizei stride = sizeof(TTN_InstanceData);
+		const size_t normalMatOffset = offsetof(TTN_InstanceData, NormalMat);
+		const size_t materialOffset = offsetof(TTN_InstanceData, MaterialIndex);
+		m_instancedVao->AddVertexBuffer(m_InstanceVbo, {
+			BufferAttribute(6, 4, GL_FLOAT, false, stride, 0, AttribUsage::User0, 1),
+			BufferAttribute(7, 4, GL_FLOAT, false, stride, sizeof(float) * 4, AttribUsage::User0, 1),
+			BufferAttribute(8, 4, GL_FLOAT, false, stride, sizeof(float) * 8, AttribUsage::User0, 1),
+			BufferAttribute(9, 4, GL_FLOAT, false, stride, sizeof(float) * 12, AttribUsage::User0, 1),
+			BufferAttribute(10, 3, GL_FLOAT, false, stride, normalMatOffset, AttribUsage::User1, 1),
+			BufferAttribute(11, 3, GL_FLOAT, false, stride, normalMatOffset + sizeof(float) * 3, AttribUsage::User1, 1),
+			BufferAttribute(12, 3, GL_FLOAT, false, stride, normalMatOffset + sizeof(float) * 6, AttribUsage::User1, 1),
+			BufferAttribute(13, 1, GL_UNSIGNED_INT, false, stride, materialOffset, AttribUsage::User2, 1)
+		});
 	}
 
 	void TTN_Mesh::SetUVs(std::vector<glm::vec2>& uvs)
 	{
+		m_instancedVaoDirty = true;
 		//create a new vbo for the uvs
 		m_UVsVbo = TTN_VertexBuffer::Create();
 
@@ -60,6 +145,7 @@ namespace Titan {
 		{
 			//make the vbo pointer
 			m_ColVbo = TTN_VertexBuffer::Create();
+			m_instancedVaoDirty = true;
 
 			//copy the colors
 			m_Colors = colors;
@@ -77,14 +163,66 @@ namespace Titan {
 		return false;
 	}
 
+	//sets the uvs from memory, unpacking a copy for the cpu if they're half floats
+	void TTN_Mesh::SetUVs(const void* uvs, size_t count, bool halfFloats)
+	{
+		m_instancedVaoDirty = true;
+		m_UVsVbo = TTN_VertexBuffer::Create();
+		m_halfFloatUvs = halfFloats;
+		m_Uvs.resize(count);
+
+		if (halfFloats) {
+			const uint32_t* packed = (const uint32_t*)uvs;
+			for (size_t i = 0; i < count; i++)
+				m_Uvs[i] = glm::unpackHalf2x16(packed[i]);
+			if (count != 0) m_UVsVbo->LoadData(packed, count);
+		}
+		else {
+			if (count != 0) memcpy(m_Uvs.data(), uvs, count * sizeof(glm::vec2));
+			if (count != 0) m_UVsVbo->LoadData((const glm::vec2*)uvs, count);
+		}
+	}
+
+	//sets the indices of the triangles straight from memory
+	void TTN_Mesh::SetIndices(const uint32_t* indices, size_t count)
+	{
+		m_instancedVaoDirty = true;
+		m_Indices.assign(indices, indices + count);
+
+		if (count != 0) {
+			m_ibo = TTN_IndexBuffer::Create();
+			m_ibo->LoadData(indices, count);
+		}
+		else
+			m_ibo = nullptr;
+	}
+
+	//sets the indices of the triangles
+	void TTN_Mesh::SetIndices(std::vector<uint32_t>& indices)
+	{
+		m_instancedVaoDirty = true;
+		//copy the list of indices
+		m_Indices = indices;
+
+		//send them to an ibo, or get rid of it if there aren't any
+		if (indices.size() != 0) {
+			m_ibo = TTN_IndexBuffer::Create();
+			m_ibo->LoadData(indices.data(), indices.size());
+		}
+		else
+			m_ibo = nullptr;
+	}
+
 	//adds a list of vertices to the mesh object
 	void TTN_Mesh::AddVertices(std::vector<glm::vec3>& verts)
 	{
+		m_instancedVaoDirty = true;
 		//create a new vbo pointer for it
 		TTN_VertexBuffer::svbptr newVertVbo = TTN_VertexBuffer::Create();
 
 		//copy the list of verts
 		m_Vertices.push_back(verts);
+		GrowBounds(verts);
 
 		//add those verts to the new vbo
 		if (verts.size() != 0) {
@@ -95,9 +233,40 @@ namespace Titan {
 		m_vertVbos.push_back(newVertVbo);
 	}
 	
+	//grows the box around the mesh to fit a new frame, the sphere is left until all the frames are in
+	void TTN_Mesh::GrowBounds(const std::vector<glm::vec3>& frame)
+	{
+		for (const glm::vec3& vert : frame) {
+			m_boundsMin = m_hasBounds ? glm::min(m_boundsMin, vert) : vert;
+			m_boundsMax = m_hasBounds ? glm::max(m_boundsMax, vert) : vert;
+			m_hasBounds = true;
+		}
+		m_sphereDirty = true;
+	}
+
+	//works out the sphere around every frame of the mesh, if any frames were added since the last time
+	void TTN_Mesh::UpdateBoundingSphere() const
+	{
+		if (!m_sphereDirty)
+			return;
+
+		//the sphere is centered on the box, and reaches the furthest vertex (which is usually a lot tighter than the box's corners)
+		m_sphereCenter = (m_boundsMin + m_boundsMax) * 0.5f;
+		float furthest = 0.0f;
+		for (const std::vector<glm::vec3>& frame : m_Vertices) {
+			for (const glm::vec3& vert : frame) {
+				glm::vec3 offset = vert - m_sphereCenter;
+				furthest = glm::max(furthest, glm::dot(offset, offset));
+			}
+		}
+		m_sphereRadius = glm::sqrt(furthest);
+		m_sphereDirty = false;
+	}
+
 	//adds a list of normals to the mesh object
 	void TTN_Mesh::AddNormals(std::vector<glm::vec3>& norms)
 	{
+		m_instancedVaoDirty = true;
 		//create a new vbo pointer for it
 		TTN_VertexBuffer::svbptr newNormVbo = TTN_VertexBuffer::Create();
 
@@ -113,9 +282,75 @@ namespace Titan {
 		m_normVbos.push_back(newNormVbo);
 	}
 
+	//adds a frame with it's positions and normals interleaved, the vbo gets the data as is and the cpu gets an unpacked copy
+	void TTN_Mesh::AddInterleavedFrame(const void* data, size_t vertCount, bool packedNormals)
+	{
+		m_instancedVaoDirty = true;
+		FrameLayout layout;
+		layout.Stride = (GLsizei)(sizeof(glm::vec3) + (packedNormals ? sizeof(uint32_t) : sizeof(glm::vec3)));
+		layout.NormalOffset = sizeof(glm::vec3);
+		layout.PackedNormals = packedNormals;
+
+		//unpack the cpu copies
+		std::vector<glm::vec3> verts = std::vector<glm::vec3>(vertCount);
+		std::vector<glm::vec3> norms = std::vector<glm::vec3>(vertCount);
+		const char* vertex = (const char*)data;
+		for (size_t i = 0; i < vertCount; i++, vertex += layout.Stride) {
+			memcpy(&verts[i], vertex, sizeof(glm::vec3));
+			if (packedNormals) {
+				uint32_t packed;
+				memcpy(&packed, vertex + layout.NormalOffset, sizeof(uint32_t));
+				norms[i] = glm::vec3(glm::unpackSnorm3x10_1x2(packed));
+			}
+			else
+				memcpy(&norms[i], vertex + layout.NormalOffset, sizeof(glm::vec3));
+		}
+		GrowBounds(verts);
+		m_Vertices.push_back(std::move(verts));
+		m_Normals.push_back(std::move(norms));
+
+		//one vbo holds both, so it's used as both the frame's vertex and normal vbo
+		TTN_VertexBuffer::svbptr frameVbo = TTN_VertexBuffer::Create();
+		if (vertCount != 0)
+			frameVbo->LoadData(data, layout.Stride, vertCount);
+		m_vertVbos.push_back(frameVbo);
+		m_normVbos.push_back(frameVbo);
+
+		//frames added before this one keep the default layout
+		m_frameLayouts.resize(m_vertVbos.size() - 1);
+		m_frameLayouts.push_back(layout);
+	}
+
 	//gets the pointer to the meshes vao 
 	TTN_VertexArrayObject::svaptr TTN_Mesh::GetVAOPointer()
 	{
 		return m_vao;
 	}
+
+	//gets the pointer to the vao for instanced draws of the mesh
+	TTN_VertexArrayObject::svaptr TTN_Mesh::GetInstancedVAOPointer()
+	{
+		return m_instancedVao;
+	}
+
+	//gets how many bytes the mesh's buffers take up on the gpu
+	size_t TTN_Mesh::GetMemorySize() const
+	{
+		//interleaved frames have the same vbo in both lists, so each buffer is only counted once
+		std::vector<const TTN_IBuffer*> counted;
+		size_t size = 0;
+		auto count = [&](const TTN_IBuffer* buffer) {
+			if (buffer == nullptr || std::find(counted.begin(), counted.end(), buffer) != counted.end())
+				return;
+			counted.push_back(buffer);
+			size += buffer->GetTotalSize();
+		};
+
+		for (const TTN_VertexBuffer::svbptr& vbo : m_vertVbos) count(vbo.get());
+		for (const TTN_VertexBuffer::svbptr& vbo : m_normVbos) count(vbo.get());
+		count(m_UVsVbo.get());
+		count(m_ColVbo.get());
+		count(m_ibo.get());
+		return size;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,296 @@
+//Titan Engine, by Atlas X Games
+// MeshCache.cpp - source file for the class that bakes loaded meshes into binary files so they can be loaded again without parsing their source files
+
+//include the header
+#include "Titan/MeshCache.h"
+#include "Titan/Hash.h"
+#include "Titan/MappedFile.h"
+#include "Logging.h"
+//include glm's packing functions, for quantizing normals and uvs
+#include "GLM/gtc/packing.hpp"
+//import other required features
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace Titan {
+	namespace {
+		//the first 4 bytes of every baked mesh
+		const char c_magic[4] = { 'T', 'T', 'N', 'M' };
+		//the version of the format, baked meshes from other versions are rebaked
+		const uint32_t c_version = 1;
+
+		//flags for how a baked mesh's data is stored
+		const uint32_t c_packedNormals = 1u << 0;
+		const uint32_t c_halfFloatUvs = 1u << 1;
+
+		//the start of a baked mesh
+		struct BakedHeader {
+			char Magic[4];
+			uint32_t Version;
+			uint32_t Flags;
+			uint32_t NumOfSources;
+			uint32_t NumOfFrames;
+			uint32_t NumOfVerts;
+			uint32_t NumOfIndices;
+			uint32_t Padding;
+		};
+
+		//what a source file looked like when the mesh was baked, one follows the header for each source file
+		struct BakedSource {
+			uint64_t Size;
+			int64_t Timestamp;
+			uint64_t Hash;
+			uint64_t Padding;
+		};
+
+		//where each block of a baked mesh starts, and how big the whole file is
+		struct BakedLayout {
+			size_t IndicesOffset;
+			size_t UvsOffset;
+			size_t FramesOffset;
+			size_t VertexStride;
+			size_t FrameSize;
+			size_t TotalSize;
+		};
+
+		//rounds a size up to the next multiple of 16
+		inline size_t Align16(size_t size) {
+			return (size + 15) & ~(size_t)15;
+		}
+
+		//works out where everything in a baked mesh is from it's header
+		BakedLayout GetLayout(const BakedHeader& header) {
+			BakedLayout layout;
+			layout.IndicesOffset = Align16(sizeof(BakedHeader) + sizeof(BakedSource) * header.NumOfSources);
+			layout.UvsOffset = Align16(layout.IndicesOffset + sizeof(uint32_t) * header.NumOfIndices);
+			size_t uvSize = (header.Flags & c_halfFloatUvs) ? sizeof(uint32_t) : sizeof(glm::vec2);
+			layout.FramesOffset = Align16(layout.UvsOffset + uvSize * header.NumOfVerts);
+			layout.VertexStride = sizeof(glm::vec3) + ((header.Flags & c_packedNormals) ? sizeof(uint32_t) : sizeof(glm::vec3));
+			layout.FrameSize = Align16(layout.VertexStride * header.NumOfVerts);
+			layout.TotalSize = layout.FramesOffset + layout.FrameSize * header.NumOfFrames;
+			return layout;
+		}
+
+		//checks if a source file is the same as it was when the mesh was baked
+		//the size and timestamp are checked first, the contents are only hashed if the timestamp changed (like after a checkout)
+		//if the hash still matches, the new timestamp is put in baked and rehashed is set so it can be written back
+		bool SourceMatches(const std::string& fileName, BakedSource& baked, bool& rehashed) {
+			rehashed = false;
+			uint64_t size;
+			int64_t timestamp;
+			if (!TTN_Hash::GetFileInfo(fileName, size, timestamp) || size != baked.Size)
+				return false;
+			if (timestamp == baked.Timestamp)
+				return true;
+
+			uint64_t hash;
+			if (!TTN_Hash::HashFile(fileName, hash) || hash != baked.Hash)
+				return false;
+			baked.Timestamp = timestamp;
+			rehashed = true;
+			return true;
+		}
+
+		//writes updated sources over the ones in a baked mesh, returns false if the file couldn't be written
+		bool WriteSources(const std::string& fileName, const std::vector<std::pair<size_t, BakedSource>>& sources) {
+			std::fstream out = std::fstream(fileName, std::ios::binary | std::ios::in | std::ios::out);
+			if (!out)
+				return false;
+			for (const auto& source : sources) {
+				out.seekp((std::streamoff)(sizeof(BakedHeader) + sizeof(BakedSource) * source.first));
+				out.write((const char*)&source.second, sizeof(BakedSource));
+			}
+			return (bool)out;
+		}
+	}
+
+	//gets the path of the baked copy of the mesh made from these source files, named after the first file and a hash of all their paths
+	std::string TTN_MeshCache::GetCachePath(const std::vector<std::string>& sourceFiles)
+	{
+		uint64_t hash = TTN_Hash::FNVOffsetBasis;
+		for (const std::string& source : sourceFiles) {
+			hash = TTN_Hash::FNV1a(source.data(), source.size(), hash);
+			hash = TTN_Hash::FNV1a("\n", 1, hash);
+		}
+
+		char hashText[17];
+		snprintf(hashText, sizeof(hashText), "%016llx", (unsigned long long)hash);
+		std::string name = sourceFiles.empty() ? std::string("mesh") : std::filesystem::path(sourceFiles[0]).stem().string();
+		return (std::filesystem::path(s_directory) / (name + "_" + hashText + ".ttnmesh")).string();
+	}
+
+	//loads the baked copy of a mesh if it's still up to date
+	TTN_Mesh::smptr TTN_MeshCache::Load(const std::vector<std::string>& sourceFiles)
+	{
+		std::shared_ptr<TTN_MappedFile> file = Open(sourceFiles);
+		if (file == nullptr)
+			return nullptr;
+
+		return Upload(*file);
+	}
+
+	//maps the baked copy of a mesh if it's still up to date
+	std::shared_ptr<TTN_MappedFile> TTN_MeshCache::Open(const std::vector<std::string>& sourceFiles)
+	{
+		if (!s_enabled || sourceFiles.empty())
+			return nullptr;
+
+		std::string cachePath = GetCachePath(sourceFiles);
+		std::shared_ptr<TTN_MappedFile> file = std::make_shared<TTN_MappedFile>(cachePath);
+		if (!file->GetIsOpen() || file->GetSize() < sizeof(BakedHeader))
+			return nullptr;
+
+		//make sure it's a baked mesh this version can read, for the same number of files, and that it's all there
+		BakedHeader header;
+		memcpy(&header, file->GetData(), sizeof(BakedHeader));
+		if (memcmp(header.Magic, c_magic, sizeof(c_magic)) != 0 || header.Version != c_version || header.NumOfSources != sourceFiles.size()
+			|| header.NumOfFrames == 0)
+			return nullptr;
+		BakedLayout layout = GetLayout(header);
+		if (file->GetSize() != layout.TotalSize)
+			return nullptr;
+
+		//make sure none of the source files have changed
+		std::vector<std::pair<size_t, BakedSource>> rehashedSources;
+		for (size_t i = 0; i < sourceFiles.size(); i++) {
+			BakedSource source;
+			memcpy(&source, file->GetData() + sizeof(BakedHeader) + sizeof(BakedSource) * i, sizeof(BakedSource));
+			bool rehashed;
+			if (!SourceMatches(sourceFiles[i], source, rehashed))
+				return nullptr;
+			if (rehashed)
+				rehashedSources.push_back({ i, source });
+		}
+
+		//sources that only matched by their contents get their new timestamps saved, so the next load doesn't hash them again
+		//the mapping doesn't share writing, so it's let go of while the file is written and then mapped again
+		if (!rehashedSources.empty()) {
+			file.reset();
+			if (!WriteSources(cachePath, rehashedSources))
+				LOG_WARN("Mesh cache could not update the timestamps in {}", cachePath);
+			file = std::make_shared<TTN_MappedFile>(cachePath);
+			if (!file->GetIsOpen() || file->GetSize() != layout.TotalSize)
+				return nullptr;
+		}
+
+		return file;
+	}
+
+	//makes a mesh out of a baked copy that's already been checked by Open
+	TTN_Mesh::smptr TTN_MeshCache::Upload(const TTN_MappedFile& file)
+	{
+		BakedHeader header;
+		memcpy(&header, file.GetData(), sizeof(BakedHeader));
+		BakedLayout layout = GetLayout(header);
+
+		//everything's 16 byte aligned from the start of the mapping, so it can be uploaded without being copied out first
+		const char* data = file.GetData();
+		TTN_Mesh::smptr newMesh = TTN_Mesh::Create();
+		newMesh->SetIndices((const uint32_t*)(data + layout.IndicesOffset), header.NumOfIndices);
+		newMesh->SetUVs(data + layout.UvsOffset, header.NumOfVerts, (header.Flags & c_halfFloatUvs) != 0);
+		for (uint32_t frame = 0; frame < header.NumOfFrames; frame++)
+			newMesh->AddInterleavedFrame(data + layout.FramesOffset + layout.FrameSize * frame, header.NumOfVerts,
+				(header.Flags & c_packedNormals) != 0);
+		newMesh->UpdateBoundingSphere();
+
+		return newMesh;
+	}
+
+	//bakes a mesh made from these source files, the mesh's cpu copies are copied out so they can be baked the same way as loaded data
+	bool TTN_MeshCache::Save(const std::vector<std::string>& sourceFiles, const TTN_Mesh& mesh)
+	{
+		if (!s_enabled || sourceFiles.empty() || mesh.GetNumOfFrames() == 0)
+			return false;
+
+		TTN_MeshData data;
+		data.Indices = mesh.GetIndicesRef();
+		data.Uvs = mesh.GetUvsRef();
+		for (int frame = 0; frame < mesh.GetNumOfFrames(); frame++) {
+			data.Positions.push_back(mesh.GetFramePositions(frame));
+			data.Normals.push_back(mesh.GetFrameNormals(frame));
+		}
+
+		return Save(sourceFiles, data);
+	}
+
+	//bakes the data for a mesh made from these source files
+	bool TTN_MeshCache::Save(const std::vector<std::string>& sourceFiles, const TTN_MeshData& data)
+	{
+		if (!s_enabled || sourceFiles.empty() || data.Positions.empty())
+			return false;
+
+		BakedHeader header;
+		memcpy(header.Magic, c_magic, sizeof(c_magic));
+		header.Version = c_version;
+		header.Flags = s_quantized ? (c_packedNormals | c_halfFloatUvs) : 0;
+		header.NumOfSources = (uint32_t)sourceFiles.size();
+		header.NumOfFrames = (uint32_t)data.Positions.size();
+		header.NumOfVerts = (uint32_t)data.Positions[0].size();
+		header.NumOfIndices = (uint32_t)data.Indices.size();
+		header.Padding = 0;
+		BakedLayout layout = GetLayout(header);
+
+		//every frame (and the uvs) needs a value for each vertex
+		if (data.Normals.size() != data.Positions.size())
+			return false;
+		for (size_t frame = 0; frame < data.Positions.size(); frame++) {
+			if (data.Positions[frame].size() != header.NumOfVerts || data.Normals[frame].size() != header.NumOfVerts)
+				return false;
+		}
+		if (data.Uvs.size() != header.NumOfVerts)
+			return false;
+
+		//build the whole file in memory, then write it in one go
+		std::vector<char> bytes = std::vector<char>(layout.TotalSize, 0);
+		memcpy(bytes.data(), &header, sizeof(BakedHeader));
+
+		for (size_t i = 0; i < sourceFiles.size(); i++) {
+			BakedSource source = {};
+			if (!TTN_Hash::GetFileInfo(sourceFiles[i], source.Size, source.Timestamp) || !TTN_Hash::HashFile(sourceFiles[i], source.Hash))
+				return false;
+			memcpy(bytes.data() + sizeof(BakedHeader) + sizeof(BakedSource) * i, &source, sizeof(BakedSource));
+		}
+
+		if (header.NumOfIndices != 0)
+			memcpy(bytes.data() + layout.IndicesOffset, data.Indices.data(), sizeof(uint32_t) * header.NumOfIndices);
+
+		const std::vector<glm::vec2>& uvs = data.Uvs;
+		if (header.Flags & c_halfFloatUvs) {
+			uint32_t* packedUvs = (uint32_t*)(bytes.data() + layout.UvsOffset);
+			for (size_t i = 0; i < uvs.size(); i++)
+				packedUvs[i] = glm::packHalf2x16(uvs[i]);
+		}
+		else if (!uvs.empty())
+			memcpy(bytes.data() + layout.UvsOffset, uvs.data(), sizeof(glm::vec2) * uvs.size());
+
+		for (size_t frame = 0; frame < data.Positions.size(); frame++) {
+			const std::vector<glm::vec3>& positions = data.Positions[frame];
+			const std::vector<glm::vec3>& normals = data.Normals[frame];
+			char* vertex = bytes.data() + layout.FramesOffset + layout.FrameSize * frame;
+			for (size_t i = 0; i < positions.size(); i++, vertex += layout.VertexStride) {
+				memcpy(vertex, &positions[i], sizeof(glm::vec3));
+				if (header.Flags & c_packedNormals) {
+					uint32_t packed = glm::packSnorm3x10_1x2(glm::vec4(normals[i], 0.0f));
+					memcpy(vertex + sizeof(glm::vec3), &packed, sizeof(uint32_t));
+				}
+				else
+					memcpy(vertex + sizeof(glm::vec3), &normals[i], sizeof(glm::vec3));
+			}
+		}
+
+		//write it out, if it's cut short the size check in Load will throw it out
+		std::string path = GetCachePath(sourceFiles);
+		std::error_code error;
+		std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+		std::ofstream out = std::ofstream(path, std::ios::binary | std::ios::trunc);
+		if (!out) {
+			LOG_WARN("Mesh cache could not write {}", path);
+			return false;
+		}
+		out.write(bytes.data(), (std::streamsize)bytes.size());
+		return (bool)out;
+	}
+}
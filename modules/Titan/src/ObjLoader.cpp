@@ -1,289 +1,343 @@
 //Titan Engine, by Atlas X Games
-//ObjLoader.cpp - source file for the class that parses OBJ files into TTN_Models 
+//ObjLoader.cpp - source file for the class that parses OBJ files into TTN_Models
 
 //include the header
 #include "Titan/ObjLoader.h"
+#include "Titan/MappedFile.h"
+#include "Titan/MeshCache.h"
 //include other required features
 #include <string>
-#include <sstream>
-#include <fstream>
-#include <iostream>
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
 #include <algorithm>
 
 namespace Titan {
+	namespace {
+		//a corner of a triangle, with the 0 based indices of it's position, uv, and normal (-1 if the face didn't give one)
+		struct ObjCorner {
+			int Pos;
+			int Uv;
+			int Norm;
+		};
+
+		//the data read out of an obj file, before it's turned into a mesh
+		struct ObjData {
+			std::vector<glm::vec3> Positions;
+			std::vector<glm::vec2> Uvs;
+			std::vector<glm::vec3> Normals;
+			//3 corners for every triangle, polygons with more sides are split into fans of triangles
+			std::vector<ObjCorner> Corners;
+		};
+
+#pragma region Scanning
+		//skips over spaces and tabs (but not the end of the line)
+		inline const char* SkipSpaces(const char* p, const char* end) {
+			while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+				p++;
+			return p;
+		}
 
-	// Taken from https://stackoverflow.com/questions/216823/whats-the-best-way-to-trim-stdstring
-#pragma region String Trimming
-
-// trim from start (in place)
-	static inline void ltrim(std::string& s) {
-		s.erase(s.begin(), std::find_if(s.begin(), s.end(), [](int ch) {
-			return !std::isspace(ch);
-		}));
-	}
-
-	// trim from end (in place)
-	static inline void rtrim(std::string& s) {
-		s.erase(std::find_if(s.rbegin(), s.rend(), [](int ch) {
-			return !std::isspace(ch);
-		}).base(), s.end());
-	}
+		//skips to the start of the next line
+		inline const char* SkipLine(const char* p, const char* end) {
+			while (p < end && *p != '\n')
+				p++;
+			return (p < end) ? p + 1 : end;
+		}
 
-	// trim from both ends (in place)
-	static inline void trim(std::string& s) {
-		ltrim(s);
-		rtrim(s);
-	}
+		//reads a float, returns wheter or not there was one to read
+		inline bool ScanFloat(const char*& p, const char* end, float& value) {
+			p = SkipSpaces(p, end);
+			//from_chars doesn't take a leading +
+			if (p < end && *p == '+')
+				p++;
+			std::from_chars_result result = std::from_chars(p, end, value);
+			if (result.ec != std::errc())
+				return false;
+			p = result.ptr;
+			return true;
+		}
 
-#pragma endregion 
+		//reads an integer, returns wheter or not there was one to read
+		inline bool ScanInt(const char*& p, const char* end, int& value) {
+			std::from_chars_result result = std::from_chars(p, end, value);
+			if (result.ec != std::errc())
+				return false;
+			p = result.ptr;
+			return true;
+		}
 
-	TTN_Mesh::smptr TTN_ObjLoader::LoadFromFile(const std::string& fileName)
-	{
-		//Vectors for storing data parsed in 
-		std::vector<glm::vec3> vertexPos;
-		std::vector<glm::vec2> vertexUV; 
-		std::vector<glm::vec3> vertexNorms; 
-
-		std::vector<GLint> vertexPosIndices; 
-		std::vector<GLint> vertexUvsIndices;
-		std::vector<GLint> vertexNormIndices;
-
-		//Open the file
-		std::ifstream file;
-		file.open(fileName, std::ios::binary);
-
-		//if it fails to open, throw an error
-		if (!file) {
-			LOG_ERROR("Obj Loader failed to open file.");
-			throw std::runtime_error("Obj Loader failed to open file.");
+		//turns an obj index (1 based, or negative to count back from the last one) into a 0 based index, -1 if there wasn't one
+		inline int ResolveIndex(int index, size_t count) {
+			if (index > 0) return index - 1;
+			if (index < 0) return (int)count + index;
+			return -1;
 		}
+#pragma endregion
 
-		//get a string to represent each line of the file
-		std::string line;
+		//reads the positions, uvs, normals, and faces out of an obj file
+		void ParseObj(const std::string& fileName, ObjData& data) {
+			data.Positions.clear();
+			data.Uvs.clear();
+			data.Normals.clear();
+			data.Corners.clear();
 
-		//parse each line of the file
-		while (std::getline(file, line)) {
-			//trim the line so there isn't any white space
-			trim(line);
+			//map the file rather than reading it line by line
+			TTN_MappedFile file(fileName);
 
-			//check if the line is a comment
-			if (line.substr(0, 1) == "#") {
-				//if it is, there is no need to do anything with it
+			//if it fails to open, throw an error
+			if (!file.GetIsOpen()) {
+				LOG_ERROR("Obj Loader failed to open file {}", fileName);
+				throw std::runtime_error("Obj Loader failed to open file.");
 			}
-			//if it's not a a comment, check if it is an object
-			else if (line.substr(0, 1) == "o") {
 
+			const char* p = file.GetData();
+			const char* end = p + file.GetSize();
+
+			//parse each line of the file
+			while (p < end) {
+				p = SkipSpaces(p, end);
+				if (p + 1 >= end) break;
+
+				//check if it's a vertex
+				if (p[0] == 'v' && (p[1] == ' ' || p[1] == '\t')) {
+					glm::vec3 pos = glm::vec3(1.0f);
+					p++;
+					ScanFloat(p, end, pos.x);
+					ScanFloat(p, end, pos.y);
+					ScanFloat(p, end, pos.z);
+					data.Positions.push_back(pos);
+				}
+				//if not then check if it's a uv
+				else if (p[0] == 'v' && p[1] == 't') {
+					glm::vec2 uv = glm::vec2(1.0f);
+					p += 2;
+					ScanFloat(p, end, uv.x);
+					ScanFloat(p, end, uv.y);
+					data.Uvs.push_back(uv);
+				}
+				//if not then check if it's a normal
+				else if (p[0] == 'v' && p[1] == 'n') {
+					glm::vec3 norm = glm::vec3(1.0f);
+					p += 2;
+					ScanFloat(p, end, norm.x);
+					ScanFloat(p, end, norm.y);
+					ScanFloat(p, end, norm.z);
+					data.Normals.push_back(norm);
+				}
+				//if not then check if it's a face, in the form pos, pos/uv, pos//norm, or pos/uv/norm for each corner
+				else if (p[0] == 'f' && (p[1] == ' ' || p[1] == '\t')) {
+					p++;
+					ObjCorner first = { -1, -1, -1 }, previous = { -1, -1, -1 };
+					int numOfCorners = 0;
+					while (true) {
+						p = SkipSpaces(p, end);
+						int pos = 0, uv = 0, norm = 0;
+						if (!ScanInt(p, end, pos))
+							break;
+						if (p < end && *p == '/') {
+							p++;
+							if (p < end && *p != '/')
+								ScanInt(p, end, uv);
+							if (p < end && *p == '/') {
+								p++;
+								ScanInt(p, end, norm);
+							}
+						}
+
+						ObjCorner corner = { ResolveIndex(pos, data.Positions.size()), ResolveIndex(uv, data.Uvs.size()),
+							ResolveIndex(norm, data.Normals.size()) };
+
+						//every corner after the first 2 makes a new triangle with the first corner and the one before it
+						if (numOfCorners >= 2) {
+							data.Corners.push_back(first);
+							data.Corners.push_back(previous);
+							data.Corners.push_back(corner);
+						}
+						else if (numOfCorners == 0)
+							first = corner;
+						previous = corner;
+						numOfCorners++;
+					}
+				}
+				//if it's anything else (comments, objects, materials, etc.) we can just ignore it for now
+
+				p = SkipLine(p, end);
 			}
-			//if not, then check if it's a vertex
-			else if (line.substr(0, 2) == "v ") {
-				//grab the line passed the v
-				std::istringstream ss = std::istringstream(line.substr(2));
-				//add a new vertex position to the vector
-				vertexPos.push_back(glm::vec3(1.0f));
-				//copy the line into it 
-				ss >> vertexPos[vertexPos.size() - 1].x >> vertexPos[vertexPos.size() - 1].y >> vertexPos[vertexPos.size() - 1].z;
+
+			//make sure every face acutally points at data that exists
+			for (const ObjCorner& corner : data.Corners) {
+				if (corner.Pos < 0 || corner.Pos >= (int)data.Positions.size() || corner.Uv >= (int)data.Uvs.size() ||
+					corner.Norm >= (int)data.Normals.size()) {
+					LOG_ERROR("Obj Loader found a face with an index out of range in {}", fileName);
+					throw std::runtime_error("Obj Loader found a face with an index out of range.");
+				}
 			}
-			//if not then check if it's a uv
-			else if (line.substr(0, 2) == "vt") {
-				//grab the line past the vt
-				std::istringstream ss = std::istringstream(line.substr(2));
-				//add a new vertex uv to the vector 
-				vertexUV.push_back(glm::vec3(1.0f));
-				//copy the line into it
-				ss >> vertexUV[vertexUV.size() - 1].x >> vertexUV[vertexUV.size() - 1].y;
+		}
+
+		//hashes the indices of a corner in every frame, for finding the corners that can share a vertex
+		inline uint32_t HashCorner(const std::vector<ObjData>& frames, size_t index) {
+			uint32_t hash = 0;
+			for (const ObjData& frame : frames) {
+				const ObjCorner& corner = frame.Corners[index];
+				hash = (hash * 31u) ^ ((uint32_t)corner.Pos * 73856093u);
+				hash ^= (uint32_t)corner.Uv * 19349663u;
+				hash ^= (uint32_t)corner.Norm * 83492791u;
 			}
-			//if not then check if it's a normal
-			else if (line.substr(0, 2) == "vn") {
-				//grab the line passed the vn
-				std::istringstream ss = std::istringstream(line.substr(2));
-				//add a new vertex normal to the vector
-				vertexNorms.push_back(glm::vec3(1.0f));
-				//copy the line into it 
-				ss >> vertexNorms[vertexNorms.size() - 1].x >> vertexNorms[vertexNorms.size() - 1].y >> vertexNorms[vertexNorms.size() - 1].z;
+			return hash ^ (hash >> 15);
+		}
+
+		//checks if 2 corners use the same position, uv, and normal in every frame
+		inline bool SameCorner(const std::vector<ObjData>& frames, size_t a, size_t b) {
+			for (const ObjData& frame : frames) {
+				const ObjCorner& first = frame.Corners[a];
+				const ObjCorner& second = frame.Corners[b];
+				if (first.Pos != second.Pos || first.Uv != second.Uv || first.Norm != second.Norm)
+					return false;
 			}
-			//if not then check if it's a face index detail
-			else if (line.substr(0, 1) == "f") {
-				int counter = 0; //used to check which detail we're on (0=vertex index, 1=uv index, 2=normal index)
-				GLint temp; //used to temporarily store the index before pushing it into one of the vectors
-				std::istringstream ss = std::istringstream(line.substr(1));
-				//go through the line
-				while (ss >> temp) {
-					if (counter == 0) vertexPosIndices.push_back(temp);
-					else if (counter == 1) vertexUvsIndices.push_back(temp);
-					else if (counter == 2) vertexNormIndices.push_back(temp);
-
-					//check if the next character is a forward slash
-					if (ss.peek() == '/') {
-						//if it is, move to the next character, skipping over the slash
-						counter++;
-						ss.ignore(1, '/');
-					}
-					//if it's not, check if it's a space
-					else if (ss.peek() == ' ') {
-						//if it is, move to the next character, skipping over the space
-						counter++;
-						ss.ignore(1, ' ');
-					}
+			return true;
+		}
 
-					//if the counter goes above 2, reset it to zero so it takes another vertex position
-					if (counter > 2)
-						counter = 0;
+		//works out the mesh's indices, corners with the same position, uv, and normal share one vertex
+		//(for morph animations they have to match in every frame, as they can come apart in some frames but not others)
+		//firstCorners is filled with the first corner that used each vertex, which is where that vertex's data is taken from
+		void BuildIndices(const std::vector<ObjData>& frames, std::vector<uint32_t>& indices, std::vector<uint32_t>& firstCorners)
+		{
+			const size_t numOfCorners = frames[0].Corners.size();
+			indices.resize(numOfCorners);
+			firstCorners.clear();
+			firstCorners.reserve(numOfCorners / 2);
+
+			//open addressed hash table from corners to the vertices that have been made for them, kept at most half full
+			size_t tableSize = 16;
+			while (tableSize < numOfCorners * 2)
+				tableSize *= 2;
+			std::vector<uint32_t> table = std::vector<uint32_t>(tableSize, UINT32_MAX);
+			const size_t mask = tableSize - 1;
+
+			for (size_t i = 0; i < numOfCorners; i++) {
+				size_t slot = HashCorner(frames, i) & mask;
+
+				//look for a vertex that already has this position, uv, and normal
+				while (table[slot] != UINT32_MAX && !SameCorner(frames, firstCorners[table[slot]], i))
+					slot = (slot + 1) & mask;
+
+				//if there isn't one, make it
+				if (table[slot] == UINT32_MAX) {
+					table[slot] = (uint32_t)firstCorners.size();
+					firstCorners.push_back((uint32_t)i);
 				}
-					
+
+				indices[i] = table[slot];
 			}
-			//if it's anything else we can just ignore it for now
 		}
 
-		//now we have loaded in all the data, we can use it to construct a mesh 
-		//create a new vectors with all the positions, uvs, and normals (this is the lenght of the indices, as these are all the vertices needed to construct the faces, some of which
-		//may have the same values twice) 
-		std::vector <glm::vec3> meshVertPos; 
-		std::vector <glm::vec2> meshVertUvs;
-		std::vector <glm::vec3> meshVertNorms;
-		//make that those vector the lenght of the their indices vector equilavents
-		meshVertPos.resize(vertexPosIndices.size(), glm::vec3());
-		meshVertUvs.resize(vertexUvsIndices.size(), glm::vec2());
-		meshVertNorms.resize(vertexNormIndices.size(), glm::vec3());
-		
-		//copy the data from the first set of vectors into the new vectors based on the indices so that they can used by the mesh
-		for (int i = 0; i < meshVertPos.size(); i++) {
-			//copy the positions
-			meshVertPos[i] = vertexPos[vertexPosIndices[i] - 1]; 
-		}
-		for (int i = 0; i < meshVertUvs.size(); i++) {
-			//copy the uvs
-			meshVertUvs[i] = vertexUV[vertexUvsIndices[i] - 1];
-		}
-		for (int i = 0; i < meshVertNorms.size(); i++) {
-			//copy the normals
-			meshVertNorms[i] = vertexNorms[vertexNormIndices[i] - 1];
+		//copies the positions and normals of each vertex out of a frame's data, corners without a normal just get zeros
+		void GetFrameVertices(const ObjData& frame, const std::vector<uint32_t>& firstCorners, std::vector<glm::vec3>& positions,
+			std::vector<glm::vec3>& normals)
+		{
+			positions.resize(firstCorners.size());
+			normals.resize(firstCorners.size());
+			for (size_t i = 0; i < firstCorners.size(); i++) {
+				const ObjCorner& corner = frame.Corners[firstCorners[i]];
+				positions[i] = frame.Positions[corner.Pos];
+				normals[i] = (corner.Norm >= 0) ? frame.Normals[corner.Norm] : glm::vec3(0.0f);
+			}
 		}
 
-		//create and return the mesh from that data
-		TTN_Mesh::smptr newMesh = TTN_Mesh::Create();
-		newMesh->AddVertices(meshVertPos);
-		newMesh->AddNormals(meshVertNorms);
-		newMesh->SetUVs(meshVertUvs);
+		//copies the uvs of each vertex out of a frame's data, corners without a uv just get zeros
+		void GetFrameUvs(const ObjData& frame, const std::vector<uint32_t>& firstCorners, std::vector<glm::vec2>& uvs)
+		{
+			uvs.resize(firstCorners.size());
+			for (size_t i = 0; i < firstCorners.size(); i++) {
+				const ObjCorner& corner = frame.Corners[firstCorners[i]];
+				uvs[i] = (corner.Uv >= 0) ? frame.Uvs[corner.Uv] : glm::vec2(0.0f);
+			}
+		}
+	}
 
-		return newMesh;
+	//loads a mesh from an obj file, with an index buffer so shared vertices are only stored once
+	TTN_Mesh::smptr TTN_ObjLoader::LoadFromFile(const std::string& fileName)
+	{
+		return ReadFromFile(fileName)();
 	}
 
 	//loads a series of meshes for morph target animations, assumes the files are named with the convention: fileName_1, fileName_2, etc.
 	TTN_Mesh::smptr TTN_ObjLoader::LoadAnimatedMeshFromFiles(const std::string& fileName, int numOfFiles)
 	{
-		//start by loading the first mesh, this will handle the first set of vertices and normals along with the uvs
-		TTN_Mesh::smptr newMesh = LoadFromFile(fileName + "_1.obj");
-
-		//from there loop through the next couple of files, loading in vertices and normals and adding them to newMesh
-		for (int i = 2; i <= numOfFiles; i++) {
-			//Vectors for storing data parsed in 
-			std::vector<glm::vec3> vertexPos;
-			std::vector<glm::vec3> vertexNorms;
-			std::vector<GLint> vertexPosIndices;
-			std::vector<GLint> vertexNormIndices;
+		return ReadAnimatedMeshFromFiles(fileName, numOfFiles)();
+	}
 
-			//Open the file
-			std::ifstream file;
-			file.open(fileName + "_" + std::to_string(i) + ".obj", std::ios::binary);
+	//reads a mesh from an obj file without touching opengl
+	std::function<TTN_Mesh::smptr()> TTN_ObjLoader::ReadFromFile(const std::string& fileName)
+	{
+		//if it's been baked since the file last changed, it just has to be uploaded
+		std::shared_ptr<TTN_MappedFile> baked = TTN_MeshCache::Open({ fileName });
+		if (baked != nullptr)
+			return [baked]() { return TTN_MeshCache::Upload(*baked); };
 
-			//if it fails to open, throw an error
-			if (!file) {
-				LOG_ERROR("Obj Loader failed to open file.");
-				throw std::runtime_error("Obj Loader failed to open file.");
-			}
+		std::vector<ObjData> frames = std::vector<ObjData>(1);
+		ParseObj(fileName, frames[0]);
 
-			//get a string to represent each line of the file
-			std::string line;
+		//now we have loaded in all the data, we can use it to work out the mesh's data
+		std::vector<uint32_t> firstCorners;
+		std::shared_ptr<TTN_MeshData> data = std::make_shared<TTN_MeshData>();
+		BuildIndices(frames, data->Indices, firstCorners);
 
-			//parse each line of the file
-			while (std::getline(file, line)) {
-				//trim the line so there isn't any white space
-				trim(line);
+		data->Positions.resize(1);
+		data->Normals.resize(1);
+		GetFrameVertices(frames[0], firstCorners, data->Positions[0], data->Normals[0]);
+		GetFrameUvs(frames[0], firstCorners, data->Uvs);
 
-				//check if the line is a comment
-				if (line.substr(0, 1) == "#") {
-					//if it is, there is no need to do anything with it
-				}
-				//if it's not a a comment, check if it is an object
-				else if (line.substr(0, 1) == "o") {
+		//bake it so the next load can skip parsing
+		TTN_MeshCache::Save({ fileName }, *data);
 
-				}
-				//if not, then check if it's a vertex
-				else if (line.substr(0, 2) == "v ") {
-					//grab the line passed the v
-					std::istringstream ss = std::istringstream(line.substr(2));
-					//add a new vertex position to the vector
-					vertexPos.push_back(glm::vec3(1.0f));
-					//copy the line into it 
-					ss >> vertexPos[vertexPos.size() - 1].x >> vertexPos[vertexPos.size() - 1].y >> vertexPos[vertexPos.size() - 1].z;
-				}
-				//if not then check if it's a normal
-				else if (line.substr(0, 2) == "vn") {
-					//grab the line passed the vn
-					std::istringstream ss = std::istringstream(line.substr(2));
-					//add a new vertex normal to the vector
-					vertexNorms.push_back(glm::vec3(1.0f));
-					//copy the line into it 
-					ss >> vertexNorms[vertexNorms.size() - 1].x >> vertexNorms[vertexNorms.size() - 1].y >> vertexNorms[vertexNorms.size() - 1].z;
-				}
-				//if not then check if it's a face index detail
-				else if (line.substr(0, 1) == "f") {
-					int counter = 0; //used to check which detail we're on (0=vertex index, 1=uv index, 2=normal index)
-					GLint temp; //used to temporarily store the index before pushing it into one of the vectors
-					std::istringstream ss = std::istringstream(line.substr(1));
-					//go through the line
-					while (ss >> temp) {
-						if (counter == 0) vertexPosIndices.push_back(temp);
-						else if (counter == 2) vertexNormIndices.push_back(temp);
-
-						//check if the next character is a forward slash
-						if (ss.peek() == '/') {
-							//if it is, move to the next character, skipping over the slash
-							counter++;
-							ss.ignore(1, '/');
-						}
-						//if it's not, check if it's a space
-						else if (ss.peek() == ' ') {
-							//if it is, move to the next character, skipping over the space
-							counter++;
-							ss.ignore(1, ' ');
-						}
+		//and make the mesh from that data once it's on the right thread
+		return [data]() { return TTN_Mesh::Create(*data); };
+	}
 
-						//if the counter goes above 2, reset it to zero so it takes another vertex position
-						if (counter > 2)
-							counter = 0;
-					}
+	//reads a mesh with morph targets without touching opengl
+	std::function<TTN_Mesh::smptr()> TTN_ObjLoader::ReadAnimatedMeshFromFiles(const std::string& fileName, int numOfFiles)
+	{
+		std::vector<std::string> frameNames = std::vector<std::string>(std::max(numOfFiles, 1));
+		for (int i = 0; i < (int)frameNames.size(); i++)
+			frameNames[i] = fileName + "_" + std::to_string(i + 1) + ".obj";
+
+		//if the whole sequence has been baked since any of the files last changed, it just has to be uploaded
+		std::shared_ptr<TTN_MappedFile> baked = TTN_MeshCache::Open(frameNames);
+		if (baked != nullptr)
+			return [baked]() { return TTN_MeshCache::Upload(*baked); };
+
+		//read every frame first, as the vertices can only be shared between corners that match in all of them
+		std::vector<ObjData> frames = std::vector<ObjData>(frameNames.size());
+		for (int i = 0; i < (int)frames.size(); i++) {
+			const std::string& frameName = frameNames[i];
+			ParseObj(frameName, frames[i]);
+
+			//every frame has to have the same faces, so each vertex can be taken from the same corner in every frame
+			if (frames[i].Corners.size() != frames[0].Corners.size()) {
+				LOG_ERROR("Obj Loader found a different number of faces in {} than in the first frame", frameName);
+				throw std::runtime_error("Obj Loader found morph targets with different faces.");
+			}
+		}
 
-				}
-				//if it's anything else we can just ignore it for now
+		std::vector<uint32_t> firstCorners;
+		std::shared_ptr<TTN_MeshData> data = std::make_shared<TTN_MeshData>();
+		BuildIndices(frames, data->Indices, firstCorners);
 
-			}
+		//the first frame sets up the uvs every frame will use
+		GetFrameUvs(frames[0], firstCorners, data->Uvs);
 
-			//now we have loaded in all the data, we can use it to construct a mesh 
-			//create a new vectors with all the positions, uvs, and normals (this is the lenght of the indices, as these are all the vertices needed to construct the faces, some of which
-			//may have the same values twice) 
-			std::vector <glm::vec3> meshVertPos;
-			std::vector <glm::vec3> meshVertNorms;
-			//make that those vector the lenght of the their indices vector equilavents
-			meshVertPos.resize(vertexPosIndices.size(), glm::vec3());
-			meshVertNorms.resize(vertexNormIndices.size(), glm::vec3());
-
-			//copy the data from the first set of vectors into the new vectors based on the indices so that they can used by the mesh
-			for (int i = 0; i < meshVertPos.size(); i++) {
-				//copy the positions
-				meshVertPos[i] = vertexPos[vertexPosIndices[i] - 1];
-			}
-			for (int i = 0; i < meshVertNorms.size(); i++) {
-				//copy the normals
-				meshVertNorms[i] = vertexNorms[vertexNormIndices[i] - 1];
-			}
+		//then each frame just adds it's vertices and normals
+		data->Positions.resize(frames.size());
+		data->Normals.resize(frames.size());
+		for (size_t i = 0; i < frames.size(); i++)
+			GetFrameVertices(frames[i], firstCorners, data->Positions[i], data->Normals[i]);
 
-			//with the data all loaded in it need only be added to the mesh object
-			newMesh->AddVertices(meshVertPos);
-			newMesh->AddNormals(meshVertNorms);
-		}
+		//bake the whole sequence into one file
+		TTN_MeshCache::Save(frameNames, *data);
 
-		//at the end of the for loop all the animation files will be loaded into a single mesh object, so you can just return that mesh
-		return newMesh;
+		//at the end all the animation files will be in a single mesh's data, so the mesh can be made from that
+		return [data]() { return TTN_Mesh::Create(*data); };
 	}
-}
\ No newline at end of file
+}
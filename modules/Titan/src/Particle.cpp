@@ -1,7 +1,21 @@
 //Titan Engine, by Atlas X Games 
 // Partilce.cpp - source file for the class that represents a particle system
 #include "Titan/Particle.h"
+#include "Titan/ThreadPool.h"
+#include "Titan/Profiler.h"
+#include "Titan/ResourceCache.h"
 #include "GLM/gtx/transform.hpp"
+#include <cstddef>
+
+//use the simd kernels when the compiler can target sse2 (always the case on x64), avx is used on top of that if the build enables it
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TTN_PARTICLE_SSE
+#include <emmintrin.h>
+#endif
+#if defined(TTN_PARTICLE_SSE) && defined(__AVX__)
+#define TTN_PARTICLE_AVX
+#include <immintrin.h>
+#endif
 
 //code refernce: https://www.youtube.com/watch?v=GK0jHlv3e3w&t=515s
 
@@ -21,9 +35,18 @@ namespace Titan {
 
 		m_maxParticlesCount = 1000;
 		m_durationRemaining = m_duration;
-		m_activeParticleIndex = m_maxParticlesCount - 1;
+		m_backend = TTN_ParticleBackend::CPU;
+		m_numOfAliveParticles = 0;
+		m_recycleIndex = 0;
 		m_vao = TTN_VertexArrayObject::Create();
 
+		//the gpu backend isn't used
+		m_transformFeedbacks[0] = m_transformFeedbacks[1] = 0;
+		m_currentState = 0;
+		m_pendingEmits = 0;
+		m_spawnIndex = 0;
+		m_seed = 0;
+
 		//reverse memory space for all the particle data
 		Positions = new glm::vec3[m_maxParticlesCount];
 		StartColors = new glm::vec4[m_maxParticlesCount];
@@ -34,11 +57,7 @@ namespace Titan {
 		EndScales = new float[m_maxParticlesCount];
 		timeAlive = new float[m_maxParticlesCount];
 		lifeTimes = new float[m_maxParticlesCount];
-		Active = new bool[m_maxParticlesCount];
-
-		particle_pos = new glm::vec3[m_maxParticlesCount];
-		particle_col = new glm::vec4[m_maxParticlesCount];
-		particle_scale = new float[m_maxParticlesCount];
+		m_veloWeights = new float[m_maxParticlesCount];
 
 
 		//set up function pointers
@@ -52,29 +71,53 @@ namespace Titan {
 
 	//constructor that takes in data
 	TTN_ParticleSystem::TTN_ParticleSystem(size_t maxParticles, float emissionRate, TTN_ParticleTemplate particleTemplate,
-		float duration, bool loop)
-		: m_maxParticlesCount(maxParticles), m_emissionRate(emissionRate), m_particle(particleTemplate),
-		m_duration(duration), m_loop(loop)
+		float duration, bool loop, TTN_ParticleBackend backend)
+		: m_emissionRate(emissionRate), m_particle(particleTemplate), m_duration(duration), m_loop(loop), m_backend(backend),
+		m_maxParticlesCount(maxParticles)
 	{
-		//reverse memory space for all the particle data
-		Positions = new glm::vec3[m_maxParticlesCount];
-		StartColors = new glm::vec4[m_maxParticlesCount];
-		EndColors = new glm::vec4[m_maxParticlesCount];
-		StartVelocities = new glm::vec3[m_maxParticlesCount];
-		EndVelocities = new glm::vec3[m_maxParticlesCount];
-		StartScales = new float[m_maxParticlesCount];
-		EndScales = new float[m_maxParticlesCount];
-		timeAlive = new float[m_maxParticlesCount];
-		lifeTimes = new float[m_maxParticlesCount];
-		Active = new bool[m_maxParticlesCount];
+		//if the gpu backend was asked for but can't be used, fall back to the cpu
+		if (m_backend == TTN_ParticleBackend::GPU && (!GetGPUBackendSupported() || s_particleUpdateShader == nullptr)) {
+			LOG_WARN("GPU particles aren't supported, falling back to CPU particles");
+			m_backend = TTN_ParticleBackend::CPU;
+		}
 
-		particle_pos = new glm::vec3[m_maxParticlesCount];
-		particle_col = new glm::vec4[m_maxParticlesCount];
-		particle_scale = new float[m_maxParticlesCount];
+		//reverse memory space for all the particle data (the gpu backend keeps it all in it's state buffers instead)
+		if (m_backend == TTN_ParticleBackend::CPU) {
+			Positions = new glm::vec3[m_maxParticlesCount];
+			StartColors = new glm::vec4[m_maxParticlesCount];
+			EndColors = new glm::vec4[m_maxParticlesCount];
+			StartVelocities = new glm::vec3[m_maxParticlesCount];
+			EndVelocities = new glm::vec3[m_maxParticlesCount];
+			StartScales = new float[m_maxParticlesCount];
+			EndScales = new float[m_maxParticlesCount];
+			timeAlive = new float[m_maxParticlesCount];
+			lifeTimes = new float[m_maxParticlesCount];
+			m_veloWeights = new float[m_maxParticlesCount];
+		}
+		else {
+			Positions = nullptr;
+			StartColors = nullptr;
+			EndColors = nullptr;
+			StartVelocities = nullptr;
+			EndVelocities = nullptr;
+			StartScales = nullptr;
+			EndScales = nullptr;
+			timeAlive = nullptr;
+			lifeTimes = nullptr;
+			m_veloWeights = nullptr;
+		}
+
+		//setup the gpu backend's bookkeeping
+		m_transformFeedbacks[0] = m_transformFeedbacks[1] = 0;
+		m_currentState = 0;
+		m_pendingEmits = 0;
+		m_spawnIndex = 0;
+		m_seed = (int)TTN_Random::RandomFloat(0.0f, 16777215.0f);
 
 		//setup the rest of the data
 		m_durationRemaining = 0.0f;
-		m_activeParticleIndex = m_maxParticlesCount - 1;
+		m_numOfAliveParticles = 0;
+		m_recycleIndex = 0;
 		m_vao = TTN_VertexArrayObject::Create();
 		m_rotation = glm::vec3(0.0f);
 		m_emitterShape = TTN_ParticleEmitterShape::SPHERE;
@@ -89,10 +132,7 @@ namespace Titan {
 		readGraphScale = &defaultReadGraph;
 
 		SetUpRenderingStuff();
-		
-		VertexPosVBO->LoadData(m_particle._mesh->GetVertexPositions().data(), m_particle._mesh->GetVertexPositions().size());
-		VertexNormVBO->LoadData(m_particle._mesh->GetVertexNormals().data(), m_particle._mesh->GetVertexNormals().size());
-		VertexUVVBO->LoadData(m_particle._mesh->GetVertexUvs().data(), m_particle._mesh->GetVertexUvs().size());
+		LoadMeshData();
 	}
 
 	TTN_ParticleSystem::~TTN_ParticleSystem()
@@ -106,23 +146,40 @@ namespace Titan {
 		delete[] EndScales;
 		delete[] timeAlive;
 		delete[] lifeTimes;
-		delete[] Active;
+		delete[] m_veloWeights;
 
-		delete[] particle_col;
-		delete[] particle_pos;
-		delete[] particle_scale;
+		if (m_transformFeedbacks[0] != 0)
+			glDeleteTransformFeedbacks(2, m_transformFeedbacks);
 	}
 
 	//set up the shaders for the particle system
 	void TTN_ParticleSystem::InitParticleShader()
 	{
-		s_particleShaderProgram = TTN_Shader::Create();
-		s_particleShaderProgram->LoadShaderStageFromFile("shaders/ttn_particle_vert.glsl", GL_VERTEX_SHADER);
-		s_particleShaderProgram->LoadShaderStageFromFile("shaders/ttn_particle_frag.glsl", GL_FRAGMENT_SHADER);
-		s_particleShaderProgram->Link();
+		//the shaders and default texture come from the resource cache, so they're shared with anything else that loads the same files
+		s_particleShaderProgram = TTN_ResourceCache::GetShader("shaders/ttn_particle_vert.glsl", "shaders/ttn_particle_frag.glsl");
 
 		//init the default particle texture too
-		s_defaultWhiteTexture = TTN_Texture2D::LoadFromFile("textures/ttn_particle_default.png");
+		s_defaultWhiteTexture = TTN_ResourceCache::GetTexture2D("textures/ttn_particle_default.png");
+
+		//and the shaders for the gpu backend, if it can be used
+		if (GetGPUBackendSupported()) {
+			//the update shader only has a vertex stage, it's outputs are captured straight into the next state buffer
+			s_particleUpdateShader = TTN_Shader::Create();
+			s_particleUpdateShader->LoadShaderStageFromFile("shaders/ttn_particle_update_vert.glsl", GL_VERTEX_SHADER);
+			s_particleUpdateShader->SetTransformFeedbackVaryings({ "tfStartColor", "tfEndColor", "tfPosition", "tfTimeAlive",
+				"tfStartVelocity", "tfLifeTime", "tfEndVelocity", "tfStartScale", "tfEndScale" });
+			s_particleUpdateShader->Link();
+
+			s_particleGPUShaderProgram = TTN_ResourceCache::GetShader("shaders/ttn_particle_gpu_vert.glsl", "shaders/ttn_particle_frag.glsl");
+		}
+	}
+
+	//checks if the current opengl context supports the gpu particle backend
+	bool TTN_ParticleSystem::GetGPUBackendSupported()
+	{
+		//it needs transform feedback objects (gl 4.0) that can be made with direct state access (gl 4.5)
+		return glTransformFeedbackVaryings != nullptr && glCreateTransformFeedbacks != nullptr && glTransformFeedbackBufferBase != nullptr &&
+			glBindTransformFeedback != nullptr && glBeginTransformFeedback != nullptr && glEndTransformFeedback != nullptr;
 	}
 
 	//sets up the particle system as a cone
@@ -182,10 +239,7 @@ namespace Titan {
 	void TTN_ParticleSystem::SetParticleTemplate(TTN_ParticleTemplate particleTemplate)
 	{
 		m_particle = particleTemplate;
-
-		VertexPosVBO->LoadData(m_particle._mesh->GetVertexPositions().data(), m_particle._mesh->GetVertexPositions().size());
-		VertexNormVBO->LoadData(m_particle._mesh->GetVertexNormals().data(), m_particle._mesh->GetVertexNormals().size());
-		VertexUVVBO->LoadData(m_particle._mesh->GetVertexUvs().data(), m_particle._mesh->GetVertexUvs().size());
+		LoadMeshData();
 	}
 
 	//set the rate at which particles are emitted (particles/second)
@@ -249,30 +303,148 @@ namespace Titan {
 			m_durationRemaining = m_duration;
 		}
 
-		//iterate over all the particles
-		for (size_t i = 0; i < m_maxParticlesCount; i++) {
-			//if it's not alive just skip it
-			if (!Active[i])
-				continue;
-			//if it's gone through it's lifetime, deactive it and skip to the next one
-			if (timeAlive[i] >= lifeTimes[i]) {
-				Active[i] = false;
-				continue;
-			}
+		//the gpu backend does all of the per-particle work in the update shader
+		if (m_backend == TTN_ParticleBackend::GPU) {
+			UpdateGPU(deltaTime);
+			return;
+		}
 
-			//update how long the particle has been alive
+		//get rid of the particles that have gone through their lifetime
+		for (size_t i = 0; i < m_numOfAliveParticles;) {
+			//killing a particle moves the last one into it's place, so only move on if it's still alive
+			if (timeAlive[i] >= lifeTimes[i])
+				KillParticle(i);
+			else
+				i++;
+		}
+
+		//update the rest, splitting them across the thread pool if there's enough of them
+		if (m_numOfAliveParticles >= s_multithreadThreshold) {
+			TTN_ThreadPool::GetShared().ParallelFor(m_numOfAliveParticles, 1024, [this, deltaTime](size_t begin, size_t end) {
+				UpdateParticles(begin, end, deltaTime);
+			});
+		}
+		else
+			UpdateParticles(0, m_numOfAliveParticles, deltaTime);
+	}
+
+	//ages and moves the alive particles in the range [begin, end)
+	void TTN_ParticleSystem::UpdateParticles(size_t begin, size_t end, float deltaTime)
+	{
+		size_t i = begin;
+
+		//update how long each particle has been alive, and get a t value for interpolation
+#if defined(TTN_PARTICLE_SSE)
+		__m128 dt4 = _mm_set1_ps(deltaTime);
+		__m128 zero4 = _mm_setzero_ps();
+		__m128 one4 = _mm_set1_ps(1.0f);
+		for (; i + 4 <= end; i += 4) {
+			__m128 alive = _mm_add_ps(_mm_loadu_ps(timeAlive + i), dt4);
+			_mm_storeu_ps(timeAlive + i, alive);
+			__m128 t = _mm_div_ps(alive, _mm_loadu_ps(lifeTimes + i));
+			_mm_storeu_ps(m_veloWeights + i, _mm_min_ps(_mm_max_ps(t, zero4), one4));
+		}
+#endif
+		for (; i < end; i++) {
 			timeAlive[i] += deltaTime;
+			m_veloWeights[i] = std::clamp(timeAlive[i] / lifeTimes[i], 0.0f, 1.0f);
+		}
 
-			//get a t value for interpolation 
-			float t = std::clamp(timeAlive[i] / lifeTimes[i], 0.0f, 1.0f);
-			//update the position of the particlce based on the interpolation of the positions
-			Positions[i] += glm::mix(StartVelocities[i], EndVelocities[i], readGraphVelo(t)) * deltaTime;
+		//run the t values through the readgraph (the default one just gives back t, so it can be skipped)
+		if (readGraphVelo != &defaultReadGraph) {
+			for (i = begin; i < end; i++)
+				m_veloWeights[i] = readGraphVelo(m_veloWeights[i]);
+		}
+
+		//update the position of the particles based on the interpolation of the velocities
+		//the positions and velocities are tightly packed vec3s, so they're treated as flat arrays of floats, 4 particles being 3 simd registers
+		float* pos = &Positions[0].x;
+		const float* startVelo = &StartVelocities[0].x;
+		const float* endVelo = &EndVelocities[0].x;
+		i = begin;
+#if defined(TTN_PARTICLE_AVX)
+		__m256 dt8 = _mm256_set1_ps(deltaTime);
+		for (; i + 8 <= end; i += 8) {
+			//spread the 8 weights out so each one lines up with the x, y, and z of it's particle
+			__m256 w = _mm256_loadu_ps(m_veloWeights + i);
+			__m128 lo = _mm256_castps256_ps128(w);
+			__m128 hi = _mm256_extractf128_ps(w, 1);
+			__m256 weights[3] = {
+				_mm256_insertf128_ps(_mm256_castps128_ps256(_mm_shuffle_ps(lo, lo, _MM_SHUFFLE(1, 0, 0, 0))), _mm_shuffle_ps(lo, lo, _MM_SHUFFLE(2, 2, 1, 1)), 1),
+				_mm256_insertf128_ps(_mm256_castps128_ps256(_mm_shuffle_ps(lo, lo, _MM_SHUFFLE(3, 3, 3, 2))), _mm_shuffle_ps(hi, hi, _MM_SHUFFLE(1, 0, 0, 0)), 1),
+				_mm256_insertf128_ps(_mm256_castps128_ps256(_mm_shuffle_ps(hi, hi, _MM_SHUFFLE(2, 2, 1, 1))), _mm_shuffle_ps(hi, hi, _MM_SHUFFLE(3, 3, 3, 2)), 1)
+			};
+
+			for (int j = 0; j < 3; j++) {
+				size_t offset = i * 3 + j * 8;
+				__m256 start = _mm256_loadu_ps(startVelo + offset);
+				__m256 velo = _mm256_add_ps(start, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(endVelo + offset), start), weights[j]));
+				_mm256_storeu_ps(pos + offset, _mm256_add_ps(_mm256_loadu_ps(pos + offset), _mm256_mul_ps(velo, dt8)));
+			}
 		}
+#endif
+#if defined(TTN_PARTICLE_SSE)
+		for (; i + 4 <= end; i += 4) {
+			//spread the 4 weights out so each one lines up with the x, y, and z of it's particle
+			__m128 w = _mm_loadu_ps(m_veloWeights + i);
+			__m128 weights[3] = {
+				_mm_shuffle_ps(w, w, _MM_SHUFFLE(1, 0, 0, 0)),
+				_mm_shuffle_ps(w, w, _MM_SHUFFLE(2, 2, 1, 1)),
+				_mm_shuffle_ps(w, w, _MM_SHUFFLE(3, 3, 3, 2))
+			};
+
+			for (int j = 0; j < 3; j++) {
+				size_t offset = i * 3 + j * 4;
+				__m128 start = _mm_loadu_ps(startVelo + offset);
+				__m128 velo = _mm_add_ps(start, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(endVelo + offset), start), weights[j]));
+				_mm_storeu_ps(pos + offset, _mm_add_ps(_mm_loadu_ps(pos + offset), _mm_mul_ps(velo, dt4)));
+			}
+		}
+#endif
+		for (; i < end; i++)
+			Positions[i] += glm::mix(StartVelocities[i], EndVelocities[i], m_veloWeights[i]) * deltaTime;
+	}
+
+	//kills a particle by moving the last alive particle into it's place, so the alive particles stay packed
+	void TTN_ParticleSystem::KillParticle(size_t index)
+	{
+		m_numOfAliveParticles--;
+		size_t last = m_numOfAliveParticles;
+		if (index == last)
+			return;
+
+		Positions[index] = Positions[last];
+		StartColors[index] = StartColors[last];
+		EndColors[index] = EndColors[last];
+		StartVelocities[index] = StartVelocities[last];
+		EndVelocities[index] = EndVelocities[last];
+		StartScales[index] = StartScales[last];
+		EndScales[index] = EndScales[last];
+		timeAlive[index] = timeAlive[last];
+		lifeTimes[index] = lifeTimes[last];
+	}
+
+	//gets the index a newly emitted particle should go in
+	size_t TTN_ParticleSystem::GetEmitIndex()
+	{
+		//if there's room, add it to the end of the alive particles
+		if (m_numOfAliveParticles < m_maxParticlesCount)
+			return m_numOfAliveParticles++;
+
+		//otherwise replace one of the existing particles, going through them in order
+		size_t index = m_recycleIndex;
+		m_recycleIndex = (m_recycleIndex + 1) % m_maxParticlesCount;
+		return index;
 	}
 
 	//renders all the active particles
 	void TTN_ParticleSystem::Render(glm::vec3 ParentGlobalPos, glm::mat4 view, glm::mat4 projection)
 	{
+		if (m_backend == TTN_ParticleBackend::GPU) {
+			RenderGPU(ParentGlobalPos, view, projection);
+			return;
+		}
+
 		//bind the shader
 		s_particleShaderProgram->Bind();
 
@@ -291,18 +463,16 @@ namespace Titan {
 			s_defaultWhiteTexture->Bind(0);
 		}
 
-		//create some temp vectors to store the data about the particles that are acutally going to be rendered
-		//std::vector<glm::mat4> particle_mvp = std::vector<glm::mat4>();
-		//std::vector<glm::mat4> particle_model = std::vector<glm::mat4>();
-		//std::vector<glm::vec4> particle_col = std::vector<glm::vec4>();
-		//std::vector<glm::mat3> particle_normalMat = std::vector<glm::mat3>();
-		size_t numOfActiveParticles = 0;
-		//go through all the particles and set up their data for rendering
-		for (size_t i = 0; i < m_maxParticlesCount; i++) {
-			//if the particle isn't active, just skip to the next one
-			if (!Active[i])
-				continue;
+		size_t numOfActiveParticles = m_numOfAliveParticles;
+		//if there aren't any particles to acutally be rendered, just exit the function
+		if (numOfActiveParticles == 0)
+			return;
+
+		//get the memory for this frame's instance data, the particles are written straight into it
+		TTN_ParticleInstanceData* instances = (TTN_ParticleInstanceData*)m_instanceBuffer->BeginWrite(numOfActiveParticles);
 
+		//go through all the alive particles and set up their data for rendering
+		for (size_t i = 0; i < numOfActiveParticles; i++) {
 			//get a t value for interpolation 
 			float t = std::clamp(timeAlive[i] / lifeTimes[i], 0.0f, 1.0f);
 
@@ -313,32 +483,33 @@ namespace Titan {
 			//get the global position of the particle
 			glm::vec3 temp_pos = ParentGlobalPos + Positions[i];
 
-			
-			//save the color
-			particle_col[numOfActiveParticles] = temp_col;
-			particle_pos[numOfActiveParticles] = temp_pos;
-			particle_scale[numOfActiveParticles] = temp_scale;
-
-
-			numOfActiveParticles++;
+			//save it all, as one write since mapped memory is slow to read back from
+			TTN_ParticleInstanceData instance;
+			instance.Color = temp_col;
+			instance.Position = temp_pos;
+			instance.Scale = temp_scale;
+			instances[i] = instance;
 		}
-		//if there are particles to acutally be rendered, render them, if not just exit the function
-		if (numOfActiveParticles > 0) {
-			//manually set up the buffers and vao since titan doesn't currently have the infastructure to render instanced stuff automatically
-
-			ColorInstanceBuffer->LoadData(particle_col, numOfActiveParticles);
-
-			PositionInstanceBuffer->LoadData(particle_pos, numOfActiveParticles);
+		m_instanceBuffer->EndWrite();
+		TTN_Profiler::AddCount(TTN_ProfileCounter::PARTICLE_BYTES_UPLOADED, numOfActiveParticles * sizeof(TTN_ParticleInstanceData));
 
-			ScaleInstanceBuffer->LoadData(particle_scale, numOfActiveParticles);
-
-			m_vao->RenderInstanced(numOfActiveParticles, m_particle._mesh->GetVertexPositions().size());
-		}
+		//render them, reading from the part of the instance buffer that was just written
+		m_vao->RenderInstanced(numOfActiveParticles, m_particle._mesh->GetVertexPositions().size(), m_instanceBuffer->GetBaseElement());
+		m_instanceBuffer->EndFrame();
 	}
 
 	//emits a single particle
 	void TTN_ParticleSystem::Emit()
 	{
+		//the gpu backend sets the particle up during the next update
+		if (m_backend == TTN_ParticleBackend::GPU) {
+			m_pendingEmits++;
+			return;
+		}
+
+		//get the slot the new particle will go in
+		size_t index = GetEmitIndex();
+
 		//setup the new particle's data
 		//position
 		{
@@ -347,10 +518,10 @@ namespace Titan {
 				float y = TTN_Random::RandomFloat(-(m_EmitterScale.y / 2), m_EmitterScale.y / 2);
 				float z = TTN_Random::RandomFloat(-(m_EmitterScale.z / 2), m_EmitterScale.z / 2);
 
-				Positions[m_activeParticleIndex] = glm::vec3(x, y, z);
+				Positions[index] = glm::vec3(x, y, z);
 			}
 			else {
-				Positions[m_activeParticleIndex] = glm::vec3(0.0f);
+				Positions[index] = glm::vec3(0.0f);
 			}
 		}
 
@@ -372,8 +543,8 @@ namespace Titan {
 			a = TTN_Random::RandomFloat(m_particle._EndColor.a, m_particle._EndColor2.a);
 			EndColor = glm::vec4(r, g, b, a);
 
-			StartColors[m_activeParticleIndex] = Startcolor;
-			EndColors[m_activeParticleIndex] = EndColor;
+			StartColors[index] = Startcolor;
+			EndColors[index] = EndColor;
 		}
 
 		//velocities
@@ -434,30 +605,30 @@ namespace Titan {
 			}
 
 
-			StartVelocities[m_activeParticleIndex] = Dir * TTN_Random::RandomFloat(m_particle._startSpeed, m_particle._startSpeed2);
-			EndVelocities[m_activeParticleIndex] = Dir * TTN_Random::RandomFloat(m_particle._endSpeed, m_particle._endSpeed2);
+			StartVelocities[index] = Dir * TTN_Random::RandomFloat(m_particle._startSpeed, m_particle._startSpeed2);
+			EndVelocities[index] = Dir * TTN_Random::RandomFloat(m_particle._endSpeed, m_particle._endSpeed2);
 		}
 
 		//scales
 		{
-			StartScales[m_activeParticleIndex] = TTN_Random::RandomFloat(m_particle._StartSize, m_particle._StartSize2);
-			EndScales[m_activeParticleIndex] = TTN_Random::RandomFloat(m_particle._EndSize, m_particle._EndSize2);
+			StartScales[index] = TTN_Random::RandomFloat(m_particle._StartSize, m_particle._StartSize2);
+			EndScales[index] = TTN_Random::RandomFloat(m_particle._EndSize, m_particle._EndSize2);
 		}
 
 		//how long the particle has been alive and how long it should live (used to caculate t values)
-		timeAlive[m_activeParticleIndex] = 0.0f;
-		lifeTimes[m_activeParticleIndex] = TTN_Random::RandomFloat(m_particle._lifeTime, m_particle._lifeTime2);
-
-		//set the particle to be alive
-		Active[m_activeParticleIndex] = true;
+		timeAlive[index] = 0.0f;
+		lifeTimes[index] = TTN_Random::RandomFloat(m_particle._lifeTime, m_particle._lifeTime2);
 
-		//and move the index back so the next emit will use the next index
-		m_activeParticleIndex = (m_activeParticleIndex - 1) % m_maxParticlesCount;
 	}
 
 	//emits a bunch of particles all at once
 	void TTN_ParticleSystem::Burst(size_t numOfParticles)
 	{
+		if (m_backend == TTN_ParticleBackend::GPU) {
+			m_pendingEmits += numOfParticles;
+			return;
+		}
+
 		for (size_t i = 0; i < numOfParticles; i++) {
 			Emit();
 		}
@@ -470,9 +641,6 @@ namespace Titan {
 		VertexPosVBO = TTN_VertexBuffer::Create();
 		VertexNormVBO = TTN_VertexBuffer::Create();
 		VertexUVVBO = TTN_VertexBuffer::Create();
-		ColorInstanceBuffer = TTN_VertexBuffer::Create();
-		PositionInstanceBuffer = TTN_VertexBuffer::Create();
-		ScaleInstanceBuffer = TTN_VertexBuffer::Create();
 		//create the vao
 		m_vao = TTN_VertexArrayObject::Create();
 
@@ -481,9 +649,179 @@ namespace Titan {
 		m_vao->AddVertexBuffer(VertexNormVBO, { BufferAttribute(1, 3, GL_FLOAT, false, sizeof(float) * 3, 0, AttribUsage::Normal) });
 		m_vao->AddVertexBuffer(VertexUVVBO, { BufferAttribute(2, 2, GL_FLOAT, false, sizeof(float) * 2, 0, AttribUsage::Texture) });
 
-		//load the instanced vertex buffers
-		m_vao->AddVertexBuffer(ColorInstanceBuffer, { BufferAttribute(3, 4, GL_FLOAT, false, sizeof(float) * 4, 0, AttribUsage::Color, 1) });
-		m_vao->AddVertexBuffer(PositionInstanceBuffer, { BufferAttribute(4, 3, GL_FLOAT, false, sizeof(float) * 3, 0, AttribUsage::User0, 1) });
-		m_vao->AddVertexBuffer(ScaleInstanceBuffer, { BufferAttribute(5, 1, GL_FLOAT, false, sizeof(float), 0, AttribUsage::User1, 1) });
+		//the gpu backend reads it's instance data from it's state buffers instead
+		if (m_backend == TTN_ParticleBackend::GPU) {
+			SetUpGPUStuff();
+			return;
+		}
+
+		//load the interleaved instance buffer
+		m_instanceBuffer = TTN_StreamBuffer::Create(sizeof(TTN_ParticleInstanceData), m_maxParticlesCount);
+		m_vao->AddVertexBuffer(m_instanceBuffer, {
+			BufferAttribute(3, 4, GL_FLOAT, false, sizeof(TTN_ParticleInstanceData), offsetof(TTN_ParticleInstanceData, Color), AttribUsage::Color, 1),
+			BufferAttribute(4, 3, GL_FLOAT, false, sizeof(TTN_ParticleInstanceData), offsetof(TTN_ParticleInstanceData, Position), AttribUsage::User0, 1),
+			BufferAttribute(5, 1, GL_FLOAT, false, sizeof(TTN_ParticleInstanceData), offsetof(TTN_ParticleInstanceData, Scale), AttribUsage::User1, 1)
+		});
+	}
+
+	//loads the particle template's mesh into the vbos, and points the vaos at it's indices (if it has them)
+	void TTN_ParticleSystem::LoadMeshData()
+	{
+		VertexPosVBO->LoadData(m_particle._mesh->GetVertexPositions().data(), m_particle._mesh->GetVertexPositions().size());
+		VertexNormVBO->LoadData(m_particle._mesh->GetVertexNormals().data(), m_particle._mesh->GetVertexNormals().size());
+		VertexUVVBO->LoadData(m_particle._mesh->GetVertexUvs().data(), m_particle._mesh->GetVertexUvs().size());
+
+		m_vao->SetIndexBuffer(m_particle._mesh->GetIndexBuffer());
+		if (m_backend == TTN_ParticleBackend::GPU) {
+			m_renderVaos[0]->SetIndexBuffer(m_particle._mesh->GetIndexBuffer());
+			m_renderVaos[1]->SetIndexBuffer(m_particle._mesh->GetIndexBuffer());
+		}
+	}
+
+	//sets up the buffers, vaos, and transform feedback objects for the gpu backend
+	void TTN_ParticleSystem::SetUpGPUStuff()
+	{
+		//every particle starts out dead (having been alive for it's whole lifetime)
+		TTN_GPUParticle deadParticle;
+		deadParticle.StartColor = glm::vec4(0.0f);
+		deadParticle.EndColor = glm::vec4(0.0f);
+		deadParticle.Position = glm::vec3(0.0f);
+		deadParticle.TimeAlive = 0.0f;
+		deadParticle.StartVelocity = glm::vec3(0.0f);
+		deadParticle.LifeTime = 0.0f;
+		deadParticle.EndVelocity = glm::vec3(0.0f);
+		deadParticle.StartScale = 0.0f;
+		deadParticle.EndScale = 0.0f;
+		std::vector<TTN_GPUParticle> initialState = std::vector<TTN_GPUParticle>(m_maxParticlesCount, deadParticle);
+
+		glCreateTransformFeedbacks(2, m_transformFeedbacks);
+
+		const GLsizei stride = sizeof(TTN_GPUParticle);
+		for (int i = 0; i < 2; i++) {
+			//make the state buffer, it's only ever written and read by the gpu
+			m_stateBuffers[i] = TTN_VertexBuffer::Create(GL_DYNAMIC_COPY);
+			m_stateBuffers[i]->LoadData(initialState.data(), initialState.size());
+			//and point one of the transform feedback objects at it
+			glTransformFeedbackBufferBase(m_transformFeedbacks[i], 0, m_stateBuffers[i]->GetHandle());
+
+			//the vao the update shader reads the state from, one vertex per particle
+			m_updateVaos[i] = TTN_VertexArrayObject::Create();
+			m_updateVaos[i]->AddVertexBuffer(m_stateBuffers[i], {
+				BufferAttribute(0, 4, GL_FLOAT, false, stride, offsetof(TTN_GPUParticle, StartColor), AttribUsage::Color),
+				BufferAttribute(1, 4, GL_FLOAT, false, stride, offsetof(TTN_GPUParticle, EndColor), AttribUsage::Color1),
+				BufferAttribute(2, 3, GL_FLOAT, false, stride, offsetof(TTN_GPUParticle, Position), AttribUsage::Position),
+				BufferAttribute(3, 1, GL_FLOAT, false, stride, offsetof(TTN_GPUParticle, TimeAlive), AttribUsage::User0),
+				BufferAttribute(4, 3, GL_FLOAT, false, stride, offsetof(TTN_GPUParticle, StartVelocity), AttribUsage::User1),
+				BufferAttribute(5, 1, GL_FLOAT, false, stride, offsetof(TTN_GPUParticle, LifeTime), AttribUsage::User2),
+				BufferAttribute(6, 3, GL_FLOAT, false, stride, offsetof(TTN_GPUParticle, EndVelocity), AttribUsage::User3),
+				BufferAttribute(7, 1, GL_FLOAT, false, stride, offsetof(TTN_GPUParticle, StartScale)),
+				BufferAttribute(8, 1, GL_FLOAT, false, stride, offsetof(TTN_GPUParticle, EndScale))
+			});
+
+			//and the vao that draws the particle mesh once for every particle in the state
+			m_renderVaos[i] = TTN_VertexArrayObject::Create();
+			m_renderVaos[i]->AddVertexBuffer(VertexPosVBO, { BufferAttribute(0, 3, GL_FLOAT, false, sizeof(float) * 3, 0, AttribUsage::Position) });
+			m_renderVaos[i]->AddVertexBuffer(VertexNormVBO, { BufferAttribute(1, 3, GL_FLOAT, false, sizeof(float) * 3, 0, AttribUsage::Normal) });
+			m_renderVaos[i]->AddVertexBuffer(VertexUVVBO, { BufferAttribute(2, 2, GL_FLOAT, false, sizeof(float) * 2, 0, AttribUsage::Texture) });
+			m_renderVaos[i]->AddVertexBuffer(m_stateBuffers[i], {
+				BufferAttribute(3, 4, GL_FLOAT, false, stride, offsetof(TTN_GPUParticle, StartColor), AttribUsage::Color, 1),
+				BufferAttribute(4, 4, GL_FLOAT, false, stride, offsetof(TTN_GPUParticle, EndColor), AttribUsage::Color1, 1),
+				BufferAttribute(5, 3, GL_FLOAT, false, stride, offsetof(TTN_GPUParticle, Position), AttribUsage::User0, 1),
+				BufferAttribute(6, 1, GL_FLOAT, false, stride, offsetof(TTN_GPUParticle, TimeAlive), AttribUsage::User1, 1),
+				BufferAttribute(7, 1, GL_FLOAT, false, stride, offsetof(TTN_GPUParticle, LifeTime), AttribUsage::User2, 1),
+				BufferAttribute(8, 1, GL_FLOAT, false, stride, offsetof(TTN_GPUParticle, StartScale), AttribUsage::User3, 1),
+				BufferAttribute(9, 1, GL_FLOAT, false, stride, offsetof(TTN_GPUParticle, EndScale), AttribUsage::Unknown, 1)
+			});
+		}
+	}
+
+	//emits the pending particles and moves all of them forward on the gpu
+	void TTN_ParticleSystem::UpdateGPU(float deltaTime)
+	{
+		//the emitted particles replace the ones in the buffer in order, so when it's full the oldest particles get replaced first
+		size_t spawnCount = std::min(m_pendingEmits, m_maxParticlesCount);
+		m_pendingEmits = 0;
+
+		//keep track of roughly how many particles are alive, without having to read anything back from the gpu
+		if (spawnCount > 0)
+			m_emittedBatches.push_back(std::make_pair(std::max(m_particle._lifeTime, m_particle._lifeTime2), spawnCount));
+		size_t aliveEstimate = 0;
+		for (size_t i = 0; i < m_emittedBatches.size();) {
+			m_emittedBatches[i].first -= deltaTime;
+			if (m_emittedBatches[i].first <= 0.0f) {
+				m_emittedBatches.erase(m_emittedBatches.begin() + i);
+				continue;
+			}
+			aliveEstimate += m_emittedBatches[i].second;
+			i++;
+		}
+		m_numOfAliveParticles = std::min(aliveEstimate, m_maxParticlesCount);
+
+		//set the frame's uniforms
+		s_particleUpdateShader->Bind();
+		s_particleUpdateShader->SetUniform("u_deltaTime", deltaTime);
+		s_particleUpdateShader->SetUniform("u_seed", m_seed++);
+		s_particleUpdateShader->SetUniform("u_maxParticles", (int)m_maxParticlesCount);
+		s_particleUpdateShader->SetUniform("u_spawnStart", (int)m_spawnIndex);
+		s_particleUpdateShader->SetUniform("u_spawnCount", (int)spawnCount);
+		m_spawnIndex = (m_spawnIndex + spawnCount) % m_maxParticlesCount;
+
+		//the emitter's
+		s_particleUpdateShader->SetUniform("u_emitterShape", (int)m_emitterShape);
+		s_particleUpdateShader->SetUniform("u_emitterAngle", glm::radians(m_EmitterAngle));
+		s_particleUpdateShader->SetUniform("u_emitterScale", m_EmitterScale);
+		s_particleUpdateShader->SetUniformMatrix("u_emitterRotation", glm::mat3(glm::toMat4(glm::quat(m_rotation))));
+
+		//and the particle template's
+		s_particleUpdateShader->SetUniform("u_startColor", m_particle._StartColor);
+		s_particleUpdateShader->SetUniform("u_startColor2", m_particle._StartColor2);
+		s_particleUpdateShader->SetUniform("u_endColor", m_particle._EndColor);
+		s_particleUpdateShader->SetUniform("u_endColor2", m_particle._EndColor2);
+		s_particleUpdateShader->SetUniform("u_startSizes", glm::vec2(m_particle._StartSize, m_particle._StartSize2));
+		s_particleUpdateShader->SetUniform("u_endSizes", glm::vec2(m_particle._EndSize, m_particle._EndSize2));
+		s_particleUpdateShader->SetUniform("u_startSpeeds", glm::vec2(m_particle._startSpeed, m_particle._startSpeed2));
+		s_particleUpdateShader->SetUniform("u_endSpeeds", glm::vec2(m_particle._endSpeed, m_particle._endSpeed2));
+		s_particleUpdateShader->SetUniform("u_lifeTimes", glm::vec2(m_particle._lifeTime, m_particle._lifeTime2));
+
+		//run every particle in the current state through the update shader as a point, capturing the results in the other state buffer
+		int nextState = 1 - m_currentState;
+		glEnable(GL_RASTERIZER_DISCARD);
+		glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, m_transformFeedbacks[nextState]);
+		m_updateVaos[m_currentState]->Bind();
+		glBeginTransformFeedback(GL_POINTS);
+		glDrawArrays(GL_POINTS, 0, (GLsizei)m_maxParticlesCount);
+		glEndTransformFeedback();
+		TTN_VertexArrayObject::UnBind();
+		glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, 0);
+		glDisable(GL_RASTERIZER_DISCARD);
+
+		m_currentState = nextState;
+	}
+
+	//renders the particles straight from the gpu state
+	void TTN_ParticleSystem::RenderGPU(glm::vec3 ParentGlobalPos, glm::mat4 view, glm::mat4 projection)
+	{
+		//if nothing could be alive, there's nothing to draw
+		if (m_numOfAliveParticles == 0)
+			return;
+
+		//bind the shader
+		s_particleGPUShaderProgram->Bind();
+
+		//set uniforms
+		glm::mat4 temp_model = glm::translate(glm::mat4(1.0f), ParentGlobalPos);
+		s_particleGPUShaderProgram->SetUniformMatrix("u_model", temp_model);
+		s_particleGPUShaderProgram->SetUniformMatrix("u_mvp", projection * view * temp_model);
+		s_particleGPUShaderProgram->SetUniformMatrix("u_normalMat", glm::mat3(glm::transpose(glm::inverse(temp_model))));
+		s_particleGPUShaderProgram->SetUniform("u_emitterPosition", ParentGlobalPos);
+
+		//bind the albedo texture from the mat, or the default white texture if it doesn't have one
+		if (m_particle._mat->GetAlbedo() != nullptr)
+			m_particle._mat->GetAlbedo()->Bind(0);
+		else
+			s_defaultWhiteTexture->Bind(0);
+
+		//draw every particle, the dead ones get scaled down to nothing in the vertex shader
+		m_renderVaos[m_currentState]->RenderInstanced(m_maxParticlesCount, m_particle._mesh->GetVertexPositions().size());
 	}
 }
@@ -5,6 +5,7 @@
 #include "Titan/Physics.h"
 //include other required features
 #include "Titan/ObjLoader.h"
+#include "Titan/PhysicsPool.h"
 #include <iostream>
 
 #include "..\include\Titan\Physics.h"
@@ -19,14 +20,15 @@ namespace Titan {
 		m_trans.SetPos(glm::vec3(0.0f));
 		m_trans.SetScale(glm::vec3(1.0f));
 
-		//set up bullet collision shape
-		m_colShape = new btBoxShape(btVector3(m_trans.GetScale().x / 2.0f, m_trans.GetScale().y / 2.0f, m_trans.GetScale().z / 2.0f));
+		//get the bullet collision shape, bodies the same size share one
+		m_shapeType = TTN_ShapeType::BOX;
+		m_colShape = TTN_PhysicsPool::GetBoxShape(m_trans.GetScale() / 2.0f);
 		//set up bullet transform
 		m_bulletTrans.setIdentity();
 		m_bulletTrans.setOrigin(btVector3(m_trans.GetPos().x, m_trans.GetPos().y, m_trans.GetPos().z));
 		m_bulletTrans.setRotation(btQuaternion(m_trans.GetRotQuat().x, m_trans.GetRotQuat().y, m_trans.GetRotQuat().z, m_trans.GetRotQuat().w));
 		//setup up bullet motion state
-		m_MotionState = new btDefaultMotionState(m_bulletTrans);
+		m_MotionState = TTN_PhysicsPool::AcquireMotionState(m_bulletTrans);
 
 		//setup mass, static v dynmaic status, and local internia
 		btVector3 localIntertia(0, 0, 0);
@@ -34,12 +36,17 @@ namespace Titan {
 
 		m_bodyType = TTN_PhysicsBodyType::DYNAMIC;
 
-		//create the rigidbody
+		//create the rigidbody, recycling one from a deleted body if there is one
 		btRigidBody::btRigidBodyConstructionInfo rbInfo(m_Mass, m_MotionState, m_colShape, localIntertia);
-		m_body = new btRigidBody(rbInfo);
+		m_body = TTN_PhysicsPool::AcquireRigidBody(rbInfo);
 
+		//bodies stay awake unless they're set to be able to sleep
+		m_canSleep = false;
 		m_body->setActivationState(DISABLE_DEACTIVATION);
 
+		//continuous collision detection is off unless it's turned on
+		m_useCcd = false;
+
 		m_hasGravity = true;
 
 		m_InWorld = false;
@@ -47,6 +54,9 @@ namespace Titan {
 		m_entity = static_cast<entt::entity>(-1);
 
 		m_body->setUserPointer(reinterpret_cast<void*>(static_cast<uint32_t>(m_entity)));
+
+		SetCollisionGroup(1);
+		SetCollisionMask(UINT32_MAX);
 	
 	}
 
@@ -59,14 +69,52 @@ namespace Titan {
 		m_trans.RotateFixed(rotation);
 		m_trans.SetScale(scale);
 
-		//set up bullet collision shape
-		m_colShape = new btBoxShape(btVector3(m_trans.GetScale().x / 2.0f, m_trans.GetScale().y / 2.0f, m_trans.GetScale().z / 2.0f));
+		//get the bullet collision shape, bodies the same size share one
+		m_shapeType = TTN_ShapeType::BOX;
+		m_colShape = TTN_PhysicsPool::GetBoxShape(m_trans.GetScale() / 2.0f);
+
+		//and make the body around it
+		SetUpBody(entityNum, bodyType, mass);
+	}
+
+	//constructor that makes a physics body shaped like a mesh out of a position, rotation, and scale
+	TTN_Physics::TTN_Physics(glm::vec3 position, glm::vec3 rotation, glm::vec3 scale, entt::entity entityNum, TTN_Mesh::smptr mesh,
+		TTN_ShapeType shapeType, TTN_PhysicsBodyType bodyType, float mass)
+	{
+		//set up titan transform
+		m_trans = TTN_Transform();
+		m_trans.SetPos(position);
+		m_trans.RotateFixed(rotation);
+		m_trans.SetScale(scale);
+
+		//get the bullet collision shape, the hulls are built once per mesh and bodies with the same mesh and scale share a shape
+		m_shapeType = shapeType;
+		if (m_shapeType == TTN_ShapeType::CONVEX_HULL)
+			m_colShape = TTN_PhysicsPool::GetConvexHullShape(mesh, m_trans.GetScale());
+		else if (m_shapeType == TTN_ShapeType::COMPOUND)
+			m_colShape = TTN_PhysicsPool::GetCompoundShape(mesh, m_trans.GetScale());
+		else
+			m_colShape = nullptr;
+
+		//if the mesh couldn't make a shape, fall back to a box the size of the scale
+		if (m_colShape == nullptr) {
+			m_shapeType = TTN_ShapeType::BOX;
+			m_colShape = TTN_PhysicsPool::GetBoxShape(m_trans.GetScale() / 2.0f);
+		}
+
+		//and make the body around it
+		SetUpBody(entityNum, bodyType, mass);
+	}
+
+	//makes the motion state and rigidbody around the collision shape
+	void TTN_Physics::SetUpBody(entt::entity entityNum, TTN_PhysicsBodyType bodyType, float mass)
+	{
 		m_bulletTrans.setIdentity();
 		//set up bullet transform
 		m_bulletTrans.setOrigin(btVector3(m_trans.GetPos().x, m_trans.GetPos().y, m_trans.GetPos().z));
 		m_bulletTrans.setRotation(btQuaternion(m_trans.GetRotQuat().x, m_trans.GetRotQuat().y, m_trans.GetRotQuat().z, m_trans.GetRotQuat().w));
 		//setup up bullet motion state
-		m_MotionState = new btDefaultMotionState(m_bulletTrans);
+		m_MotionState = TTN_PhysicsPool::AcquireMotionState(m_bulletTrans);
 
 		//setup mass, static v dynmaic status, and local internia
 		btVector3 localIntertia(0, 0, 0);
@@ -79,9 +127,9 @@ namespace Titan {
 		if (m_bodyType == TTN_PhysicsBodyType::STATIC || m_bodyType == TTN_PhysicsBodyType::KINEMATIC)
 			m_Mass = 0;
 
-		//create the rigidbody
+		//create the rigidbody, recycling one from a deleted body if there is one
 		btRigidBody::btRigidBodyConstructionInfo rbInfo(m_Mass, m_MotionState, m_colShape, localIntertia);
-		m_body = new btRigidBody(rbInfo);
+		m_body = TTN_PhysicsPool::AcquireRigidBody(rbInfo);
 
 		//if it's kinematic, set the kinematic flag
 		if (m_bodyType == TTN_PhysicsBodyType::KINEMATIC) {
@@ -91,8 +139,13 @@ namespace Titan {
 			m_body->setCollisionFlags(m_body->getCollisionFlags() | btCollisionObject::CF_STATIC_OBJECT);
 		}
 
+		//bodies stay awake unless they're set to be able to sleep
+		m_canSleep = false;
 		m_body->setActivationState(DISABLE_DEACTIVATION);
 
+		//continuous collision detection is off unless it's turned on
+		m_useCcd = false;
+
 		m_hasGravity = true;
 
 		m_InWorld = false;
@@ -100,13 +153,16 @@ namespace Titan {
 		m_entity = entityNum;
 
 		m_body->setUserPointer(reinterpret_cast<void*>(static_cast<uint32_t>(m_entity)));
+
+		SetCollisionGroup(1);
+		SetCollisionMask(UINT32_MAX);
 	}
 
 	TTN_Physics::~TTN_Physics()
 	{}
 
 	//updates the position of the physics body based on the velocity and deltaTime
-	void TTN_Physics::Update(float deltaTime)
+	void TTN_Physics::Update(float)
 	{
 		//updates the titan transform of the physics body
 
@@ -180,11 +236,14 @@ namespace Titan {
 	void TTN_Physics::SetLinearVelocity(glm::vec3 velocity)
 	{
 		m_body->setLinearVelocity(btVector3(velocity.x, velocity.y, velocity.z));
+		//wake it up in case it was sleeping
+		m_body->activate();
 	}
 
 	void TTN_Physics::SetAngularVelocity(glm::vec3 velocity)
 	{
 		m_body->setAngularVelocity(btVector3(velocity.x, velocity.y, velocity.z));
+		m_body->activate();
 	}
 
 	void TTN_Physics::SetPos(glm::vec3 position)
@@ -195,6 +254,7 @@ namespace Titan {
 		Trans.setOrigin(newPos);
 		m_body->getMotionState()->setWorldTransform(Trans);
 		m_trans.SetPos(position);
+		m_body->activate();
 	}
 
 	void TTN_Physics::SetHasGravity(bool hasGrav)
@@ -202,14 +262,24 @@ namespace Titan {
 		m_hasGravity = hasGrav;
 	}
 
+	//sets wheter or not bullet can put the body to sleep
+	void TTN_Physics::SetCanSleep(bool canSleep)
+	{
+		m_canSleep = canSleep;
+		//bullet won't change the state of a body that has deactivation disabled, so it has to be forced
+		m_body->forceActivationState(canSleep ? ACTIVE_TAG : DISABLE_DEACTIVATION);
+	}
+
 	void TTN_Physics::AddForce(glm::vec3 force)
 	{
 		m_body->applyCentralForce(btVector3(force.x, force.y, force.z));
+		m_body->activate();
 	}
 
 	void TTN_Physics::AddImpulse(glm::vec3 impulseForce)
 	{
 		m_body->applyCentralImpulse(btVector3(impulseForce.x, impulseForce.y, impulseForce.z));
+		m_body->activate();
 	}
 
 	void TTN_Physics::ClearForces()
@@ -224,19 +294,60 @@ namespace Titan {
 		m_body->setUserPointer(reinterpret_cast<void*>(static_cast<uint32_t>(m_entity)));
 	}
 
-	TTN_Collision::TTN_Collision()
+	//turns continuous collision detection on or off, sized from the collider
+	void TTN_Physics::SetUseCcd(bool useCcd)
+	{
+		m_useCcd = useCcd;
+		if (!m_useCcd) {
+			SetCcdMotionThreshold(0.0f);
+			SetCcdSweptSphereRadius(0.0f);
+			return;
+		}
+
+		//get the smallest half extent of the collider's bounds, moving further than that in one step is where it could start skipping through things
+		btTransform identity;
+		identity.setIdentity();
+		btVector3 min, max;
+		m_colShape->getAabb(identity, min, max);
+		btVector3 halfExtents = (max - min) * 0.5f;
+		float smallest = (float)halfExtents[halfExtents.minAxis()];
+
+		//sweep a sphere that fits just inside the collider, so swept hits line up with where the collider would have touched
+		SetCcdMotionThreshold(smallest);
+		SetCcdSweptSphereRadius(0.9f * smallest);
+	}
+
+	//sets how far the body has to move in one physics step before it's swept
+	void TTN_Physics::SetCcdMotionThreshold(float threshold)
+	{
+		m_body->setCcdMotionThreshold(threshold);
+	}
+
+	//sets the radius of the sphere that's swept along the body's motion
+	void TTN_Physics::SetCcdSweptSphereRadius(float radius)
 	{
-		b1 = entt::null;
-		b2 = entt::null;
+		m_body->setCcdSweptSphereRadius(radius);
 	}
 
-	void TTN_Collision::SetBody1(const entt::entity body)
+	//sets the collision group bits of the body
+	void TTN_Physics::SetCollisionGroup(uint32_t group)
 	{
-		b1 = body;
+		//save the group in titan
+		m_collisionGroup = group;
+		//save the group in bullet
+		m_body->setUserIndex((int)group);
+		//if it's already in the world, update the broadphase's copy too
+		if (m_body->getBroadphaseHandle() != nullptr)
+			m_body->getBroadphaseHandle()->m_collisionFilterGroup = (int)group;
 	}
 
-	void TTN_Collision::SetBody2(const entt::entity body)
+	//sets which collision groups the body can collide with
+	void TTN_Physics::SetCollisionMask(uint32_t mask)
 	{
-		b2 = body;
+		//save the mask in titan, it's given to bullet when the body is added to the world
+		m_collisionMask = mask;
+		//if it's already in the world, update the broadphase's copy
+		if (m_body->getBroadphaseHandle() != nullptr)
+			m_body->getBroadphaseHandle()->m_collisionFilterMask = (int)mask;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,283 @@
+//Titan Engine, by Atlas X Games
+// PhysicsPool.cpp - source file for the class that shares collision shapes between physics bodies and recycles their bullet objects
+
+//include the header
+#include "Titan/PhysicsPool.h"
+//import bullet's hull simplifier
+#include <BulletCollision/CollisionShapes/btShapeHull.h>
+//import other required features
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <new>
+
+namespace Titan {
+	namespace {
+		//simplifies the convex hull around a set of points down to the few dozen points bullet's shape hull keeps
+		std::vector<btVector3> SimplifyHull(const std::vector<btVector3>& points) {
+			if (points.size() < 4)
+				return points;
+
+			btConvexHullShape fullHull = btConvexHullShape(&points[0].getX(), (int)points.size(), sizeof(btVector3));
+			btShapeHull simplified = btShapeHull(&fullHull);
+			//if it's too flat to make a hull out of, just keep all the points
+			if (!simplified.buildHull(fullHull.getMargin()) || simplified.numVertices() < 4)
+				return points;
+
+			return std::vector<btVector3>(simplified.getVertexPointer(), simplified.getVertexPointer() + simplified.numVertices());
+		}
+
+		//makes a convex hull shape out of a set of points
+		btConvexHullShape* MakeHullShape(const std::vector<btVector3>& points) {
+			return new btConvexHullShape(&points[0].getX(), (int)points.size(), sizeof(btVector3));
+		}
+	}
+
+	//hashes a shape key from the type, the bits of the size, and the mesh
+	size_t TTN_PhysicsPool::ShapeKeyHash::operator()(const ShapeKey& key) const
+	{
+		uint32_t bits[3];
+		memcpy(bits, &key.Size, sizeof(bits));
+		size_t hash = std::hash<int>()((int)key.Type);
+		for (int i = 0; i < 3; i++)
+			hash = hash * 31 + std::hash<uint32_t>()(bits[i]);
+		hash = hash * 31 + std::hash<const TTN_Mesh*>()(key.Mesh);
+		hash = hash * 31 + std::hash<int>()(key.Pieces);
+		return hash;
+	}
+
+	//turns recycling on or off
+	void TTN_PhysicsPool::SetEnabled(bool enabled)
+	{
+		s_enabled = enabled;
+
+		//nothing should sit on the free lists while recycling is off
+		if (!s_enabled) {
+			for (void* block : s_freeMotionStates) btAlignedFree(block);
+			for (void* block : s_freeRigidBodies) btAlignedFree(block);
+			s_freeMotionStates.clear();
+			s_freeRigidBodies.clear();
+		}
+	}
+
+	//gets the shared box shape with the given half extents
+	btCollisionShape* TTN_PhysicsPool::GetBoxShape(glm::vec3 halfExtents)
+	{
+		ShapeKey key = { TTN_ShapeType::BOX, halfExtents, nullptr, 0 };
+		auto it = s_shapes.find(key);
+		if (it != s_shapes.end())
+			return it->second;
+
+		btCollisionShape* shape = new btBoxShape(btVector3(halfExtents.x, halfExtents.y, halfExtents.z));
+		s_shapes.emplace(key, shape);
+		return shape;
+	}
+
+	//gets the shared convex hull of a mesh's first frame
+	btCollisionShape* TTN_PhysicsPool::GetConvexHullShape(const TTN_Mesh::smptr& mesh, glm::vec3 scale)
+	{
+		if (mesh == nullptr)
+			return nullptr;
+
+		//get the hull first, that also throws out anything left from an old mesh at the same address
+		const std::vector<std::vector<btVector3>>& hulls = GetMeshHulls(mesh, 1);
+		if (hulls.empty())
+			return nullptr;
+
+		ShapeKey key = { TTN_ShapeType::CONVEX_HULL, scale, mesh.get(), 1 };
+		auto it = s_shapes.find(key);
+		if (it != s_shapes.end())
+			return it->second;
+
+		//the hull is unscaled, so bullet scales it
+		btCollisionShape* shape = MakeHullShape(hulls[0]);
+		shape->setLocalScaling(btVector3(scale.x, scale.y, scale.z));
+		s_shapes.emplace(key, shape);
+		return shape;
+	}
+
+	//gets the shared compound shape for a concave mesh
+	btCollisionShape* TTN_PhysicsPool::GetCompoundShape(const TTN_Mesh::smptr& mesh, glm::vec3 scale, int pieces)
+	{
+		if (mesh == nullptr)
+			return nullptr;
+
+		pieces = std::max(1, pieces);
+		const std::vector<std::vector<btVector3>>& hulls = GetMeshHulls(mesh, pieces);
+		if (hulls.empty())
+			return nullptr;
+
+		ShapeKey key = { TTN_ShapeType::COMPOUND, scale, mesh.get(), pieces };
+		auto it = s_shapes.find(key);
+		if (it != s_shapes.end())
+			return it->second;
+
+		//every piece is a child in the same space as the mesh, scaling the compound scales them all
+		btCompoundShape* shape = new btCompoundShape(true, (int)hulls.size());
+		btTransform identity;
+		identity.setIdentity();
+		for (const std::vector<btVector3>& hull : hulls)
+			shape->addChildShape(identity, MakeHullShape(hull));
+		shape->setLocalScaling(btVector3(scale.x, scale.y, scale.z));
+		s_shapes.emplace(key, shape);
+		return shape;
+	}
+
+	//gets the hulls of a mesh split into the given number of pieces
+	const std::vector<std::vector<btVector3>>& TTN_PhysicsPool::GetMeshHulls(const TTN_Mesh::smptr& mesh, int pieces)
+	{
+		//if there are hulls for a mesh that's since been deleted at this address, retire everything made from them
+		auto it = s_meshHulls.find(mesh.get());
+		if (it != s_meshHulls.end() && it->second.Mesh.lock() != mesh) {
+			for (auto shape = s_shapes.begin(); shape != s_shapes.end();) {
+				if (shape->first.Mesh == mesh.get()) {
+					s_retiredShapes.push_back(shape->second);
+					shape = s_shapes.erase(shape);
+				}
+				else
+					shape++;
+			}
+			s_meshHulls.erase(it);
+		}
+
+		MeshHulls& meshHulls = s_meshHulls[mesh.get()];
+		meshHulls.Mesh = mesh;
+		auto built = meshHulls.Pieces.find(pieces);
+		if (built != meshHulls.Pieces.end())
+			return built->second;
+
+		std::vector<std::vector<btVector3>>& hulls = meshHulls.Pieces[pieces];
+		if (mesh->GetNumOfFrames() == 0)
+			return hulls;
+		const std::vector<glm::vec3>& positions = mesh->GetFramePositions(0);
+		if (positions.size() < 3)
+			return hulls;
+
+		//one hull around everything
+		if (pieces == 1) {
+			std::vector<btVector3> points;
+			points.reserve(positions.size());
+			for (const glm::vec3& pos : positions)
+				points.push_back(btVector3(pos.x, pos.y, pos.z));
+			hulls.push_back(SimplifyHull(points));
+			return hulls;
+		}
+
+		//otherwise split the triangles into slabs along the longest side of the mesh, by where their centers are
+		glm::vec3 min = positions[0], max = positions[0];
+		for (const glm::vec3& pos : positions) {
+			min = glm::min(min, pos);
+			max = glm::max(max, pos);
+		}
+		glm::vec3 size = max - min;
+		int axis = (size.x >= size.y && size.x >= size.z) ? 0 : (size.y >= size.z) ? 1 : 2;
+		float length = std::max(size[axis], 0.0001f);
+
+		const std::vector<uint32_t>& indices = mesh->GetIndicesRef();
+		size_t numOfTris = indices.empty() ? positions.size() / 3 : indices.size() / 3;
+		std::vector<std::vector<btVector3>> slabs = std::vector<std::vector<btVector3>>(pieces);
+		for (size_t tri = 0; tri < numOfTris; tri++) {
+			const glm::vec3* corners[3];
+			for (int i = 0; i < 3; i++)
+				corners[i] = &positions[indices.empty() ? tri * 3 + i : indices[tri * 3 + i]];
+
+			float center = ((*corners[0])[axis] + (*corners[1])[axis] + (*corners[2])[axis]) / 3.0f;
+			int slab = std::min(pieces - 1, std::max(0, (int)((center - min[axis]) / length * (float)pieces)));
+			for (int i = 0; i < 3; i++)
+				slabs[slab].push_back(btVector3(corners[i]->x, corners[i]->y, corners[i]->z));
+		}
+
+		for (const std::vector<btVector3>& slab : slabs) {
+			if (slab.size() >= 3)
+				hulls.push_back(SimplifyHull(slab));
+		}
+
+		return hulls;
+	}
+
+	//deletes a shape, and it's children if it's a compound shape
+	void TTN_PhysicsPool::DeleteShape(btCollisionShape* shape)
+	{
+		if (shape->isCompound()) {
+			btCompoundShape* compound = static_cast<btCompoundShape*>(shape);
+			for (int i = 0; i < compound->getNumChildShapes(); i++)
+				delete compound->getChildShape(i);
+		}
+		delete shape;
+	}
+
+	//makes a motion state starting at the given transform
+	TTN_MotionState* TTN_PhysicsPool::AcquireMotionState(const btTransform& startTrans)
+	{
+		void* block = AcquireBlock(s_freeMotionStates, sizeof(TTN_MotionState));
+		return new (block) TTN_MotionState(startTrans);
+	}
+
+	//makes a rigid body from the construction info
+	btRigidBody* TTN_PhysicsPool::AcquireRigidBody(const btRigidBody::btRigidBodyConstructionInfo& info)
+	{
+		void* block = AcquireBlock(s_freeRigidBodies, sizeof(btRigidBody));
+		return new (block) btRigidBody(info);
+	}
+
+	//gives a motion state back to the pool
+	void TTN_PhysicsPool::ReleaseMotionState(btMotionState* motionState)
+	{
+		if (motionState == nullptr)
+			return;
+
+		motionState->~btMotionState();
+		ReleaseBlock(s_freeMotionStates, motionState);
+	}
+
+	//gives a rigid body back to the pool
+	void TTN_PhysicsPool::ReleaseRigidBody(btRigidBody* body)
+	{
+		if (body == nullptr)
+			return;
+
+		body->~btRigidBody();
+		ReleaseBlock(s_freeRigidBodies, body);
+	}
+
+	//deletes every shared shape and everything on the free lists
+	void TTN_PhysicsPool::Clear()
+	{
+		for (auto& shape : s_shapes)
+			DeleteShape(shape.second);
+		s_shapes.clear();
+		for (btCollisionShape* shape : s_retiredShapes)
+			DeleteShape(shape);
+		s_retiredShapes.clear();
+		s_meshHulls.clear();
+
+		for (void* block : s_freeMotionStates) btAlignedFree(block);
+		for (void* block : s_freeRigidBodies) btAlignedFree(block);
+		s_freeMotionStates.clear();
+		s_freeRigidBodies.clear();
+	}
+
+	//gets a block of memory, off the free list if there is one
+	void* TTN_PhysicsPool::AcquireBlock(std::vector<void*>& freeList, size_t size)
+	{
+		if (!freeList.empty()) {
+			void* block = freeList.back();
+			freeList.pop_back();
+			s_reuses++;
+			return block;
+		}
+
+		//bullet's objects want 16 byte alignment
+		s_allocations++;
+		return btAlignedAlloc(size, 16);
+	}
+
+	//gives a block of memory back to the free list, or frees it if recycling is off
+	void TTN_PhysicsPool::ReleaseBlock(std::vector<void*>& freeList, void* block)
+	{
+		if (s_enabled)
+			freeList.push_back(block);
+		else
+			btAlignedFree(block);
+	}
+}
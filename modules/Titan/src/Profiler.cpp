@@ -0,0 +1,63 @@
+//Titan Engine, by Atlas X Games
+// Profiler.cpp - source file for the class that times the different phases of a frame so they can be benchmarked
+
+#include "Titan/Profiler.h"
+
+namespace Titan {
+	//clears the timings and counters from the last frame
+	void TTN_Profiler::BeginFrame()
+	{
+		for (int i = 0; i < (int)TTN_ProfilePhase::COUNT; i++)
+			s_phaseTimes[i] = 0.0;
+		for (int i = 0; i < (int)TTN_ProfileCounter::COUNT; i++)
+			s_counts[i] = 0;
+	}
+
+	//gets the name of a phase, for printing results
+	const char* TTN_Profiler::GetPhaseName(TTN_ProfilePhase phase)
+	{
+		switch (phase) {
+		case TTN_ProfilePhase::PHYSICS_STEP:
+			return "physics step";
+		case TTN_ProfilePhase::PHYSICS_SYNC:
+			return "physics sync";
+		case TTN_ProfilePhase::CONSTRUCT_COLLISIONS:
+			return "construct collisions";
+		case TTN_ProfilePhase::RENDER_SORT:
+			return "render sort";
+		case TTN_ProfilePhase::RENDER_UNIFORMS:
+			return "render uniforms";
+		case TTN_ProfilePhase::RENDER_DRAW:
+			return "render draw";
+		case TTN_ProfilePhase::WORLD_MATRICES:
+			return "world matrices";
+		case TTN_ProfilePhase::SPATIAL_QUERIES:
+			return "spatial queries";
+		default:
+			return "unknown";
+		}
+	}
+
+	//gets the name of a counter, for printing results
+	const char* TTN_Profiler::GetCounterName(TTN_ProfileCounter counter)
+	{
+		switch (counter) {
+		case TTN_ProfileCounter::PARTICLE_BYTES_UPLOADED:
+			return "particle bytes uploaded";
+		case TTN_ProfileCounter::CONTACT_MANIFOLDS:
+			return "contact manifolds";
+		case TTN_ProfileCounter::PHYSICS_BODIES_SYNCED:
+			return "physics bodies synced";
+		case TTN_ProfileCounter::PHYSICS_SUBSTEPS:
+			return "physics substeps";
+		case TTN_ProfileCounter::RENDER_ENTITIES_TESTED:
+			return "entities tested";
+		case TTN_ProfileCounter::RENDER_ENTITIES_CULLED:
+			return "entities culled";
+		case TTN_ProfileCounter::RENDER_ENTITIES_DRAWN:
+			return "entities drawn";
+		default:
+			return "unknown";
+		}
+	}
+}
@@ -90,4 +90,23 @@ namespace Titan {
 		//unbind the shader
 		m_Shader->UnBind();
 	}
+
+	//draws a number of copies of the mesh in one call, using the model and normal matrices in the instance buffer the mesh's instanced vao reads from
+	void TTN_Renderer::RenderInstanced(size_t numOfInstances, size_t baseInstance)
+	{
+		//make sure the vao is acutally set up before continuing
+		if (m_mesh->GetInstancedVAOPointer() == nullptr)
+			return;
+
+		//bind the shader this model uses
+		m_Shader->Bind();
+		//tell the shader to read the matrices from the instance attributes instead of the uniforms
+		m_Shader->SetUniform("u_Instanced", 1);
+		//render the VAO
+		m_mesh->GetInstancedVAOPointer()->RenderInstanced(numOfInstances, 0, baseInstance);
+		//set the shader back to the normal uniforms for the next draw
+		m_Shader->SetUniform("u_Instanced", 0);
+		//unbind the shader
+		m_Shader->UnBind();
+	}
 }
\ No newline at end of file
@@ -0,0 +1,198 @@
+//Titan Engine, by Atlas X Games
+// ResourceCache.cpp - source file for the class that shares loaded textures, meshes, and shaders so the same file is only loaded once
+
+//include the header
+#include "Titan/ResourceCache.h"
+#include "Titan/ObjLoader.h"
+//import other required features
+#include <filesystem>
+
+namespace Titan {
+	namespace {
+		//tidies up a path so different ways of writing the same file give the same key
+		std::string NormalizePath(const std::string& fileName) {
+			return std::filesystem::path(fileName).lexically_normal().generic_string();
+		}
+	}
+
+	//gets a 2D texture, loading it if it isn't already
+	TTN_Texture2D::st2dptr TTN_ResourceCache::GetTexture2D(const std::string& fileName, bool flipped, bool forceRgba)
+	{
+		std::string key = GetTexture2DKey(fileName, flipped, forceRgba);
+		TTN_Texture2D::st2dptr texture = Find<TTN_Texture2D>(TTN_ResourceType::TEXTURE_2D, key);
+		if (texture == nullptr) {
+			texture = TTN_Texture2D::LoadFromFile(fileName, flipped, forceRgba);
+			Add(TTN_ResourceType::TEXTURE_2D, key, texture);
+		}
+		return texture;
+	}
+
+	//gets a cubemap, loading it if it isn't already
+	TTN_TextureCubeMap::stcmptr TTN_ResourceCache::GetTextureCubeMap(const std::string& filePath)
+	{
+		std::string key = GetTextureCubeMapKey(filePath);
+		TTN_TextureCubeMap::stcmptr cubemap = Find<TTN_TextureCubeMap>(TTN_ResourceType::TEXTURE_CUBEMAP, key);
+		if (cubemap == nullptr) {
+			cubemap = TTN_TextureCubeMap::LoadFromImages(filePath);
+			Add(TTN_ResourceType::TEXTURE_CUBEMAP, key, cubemap);
+		}
+		return cubemap;
+	}
+
+	//gets a mesh, loading it if it isn't already
+	TTN_Mesh::smptr TTN_ResourceCache::GetMesh(const std::string& fileName)
+	{
+		std::string key = GetMeshKey(fileName);
+		TTN_Mesh::smptr mesh = Find<TTN_Mesh>(TTN_ResourceType::MESH, key);
+		if (mesh == nullptr) {
+			mesh = TTN_ObjLoader::LoadFromFile(fileName);
+			Add(TTN_ResourceType::MESH, key, mesh);
+		}
+		return mesh;
+	}
+
+	//gets a mesh with morph targets, loading it if it isn't already
+	TTN_Mesh::smptr TTN_ResourceCache::GetAnimatedMesh(const std::string& fileName, int numOfFiles)
+	{
+		std::string key = GetMeshKey(fileName, numOfFiles);
+		TTN_Mesh::smptr mesh = Find<TTN_Mesh>(TTN_ResourceType::MESH, key);
+		if (mesh == nullptr) {
+			mesh = TTN_ObjLoader::LoadAnimatedMeshFromFiles(fileName, numOfFiles);
+			Add(TTN_ResourceType::MESH, key, mesh);
+		}
+		return mesh;
+	}
+
+	//gets a shader program linked from 2 files, loading it if it isn't already
+	TTN_Shader::sshptr TTN_ResourceCache::GetShader(const std::string& vertexFile, const std::string& fragmentFile)
+	{
+		std::string key = GetShaderKey(vertexFile, fragmentFile);
+		TTN_Shader::sshptr shader = Find<TTN_Shader>(TTN_ResourceType::SHADER, key);
+		if (shader == nullptr) {
+			shader = TTN_Shader::Create();
+			shader->LoadShaderStageFromFile(vertexFile.c_str(), GL_VERTEX_SHADER);
+			shader->LoadShaderStageFromFile(fragmentFile.c_str(), GL_FRAGMENT_SHADER);
+			//only programs that acutally linked are shared, so fixing a broken shader and asking again tries again
+			if (shader->Link())
+				Add(TTN_ResourceType::SHADER, key, shader);
+		}
+		return shader;
+	}
+
+	//gets a shader program linked from 2 default shaders, loading it if it isn't already
+	TTN_Shader::sshptr TTN_ResourceCache::GetDefaultShader(TTN_DefaultShaders vertexShader, TTN_DefaultShaders fragmentShader)
+	{
+		//default shaders are keyed by their number rather than their file, so they can't be mixed up with custom ones
+		std::string key = "default:" + std::to_string((int)vertexShader) + "|default:" + std::to_string((int)fragmentShader);
+		TTN_Shader::sshptr shader = Find<TTN_Shader>(TTN_ResourceType::SHADER, key);
+		if (shader == nullptr) {
+			shader = TTN_Shader::Create();
+			shader->LoadDefaultShader(vertexShader);
+			shader->LoadDefaultShader(fragmentShader);
+			if (shader->Link())
+				Add(TTN_ResourceType::SHADER, key, shader);
+		}
+		return shader;
+	}
+
+	//gets the key a 2D texture is cached under
+	std::string TTN_ResourceCache::GetTexture2DKey(const std::string& fileName, bool flipped, bool forceRgba)
+	{
+		return NormalizePath(fileName) + (flipped ? "|flipped" : "") + (forceRgba ? "|rgba" : "");
+	}
+
+	//gets the key a cubemap is cached under
+	std::string TTN_ResourceCache::GetTextureCubeMapKey(const std::string& filePath)
+	{
+		return NormalizePath(filePath);
+	}
+
+	//gets the key a mesh is cached under, the number of files is 0 for a mesh from a single obj
+	std::string TTN_ResourceCache::GetMeshKey(const std::string& fileName, int numOfFiles)
+	{
+		return NormalizePath(fileName) + ((numOfFiles > 0) ? "|" + std::to_string(numOfFiles) : "");
+	}
+
+	//gets the key a shader program is cached under
+	std::string TTN_ResourceCache::GetShaderKey(const std::string& vertexFile, const std::string& fragmentFile)
+	{
+		return NormalizePath(vertexFile) + "|" + NormalizePath(fragmentFile);
+	}
+
+	//adds a resource to the cache
+	void TTN_ResourceCache::Add(TTN_ResourceType type, const std::string& key, const std::shared_ptr<void>& resource)
+	{
+		if (resource == nullptr)
+			return;
+
+		Entry& entry = s_entries[(int)type][key];
+		entry.Resource = resource;
+		entry.Retained = s_retainUnused ? resource : nullptr;
+	}
+
+	//frees the resources that nothing else is using
+	void TTN_ResourceCache::ReleaseUnused()
+	{
+		for (std::unordered_map<std::string, Entry>& entries : s_entries) {
+			for (auto it = entries.begin(); it != entries.end();) {
+				//if the cache has the only pointer to it, let it go
+				if (it->second.Retained != nullptr && it->second.Retained.use_count() == 1)
+					it->second.Retained.reset();
+
+				if (it->second.Resource.expired())
+					it = entries.erase(it);
+				else
+					it++;
+			}
+		}
+	}
+
+	//forgets every resource
+	void TTN_ResourceCache::Clear()
+	{
+		for (std::unordered_map<std::string, Entry>& entries : s_entries)
+			entries.clear();
+	}
+
+	//gets the stats for one type of resource
+	TTN_ResourceStats TTN_ResourceCache::GetStats(TTN_ResourceType type)
+	{
+		TTN_ResourceStats stats;
+		stats.Hits = s_hits[(int)type];
+		stats.Misses = s_misses[(int)type];
+		for (auto& entry : s_entries[(int)type]) {
+			std::shared_ptr<void> resource = entry.second.Resource.lock();
+			if (resource == nullptr)
+				continue;
+			stats.Count++;
+			stats.MemorySize += GetMemorySize(type, resource);
+		}
+		return stats;
+	}
+
+	//resets the hit and miss counts
+	void TTN_ResourceCache::ResetStats()
+	{
+		for (int i = 0; i < (int)TTN_ResourceType::COUNT; i++) {
+			s_hits[i] = 0;
+			s_misses[i] = 0;
+		}
+	}
+
+	//gets roughly how many bytes a resource takes up on the gpu
+	size_t TTN_ResourceCache::GetMemorySize(TTN_ResourceType type, const std::shared_ptr<void>& resource)
+	{
+		switch (type) {
+		case TTN_ResourceType::TEXTURE_2D:
+			return std::static_pointer_cast<TTN_Texture2D>(resource)->GetMemorySize();
+		case TTN_ResourceType::TEXTURE_CUBEMAP:
+			return std::static_pointer_cast<TTN_TextureCubeMap>(resource)->GetMemorySize();
+		case TTN_ResourceType::MESH:
+			return std::static_pointer_cast<TTN_Mesh>(resource)->GetMemorySize();
+		case TTN_ResourceType::SHADER:
+			return std::static_pointer_cast<TTN_Shader>(resource)->GetMemorySize();
+		default:
+			return 0;
+		}
+	}
+}
@@ -1,48 +1,98 @@
 //Titan Engine, by Atlas X Games
 // Scene.cpp - source file for the class that handles ECS, render calls, etc.
 #include "Titan/Scene.h"
+#include "Titan/Profiler.h"
+#include "Titan/PhysicsPool.h"
+#include "Logging.h"
 
 #include <GLM/gtc/matrix_transform.hpp>
+//import bullet's multithreaded world
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+#include <LinearMath/btThreads.h>
+//import other required features
+#include <algorithm>
+#include <cstring>
 
 namespace Titan {
-	TTN_Scene::TTN_Scene() {
+	TTN_Scene::TTN_Scene(int physicsWorkers) {
 		m_ShouldRender = true;
 		m_Registry = new entt::registry();
 		m_RenderGroup = std::make_unique<RenderGroupType>(m_Registry->group<TTN_Transform, TTN_Renderer>());
+		//listen for transforms and relationships changing so the hierarchy order can be kept up to date
+		ConnectRegistryListeners();
 		m_AmbientColor = glm::vec3(1.0f);
 		m_AmbientStrength = 1.0f;
 
 		//setting up physics world
-		collisionConfig = new btDefaultCollisionConfiguration(); //default collision config
-		dispatcher = new btCollisionDispatcher(collisionConfig); //default collision dispatcher
-		overlappingPairCache = new btDbvtBroadphase();//basic board phase
-		solver = new btSequentialImpulseConstraintSolver;//default collision solver
-
-		//create the physics world
-		m_physicsWorld = new btDiscreteDynamicsWorld(dispatcher, overlappingPairCache, solver, collisionConfig);
-
-		//set gravity to default none
-		m_physicsWorld->setGravity(btVector3(0.0f, 0.0f, 0.0f));
+		InitPhysics(physicsWorkers);
 	}
 
-	TTN_Scene::TTN_Scene(glm::vec3 AmbientLightingColor, float AmbientLightingStrength)
+	TTN_Scene::TTN_Scene(glm::vec3 AmbientLightingColor, float AmbientLightingStrength, int physicsWorkers)
 		: m_AmbientColor(AmbientLightingColor), m_AmbientStrength(AmbientLightingStrength)
 	{
 		m_ShouldRender = true;
 		m_Registry = new entt::registry();
 		m_RenderGroup = std::make_unique<RenderGroupType>(m_Registry->group<TTN_Transform, TTN_Renderer>());
+		//listen for transforms and relationships changing so the hierarchy order can be kept up to date
+		ConnectRegistryListeners();
 
 		//setting up physics world
+		InitPhysics(physicsWorkers);
+	}
+
+	//makes the physics world
+	void TTN_Scene::InitPhysics(int physicsWorkers)
+	{
 		collisionConfig = new btDefaultCollisionConfiguration(); //default collision config
-		dispatcher = new btCollisionDispatcher(collisionConfig); //default collision dispatcher
 		overlappingPairCache = new btDbvtBroadphase();//basic board phase
-		solver = new btSequentialImpulseConstraintSolver;//default collision solver
 
-		//create the physics world
-		m_physicsWorld = new btDiscreteDynamicsWorld(dispatcher, overlappingPairCache, solver, collisionConfig);
+		if (physicsWorkers > 0) {
+			//the multithreaded world, the dispatcher splits the narrowphase across the workers and the solver pool solves islands in parallel
+			btITaskScheduler* scheduler = GetPhysicsScheduler();
+			scheduler->setNumThreads(std::min(physicsWorkers, scheduler->getMaxNumThreads()));
+			m_physicsWorkers = scheduler->getNumThreads();
+
+			dispatcher = new btCollisionDispatcherMt(collisionConfig);
+			btConstraintSolverPoolMt* solverPool = new btConstraintSolverPoolMt(scheduler->getMaxNumThreads());
+			solver = solverPool;
+			m_physicsWorld = new btDiscreteDynamicsWorldMt(dispatcher, overlappingPairCache, solverPool, nullptr, collisionConfig);
+		}
+		else {
+			m_physicsWorkers = 0;
+			dispatcher = new btCollisionDispatcher(collisionConfig); //default collision dispatcher
+			solver = new btSequentialImpulseConstraintSolver;//default collision solver
+			m_physicsWorld = new btDiscreteDynamicsWorld(dispatcher, overlappingPairCache, solver, collisionConfig);
+		}
 
 		//set gravity to default none
 		m_physicsWorld->setGravity(btVector3(0.0f, 0.0f, 0.0f));
+
+		//build the collision events after every physics step
+		m_physicsWorld->setInternalTickCallback(&TTN_Scene::PhysicsTickCallback, this);
+	}
+
+	//gets the task scheduler shared by the multithreaded physics worlds
+	btITaskScheduler* TTN_Scene::GetPhysicsScheduler()
+	{
+		if (s_physicsScheduler == nullptr) {
+			//bullet only makes it's threaded scheduler when it's built with BT_THREADSAFE, otherwise use the one that runs everything in place
+			s_physicsScheduler = btCreateDefaultTaskScheduler();
+			if (s_physicsScheduler == nullptr) {
+				LOG_WARN("Bullet was built without BT_THREADSAFE, multithreaded physics will only use one thread");
+				s_physicsScheduler = btGetSequentialTaskScheduler();
+			}
+			//the scheduler has to be set before any of bullet's multithreaded classes are made
+			btSetTaskScheduler(s_physicsScheduler);
+		}
+
+		return s_physicsScheduler;
+	}
+
+	//gets wheter or not bullet was built with threading
+	bool TTN_Scene::GetPhysicsMultithreadingSupported()
+	{
+		return GetPhysicsScheduler() != btGetSequentialTaskScheduler();
 	}
 
 	TTN_Scene::~TTN_Scene() {
@@ -54,35 +104,32 @@ namespace Titan {
 		//create the entity
 		auto entity = m_Registry->create();
 
-		//reconstruct scenegraph as entt was shuffled
-		ReconstructScenegraph();
-
 		//return the entity id
 		return entity;
 	}
 
 	void TTN_Scene::DeleteEntity(entt::entity entity)
 	{
-		//if the entity has a bullet physics body, delete it from bullet
+		//if the entity has a bullet physics body, remove it from bullet and give it back to the pool (the shape is shared so it stays)
 		if (m_Registry->has<TTN_Physics>(entity)) {
 			btRigidBody* body = Get<TTN_Physics>(entity).GetRigidBody();
-			delete body->getMotionState();
-			delete body->getCollisionShape();
 			m_physicsWorld->removeRigidBody(body);
-			delete body;
+			TTN_PhysicsPool::ReleaseMotionState(body->getMotionState());
+			TTN_PhysicsPool::ReleaseRigidBody(body);
 		}
 
-		//delete the entity from the registry
+		//delete the entity from the registry (this also unlinks it from it's parent and children)
 		m_Registry->destroy(entity);
-
-		//reconstruct scenegraph as entt was shuffled
-		ReconstructScenegraph();
 	}
 
 	//sets the underlying entt registry of the scene
 	void TTN_Scene::SetScene(entt::registry* reg)
 	{
 		m_Registry = reg;
+
+		//listen to the new registry's transforms and relationships, and rebuild the hierarchy order for it
+		ConnectRegistryListeners();
+		m_TransformOrderDirty = true;
 	}
 
 	//unloads the scene, deleting the registry and physics world
@@ -94,14 +141,15 @@ namespace Titan {
 			//get the object and it's rigid body
 			btCollisionObject* PhyObject = m_physicsWorld->getCollisionObjectArray()[i];
 			btRigidBody* PhysRigidBod = btRigidBody::upcast(PhyObject);
-			//if it has a motion state, remove that
-			if (PhysRigidBod != nullptr && PhysRigidBod->getMotionState() != nullptr) {
-				delete PhysRigidBod->getMotionState();
-			}
 			//remove the object from the physics world
 			m_physicsWorld->removeCollisionObject(PhyObject);
-			//and delete it
-			delete PhyObject;
+			//and give it and it's motion state back to the pool, every rigid body comes from there
+			if (PhysRigidBod != nullptr) {
+				TTN_PhysicsPool::ReleaseMotionState(PhysRigidBod->getMotionState());
+				TTN_PhysicsPool::ReleaseRigidBody(PhysRigidBod);
+			}
+			else
+				delete PhyObject;
 		}
 
 		//delete the physics world and it's attributes
@@ -118,53 +166,290 @@ namespace Titan {
 		}
 	}
 
-	//reconstructs the scenegraph, should be done every time entt shuffles
-	void TTN_Scene::ReconstructScenegraph()
+	//makes an entity the child of another, pass entt::null as the parent to unparent it
+	void TTN_Scene::SetParent(entt::entity child, entt::entity parent)
+	{
+		//make sure the entities have relationships to store the links in (before getting any references, as this can move the pool)
+		if (!Has<TTN_Relationship>(child))
+			Attach<TTN_Relationship>(child);
+		if (parent != entt::null && !Has<TTN_Relationship>(parent))
+			Attach<TTN_Relationship>(parent);
+
+		//if it's already the parent there's nothing to do
+		if (Get<TTN_Relationship>(child).m_Parent == parent)
+			return;
+
+		//make sure the child isn't being made a child of itself or one of it's own children
+		for (entt::entity current = parent; current != entt::null; current = Get<TTN_Relationship>(current).m_Parent) {
+			if (current == child) {
+				LOG_WARN("Tried to make an entity a child of itself or one of it's children, the parent was not changed");
+				return;
+			}
+		}
+
+		//remove it from it's old parent's children
+		UnlinkFromParent(child);
+
+		//and add it to the front of the new parent's children
+		if (parent != entt::null) {
+			TTN_Relationship& childRel = Get<TTN_Relationship>(child);
+			TTN_Relationship& parentRel = Get<TTN_Relationship>(parent);
+			childRel.m_Parent = parent;
+			childRel.m_NextSibling = parentRel.m_FirstChild;
+			if (parentRel.m_FirstChild != entt::null)
+				Get<TTN_Relationship>(parentRel.m_FirstChild).m_PrevSibling = child;
+			parentRel.m_FirstChild = child;
+			parentRel.m_NumChildren++;
+		}
+
+		//the world matrix will need to be rebuilt relative to the new parent
+		if (Has<TTN_Transform>(child)) {
+			TTN_Transform& trans = Get<TTN_Transform>(child);
+			trans.m_hasParent = GetHasTransformParent(child);
+			trans.Recompute();
+		}
+
+		//and the hierarchy order has changed
+		m_TransformOrderDirty = true;
+	}
+
+	//gets an entity's parent
+	entt::entity TTN_Scene::GetParent(entt::entity entity)
+	{
+		return Has<TTN_Relationship>(entity) ? Get<TTN_Relationship>(entity).m_Parent : entt::null;
+	}
+
+	//checks if an entity has a parent with a transform
+	bool TTN_Scene::GetHasTransformParent(entt::entity entity)
+	{
+		if (!Has<TTN_Relationship>(entity))
+			return false;
+
+		entt::entity parent = Get<TTN_Relationship>(entity).m_Parent;
+		return parent != entt::null && Has<TTN_Transform>(parent);
+	}
+
+	//removes an entity from it's parent's list of children
+	void TTN_Scene::UnlinkFromParent(entt::entity entity)
+	{
+		TTN_Relationship& rel = Get<TTN_Relationship>(entity);
+		if (rel.m_Parent == entt::null)
+			return;
+
+		//point the siblings on either side at each other (or the parent at the next sibling if this was the first child)
+		TTN_Relationship& parentRel = Get<TTN_Relationship>(rel.m_Parent);
+		if (rel.m_PrevSibling != entt::null)
+			Get<TTN_Relationship>(rel.m_PrevSibling).m_NextSibling = rel.m_NextSibling;
+		else
+			parentRel.m_FirstChild = rel.m_NextSibling;
+		if (rel.m_NextSibling != entt::null)
+			Get<TTN_Relationship>(rel.m_NextSibling).m_PrevSibling = rel.m_PrevSibling;
+		parentRel.m_NumChildren--;
+
+		rel.m_Parent = entt::null;
+		rel.m_PrevSibling = entt::null;
+		rel.m_NextSibling = entt::null;
+	}
+
+	//works out the world matrix of every transform that's changed since the last pass, parents before children
+	void TTN_Scene::UpdateWorldMatrices()
+	{
+		TTN_ProfileScope profileScope(TTN_ProfilePhase::WORLD_MATRICES);
+
+		//if parents have changed or transforms have been removed, rebuild the order
+		if (m_TransformOrderDirty)
+			RebuildTransformOrder();
+
+		//go through the transforms in order, so a parent's world matrix is always ready before it's children need it
+		for (size_t i = 0; i < m_TransformOrder.size(); i++) {
+			TTN_Transform& trans = m_Registry->get<TTN_Transform>(m_TransformOrder[i]);
+			int parent = m_TransformParentIndex[i];
+
+			//it needs to be rebuilt if it's changed or it's parent's world matrix did
+			bool changed = trans.m_changed || (parent >= 0 && m_WorldChanged[parent]);
+			if (changed) {
+				trans.RecomputeLocal();
+				m_WorldMatrices[i] = (parent >= 0) ? m_WorldMatrices[parent] * trans.m_transform : trans.m_transform;
+				trans.m_global = m_WorldMatrices[i];
+				trans.m_changed = false;
+			}
+			m_WorldChanged[i] = changed;
+		}
+	}
+
+	//sorts the entities with transforms so parents always come before their children
+	void TTN_Scene::RebuildTransformOrder()
 	{
-		//reconstruct any scenegraph relationships
 		auto transView = m_Registry->view<TTN_Transform>();
+		m_TransformOrder.clear();
+		m_TransformParentIndex.clear();
+		m_TransformOrder.reserve(transView.size());
+		m_TransformParentIndex.reserve(transView.size());
+
+		//go down the hierarchy from each root, adding each transform after it's parent
+		std::vector<std::pair<entt::entity, int>> toVisit;
 		for (auto entity : transView) {
-			//if it should have a parent
-			if (Get<TTN_Transform>(entity).GetParentEntity() != nullptr) {
-				//then reatach that parent
-				Get<TTN_Transform>(entity).SetParent(&Get<TTN_Transform>(*Get<TTN_Transform>(entity).GetParentEntity()),
-					Get<TTN_Transform>(entity).GetParentEntity());
+			//children get added when their parent is reached
+			if (GetHasTransformParent(entity))
+				continue;
+
+			toVisit.push_back(std::make_pair(entity, -1));
+			while (!toVisit.empty()) {
+				entt::entity current = toVisit.back().first;
+				int parent = toVisit.back().second;
+				toVisit.pop_back();
+
+				//add it to the order
+				int index = (int)m_TransformOrder.size();
+				m_TransformOrder.push_back(current);
+				m_TransformParentIndex.push_back(parent);
+
+				//make sure it knows wheter or not it has a parent, and that it gets rebuilt in the next pass
+				TTN_Transform& trans = Get<TTN_Transform>(current);
+				trans.m_hasParent = (parent >= 0);
+				trans.m_changed = true;
+
+				//and queue up it's children (ones without transforms are roots of their own)
+				if (Has<TTN_Relationship>(current)) {
+					for (entt::entity child = Get<TTN_Relationship>(current).m_FirstChild; child != entt::null;
+						child = Get<TTN_Relationship>(child).m_NextSibling) {
+						if (Has<TTN_Transform>(child))
+							toVisit.push_back(std::make_pair(child, index));
+					}
+				}
 			}
 		}
+
+		m_WorldMatrices.resize(m_TransformOrder.size());
+		m_WorldChanged.assign(m_TransformOrder.size(), 0);
+
+		m_TransformOrderDirty = false;
 	}
 
-	void TTN_Scene::Update(float deltaTime)
+	//connects the scene's listeners to the registry's transform and relationship events
+	void TTN_Scene::ConnectRegistryListeners()
+	{
+		m_Registry->on_construct<TTN_Transform>().connect<&TTN_Scene::OnTransformAdded>(*this);
+		m_Registry->on_update<TTN_Transform>().connect<&TTN_Scene::OnTransformReplaced>(*this);
+		m_Registry->on_destroy<TTN_Transform>().connect<&TTN_Scene::OnTransformRemoved>(*this);
+		m_Registry->on_destroy<TTN_Relationship>().connect<&TTN_Scene::OnRelationshipRemoved>(*this);
+	}
+
+	//called by entt when a transform is added
+	void TTN_Scene::OnTransformAdded(entt::registry& reg, entt::entity entity)
 	{
-		//call the step simulation for bullet
-		m_physicsWorld->stepSimulation(deltaTime);
+		//if it's linked to other entities it has to be put in the right place, so the order needs to be rebuilt
+		if (m_TransformOrderDirty || (reg.has<TTN_Relationship>(entity) &&
+			(reg.get<TTN_Relationship>(entity).m_Parent != entt::null || reg.get<TTN_Relationship>(entity).m_FirstChild != entt::null))) {
+			m_TransformOrderDirty = true;
+			return;
+		}
 
-		//run through all of the physicsbody in the scene
-		auto physicsBodyView = m_Registry->view<TTN_Physics>();
-		for (auto entity : physicsBodyView) {
-			//if the physics body isn't in the world, add it
-			if (!Get<TTN_Physics>(entity).GetIsInWorld()) {
-				Get<TTN_Physics>(entity).SetEntity(entity);
-				m_physicsWorld->addRigidBody(Get<TTN_Physics>(entity).GetRigidBody());
-				Get<TTN_Physics>(entity).SetIsInWorld(true);
+		//otherwise it's a root with no children, which can go anywhere in the order, so just add it to the end
+		m_TransformOrder.push_back(entity);
+		m_TransformParentIndex.push_back(-1);
+		m_WorldMatrices.push_back(glm::mat4(1.0f));
+		m_WorldChanged.push_back(0);
+	}
+
+	//called by entt when a transform is replaced
+	void TTN_Scene::OnTransformReplaced(entt::registry& reg, entt::entity entity)
+	{
+		//the new transform doesn't know about the entity's parent, so fill that in
+		reg.get<TTN_Transform>(entity).m_hasParent = GetHasTransformParent(entity);
+	}
+
+	//called by entt when a transform is removed
+	void TTN_Scene::OnTransformRemoved(entt::registry&, entt::entity)
+	{
+		m_TransformOrderDirty = true;
+	}
+
+	//called by entt when a relationship is removed, unlinks the entity from it's parent and children
+	void TTN_Scene::OnRelationshipRemoved(entt::registry& reg, entt::entity entity)
+	{
+		//take it out of it's parent's children
+		UnlinkFromParent(entity);
+
+		//and turn all of it's children into roots
+		TTN_Relationship& rel = reg.get<TTN_Relationship>(entity);
+		entt::entity child = rel.m_FirstChild;
+		while (child != entt::null) {
+			TTN_Relationship& childRel = reg.get<TTN_Relationship>(child);
+			entt::entity next = childRel.m_NextSibling;
+			childRel.m_Parent = entt::null;
+			childRel.m_PrevSibling = entt::null;
+			childRel.m_NextSibling = entt::null;
+			if (reg.has<TTN_Transform>(child)) {
+				reg.get<TTN_Transform>(child).m_hasParent = false;
+				reg.get<TTN_Transform>(child).Recompute();
 			}
+			child = next;
+		}
+		rel.m_FirstChild = entt::null;
+		rel.m_NumChildren = 0;
 
-			//make sure the physics body are active on every frame
-			Get<TTN_Physics>(entity).GetRigidBody()->setActivationState(true);
+		m_TransformOrderDirty = true;
+	}
 
-			//call the physics body's update
-			Get<TTN_Physics>(entity).Update(deltaTime);
+	void TTN_Scene::Update(float deltaTime)
+	{
+		//clear the collision events from the last update, each physics step adds it's own
+		m_collisionEvents.clear();
+
+		//step bullet, it splits the frame into fixed steps (dropping any past the max) and interpolates the motion states between the
+		//last two steps, each step builds it's collision events in the tick callback
+		{
+			double collisionTimeBefore = TTN_Profiler::GetTime(TTN_ProfilePhase::CONSTRUCT_COLLISIONS);
+			auto start = std::chrono::high_resolution_clock::now();
+			m_lastPhysicsSubSteps = m_physicsWorld->stepSimulation(deltaTime, m_maxPhysicsSubSteps, m_physicsTimeStep);
+			std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+			m_lastPhysicsStepTime = (float)elapsed.count();
+
+			//the collision events are timed on their own, so take them out of the step time
+			if (TTN_Profiler::GetEnabled()) {
+				double collisionTime = TTN_Profiler::GetTime(TTN_ProfilePhase::CONSTRUCT_COLLISIONS) - collisionTimeBefore;
+				TTN_Profiler::AddTime(TTN_ProfilePhase::PHYSICS_STEP, elapsed.count() - collisionTime);
+				TTN_Profiler::AddCount(TTN_ProfileCounter::PHYSICS_SUBSTEPS, (uint64_t)m_lastPhysicsSubSteps);
+			}
 		}
 
-		//construct the collisions for the frame
-		ConstructCollisions();
+		//add any physics bodies that aren't in the world yet
+		auto physicsBodyView = m_Registry->view<TTN_Physics>();
+		for (auto entity : physicsBodyView) {
+			TTN_Physics& physics = physicsBodyView.get<TTN_Physics>(entity);
+			if (!physics.GetIsInWorld()) {
+				physics.SetEntity(entity);
+				//with it's group and mask, so the broadphase can skip pairs that can't collide
+				m_physicsWorld->addRigidBody(physics.GetRigidBody(), (int)physics.GetCollisionGroup(), (int)physics.GetCollisionMask());
+				physics.SetIsInWorld(true);
+
+				//have it report whenever bullet moves it, and sync it once now so the transform starts in the right place
+				physics.GetMotionState()->SetMovedList(&m_movedBodies, entity);
+				m_movedBodies.push_back(entity);
+			}
+		}
 
-		//run through all of the entities with both a physics body and a transform in the scene
-		auto transAndPhysicsView = m_Registry->view<TTN_Transform, TTN_Physics>();
-		for (auto entity : transAndPhysicsView) {
-			if (!Get<TTN_Physics>(entity).GetIsStatic()) {
-				//copy the position of the physics body into the position of the transform
-				Get<TTN_Transform>(entity).SetPos(Get<TTN_Physics>(entity).GetTrans().GetPos());
+		//copy the positions of the bodies that moved into their transforms, sleeping and static bodies aren't in the list so they cost nothing
+		{
+			TTN_ProfileScope profileScope(TTN_ProfilePhase::PHYSICS_SYNC);
+			TTN_Profiler::AddCount(TTN_ProfileCounter::PHYSICS_BODIES_SYNCED, (uint64_t)m_movedBodies.size());
+			for (size_t i = 0; i < m_movedBodies.size(); i++) {
+				entt::entity entity = m_movedBodies[i];
+				//the entity could have been deleted since it moved
+				if (!m_Registry->valid(entity) || !Has<TTN_Physics>(entity))
+					continue;
+
+				//call the physics body's update
+				TTN_Physics& physics = Get<TTN_Physics>(entity);
+				physics.Update(deltaTime);
+
+				if (!physics.GetIsStatic() && Has<TTN_Transform>(entity)) {
+					//copy the position of the physics body into the position of the transform
+					Get<TTN_Transform>(entity).SetPos(physics.GetTrans().GetPos());
+				}
 			}
+			m_movedBodies.clear();
 		}
 
 		//run through all the of entities with an animator and renderer in the scene and run it's update
@@ -198,6 +483,9 @@ namespace Titan {
 	//renders all the messes in our game
 	void TTN_Scene::Render()
 	{
+		//work out the world matrices of everything that's changed
+		UpdateWorldMatrices();
+
 		//get the view and projection martix
 		glm::mat4 vp;
 		//update the camera for the scene
@@ -207,207 +495,208 @@ namespace Titan {
 		vp = Get<TTN_Camera>(m_Cam).GetProj();
 		glm::mat4 viewMat = glm::inverse(Get<TTN_Transform>(m_Cam).GetGlobal());
 		vp *= viewMat;
+		//and work out what the camera can see from them
+		m_Frustum.SetFromViewProjection(vp);
+
+		//send the lights, camera, etc. to the gpu once for every shader to share
+		{
+			TTN_ProfileScope profileScope(TTN_ProfilePhase::RENDER_UNIFORMS);
+			UploadSceneUniforms(viewMat, Get<TTN_Camera>(m_Cam).GetProj());
+		}
+
+		//with bindless materials, entities with the same mesh and shader can get drawn together no matter their material (if the gpu
+		//allows each instance to sample different handles), so then the material is sorted after the mesh for the shaders that read the material buffer
+		const bool bindless = GetBindlessActive();
+		const bool mixedMaterials = GetMixedMaterialBatchingActive();
 
 		//sort our render group
-		m_RenderGroup->sort<TTN_Renderer>([](const TTN_Renderer& l, const TTN_Renderer& r) {
-			//sort by render layer first, higher render layers get drawn later
-			if (l.GetRenderLayer() < r.GetRenderLayer()) return true;
-			if (l.GetRenderLayer() > r.GetRenderLayer()) return false;
-
-			//sort by shader pointer to minimize state changes on active shader
-			if (l.GetShader() < r.GetShader()) return true;
-			if (l.GetShader() > r.GetShader()) return false;
-
-			//sort by material pointer to  minimize state changes on textures and stuff
-			if (l.GetMat() < r.GetMat()) return true;
-			if (l.GetMat() > r.GetMat()) return false;
-		});
+		{
+			TTN_ProfileScope profileScope(TTN_ProfilePhase::RENDER_SORT);
+			m_RenderGroup->sort<TTN_Renderer>([mixedMaterials](const TTN_Renderer& l, const TTN_Renderer& r) {
+				//sort by render layer first, higher render layers get drawn later
+				if (l.GetRenderLayer() < r.GetRenderLayer()) return true;
+				if (l.GetRenderLayer() > r.GetRenderLayer()) return false;
+
+				//sort by shader pointer to minimize state changes on active shader
+				if (l.GetShader() < r.GetShader()) return true;
+				if (l.GetShader() > r.GetShader()) return false;
+
+				//sort by material pointer to  minimize state changes on textures and stuff
+				const bool materialFirst = !mixedMaterials || !GetUsesMaterialBuffer(l.GetShader());
+				if (materialFirst) {
+					if (l.GetMat() < r.GetMat()) return true;
+					if (l.GetMat() > r.GetMat()) return false;
+				}
 
-		ReconstructScenegraph();
+				//sort by mesh pointer so entities that can be instanced together end up next to each other
+				if (l.GetMesh() < r.GetMesh()) return true;
+				if (l.GetMesh() > r.GetMesh()) return false;
 
-		//go through every entity with a transform and a mesh renderer and render the mesh
-		m_RenderGroup->each([&](entt::entity entity, TTN_Transform& transform, TTN_Renderer& renderer) {
-			//get the shader pointer
-			TTN_Shader::sshptr shader = renderer.GetShader();
-
-			//bind the shader
-			shader->Bind();
-
-			//sets some uniforms
-			if (shader->GetFragShaderDefaultStatus() != (int)TTN_DefaultShaders::NOT_DEFAULT) {
-				//scene level ambient lighting
-				shader->SetUniform("u_AmbientCol", m_AmbientColor);
-				shader->SetUniform("u_AmbientStrength", m_AmbientStrength);
-
-				//stuff from the light
-				glm::vec3 lightPositions[16];
-				glm::vec3 lightColor[16];
-				float lightAmbientStr[16];
-				float lightSpecStr[16];
-				float lightAttenConst[16];
-				float lightAttenLinear[16];
-				float lightAttenQuadartic[16];
-
-				for (int i = 0; i < 16 && i < m_Lights.size(); i++) {
-					auto& light = Get<TTN_Light>(m_Lights[i]);
-					auto& lightTrans = Get<TTN_Transform>(m_Lights[i]);
-					lightPositions[i] = lightTrans.GetPos();
-					lightColor[i] = light.GetColor();
-					lightAmbientStr[i] = light.GetAmbientStrength();
-					lightSpecStr[i] = light.GetSpecularStrength();
-					lightAttenConst[i] = light.GetConstantAttenuation();
-					lightAttenLinear[i] = light.GetConstantAttenuation();
-					lightAttenQuadartic[i] = light.GetQuadraticAttenuation();
+				if (!materialFirst) {
+					if (l.GetMat() < r.GetMat()) return true;
+					if (l.GetMat() > r.GetMat()) return false;
 				}
 
-				//send all the data about the lights to glsl
-				shader->SetUniform("u_LightPos", lightPositions[0], 16);
-				shader->SetUniform("u_LightCol", lightColor[0], 16);
-				shader->SetUniform("u_AmbientLightStrength", lightAmbientStr[0], 16);
-				shader->SetUniform("u_SpecularLightStrength", lightSpecStr[0], 16);
-				shader->SetUniform("u_LightAttenuationConstant", lightAttenConst[0], 16);
-				shader->SetUniform("u_LightAttenuationLinear", lightAttenLinear[0], 16);
-				shader->SetUniform("u_LightAttenuationQuadratic", lightAttenQuadartic[0], 16);
+				//otherwise they're equivalent
+				return false;
+			});
+		}
 
-				//and tell it how many lights there actually are
-				shader->SetUniform("u_NumOfLights", (int)m_Lights.size());
+		//send the materials to the gpu for the shaders that read them from the material buffer
+		if (bindless) {
+			TTN_ProfileScope profileScope(TTN_ProfilePhase::RENDER_UNIFORMS);
+			UploadMaterials();
+		}
 
-				//stuff from the camera
-				shader->SetUniform("u_CamPos", Get<TTN_Transform>(m_Cam).GetPos());
-			}
+		//make sure the instance buffer can hold every entity, in case they all end up in batches
+		if (m_InstancingEnabled && (m_InstanceBuffer == nullptr || m_InstanceBuffer->GetCapacity() < m_RenderGroup->size())) {
+			size_t capacity = (m_InstanceBuffer == nullptr) ? 64 : m_InstanceBuffer->GetCapacity() * 2;
+			m_InstanceBuffer = TTN_StreamBuffer::Create(sizeof(TTN_InstanceData), std::max(capacity, m_RenderGroup->size()));
+		}
 
-			//if it's not the skybox shader, set some uniforms for lighting
-			if (shader->GetFragShaderDefaultStatus() != (int)TTN_DefaultShaders::FRAG_SKYBOX 
-				&& shader->GetFragShaderDefaultStatus() != (int)TTN_DefaultShaders::NOT_DEFAULT) {
-				//sets some uniforms
-				//scene level ambient lighting
-				shader->SetUniform("u_AmbientCol", m_AmbientColor);
-				shader->SetUniform("u_AmbientStrength", m_AmbientStrength);
-
-				//stuff from the light
-				glm::vec3 lightPositions[16];
-				glm::vec3 lightColor[16];
-				float lightAmbientStr[16];
-				float lightSpecStr[16];
-				float lightAttenConst[16];
-				float lightAttenLinear[16];
-				float lightAttenQuadartic[16];
-
-				for (int i = 0; i < 16 && i < m_Lights.size(); i++) {
-					auto& light = Get<TTN_Light>(m_Lights[i]);
-					auto& lightTrans = Get<TTN_Transform>(m_Lights[i]);
-					lightPositions[i] = lightTrans.GetGlobalPos();
-					lightColor[i] = light.GetColor();
-					lightAmbientStr[i] = light.GetAmbientStrength();
-					lightSpecStr[i] = light.GetSpecularStrength();
-					lightAttenConst[i] = light.GetConstantAttenuation();
-					lightAttenLinear[i] = light.GetConstantAttenuation();
-					lightAttenQuadartic[i] = light.GetQuadraticAttenuation();
+		//go through every entity with a transform and a mesh renderer and render the mesh, entities next to each other in the sorted
+		//group that share a mesh, shader, and material get batched together into a single instanced draw
+		//anything the camera can't see is skipped before it's batched, so no uniforms or instance data are sent for it
+		uint64_t tested = 0, culled = 0;
+		m_RenderGroup->each([&](entt::entity entity, TTN_Transform& transform, TTN_Renderer& renderer) {
+			if (m_FrustumCullingEnabled) {
+				tested++;
+				if (!IsInFrustum(transform, renderer)) {
+					culled++;
+					return;
 				}
+			}
 
-				//send all the data about the lights to glsl
-				shader->SetUniform("u_LightPos", lightPositions[0], 16);
-				shader->SetUniform("u_LightCol", lightColor[0], 16);
-				shader->SetUniform("u_AmbientLightStrength", lightAmbientStr[0], 16);
-				shader->SetUniform("u_SpecularLightStrength", lightSpecStr[0], 16);
-				shader->SetUniform("u_LightAttenuationConstant", lightAttenConst[0], 16);
-				shader->SetUniform("u_LightAttenuationLinear", lightAttenLinear[0], 16);
-				shader->SetUniform("u_LightAttenuationQuadratic", lightAttenQuadartic[0], 16);
+			//if it can join the current batch, add it and move on
+			if (!m_RenderBatch.empty() && CanInstanceTogether(m_RenderBatch.front(), entity)) {
+				m_RenderBatch.push_back(entity);
+				return;
+			}
 
-				//and tell it how many lights there actually are
-				shader->SetUniform("u_NumOfLights", (int)m_Lights.size());
+			//otherwise draw whatever was batched so far and start a new batch with this entity
+			RenderBatch(vp, viewMat);
+			m_RenderBatch.push_back(entity);
+		});
 
-				//stuff from the camera
-				shader->SetUniform("u_CamPos", Get<TTN_Transform>(m_Cam).GetPos());
-			}
+		//draw the last batch
+		RenderBatch(vp, viewMat);
+		//and move the instance buffer on to the next frame's region
+		if (m_InstanceBuffer != nullptr)
+			m_InstanceBuffer->EndFrame();
 
-			//if the mesh has a material send data from that
-			if (renderer.GetMat() != nullptr)
-			{
- 
-				//give openGL the shinniess
-				if (shader->GetFragShaderDefaultStatus() != 8) shader->SetUniform("u_Shininess", renderer.GetMat()->GetShininess());
-				//if they're using a texture
-				if (shader->GetFragShaderDefaultStatus() == 4 || shader->GetFragShaderDefaultStatus() == 5)
-
-				//give openGL the shinniess if it's not a skybox being renderered
-				if(shader->GetFragShaderDefaultStatus() != (int)TTN_DefaultShaders::FRAG_SKYBOX 
-					&& shader->GetFragShaderDefaultStatus() != (int)TTN_DefaultShaders::NOT_DEFAULT)
-					shader->SetUniform("u_Shininess", renderer.GetMat()->GetShininess());
-
-				//texture slot to dynamically send textures across different types of shaders
-				int textureSlot = 0;
-
-				//if they're using a displacement map 
-				if (shader->GetVertexShaderDefaultStatus() == (int)TTN_DefaultShaders::VERT_COLOR_HEIGHTMAP
-					|| shader->GetVertexShaderDefaultStatus() == (int)TTN_DefaultShaders::VERT_NO_COLOR_HEIGHTMAP) 
-				{
-					//bind it to the slot 
-					renderer.GetMat()->GetHeightMap()->Bind(textureSlot);
-					//update the texture slot for future textures to use
-					textureSlot++;
-					//and pass in the influence
-					shader->SetUniform("u_influence", renderer.GetMat()->GetHeightInfluence());
-				}
-						
-				//if they're using an animator 
-				if (shader->GetVertexShaderDefaultStatus() == (int)TTN_DefaultShaders::VERT_MORPH_ANIMATION_NO_COLOR
-					|| shader->GetVertexShaderDefaultStatus() == (int)TTN_DefaultShaders::VERT_MORPH_ANIMATION_COLOR) {
-					//try to get an animator component 
-					if (Has<TTN_MorphAnimator>(entity)) {
-						shader->SetUniform("t", Get<TTN_MorphAnimator>(entity).getActiveAnimRef().getInterpolationParameter());
-					}
-					else
-						shader->SetUniform("t", 0.0f);
-				}
+		TTN_Profiler::AddCount(TTN_ProfileCounter::RENDER_ENTITIES_TESTED, tested);
+		TTN_Profiler::AddCount(TTN_ProfileCounter::RENDER_ENTITIES_CULLED, culled);
+		TTN_Profiler::AddCount(TTN_ProfileCounter::RENDER_ENTITIES_DRAWN, m_RenderGroup->size() - culled);
+	}
 
-				//if they're using an albedo texture 
-				if (shader->GetFragShaderDefaultStatus() == (int)TTN_DefaultShaders::FRAG_BLINN_PHONG_ALBEDO_ONLY 
-					|| shader->GetFragShaderDefaultStatus() == (int)TTN_DefaultShaders::FRAG_BLINN_PHONG_ALBEDO_AND_SPECULAR)
- 
-				{
-					//bind it so openGL can see it
-					renderer.GetMat()->GetAlbedo()->Bind(textureSlot);
-					//update the texture slot for future textures to use
-					textureSlot++;
-				}
- 
-				//if they're using a specular map
-				if (shader->GetFragShaderDefaultStatus() == 5)
+	//checks if an entity's mesh might be visible to the camera
+	bool TTN_Scene::IsInFrustum(TTN_Transform& transform, TTN_Renderer& renderer)
+	{
+		//without a mesh or shader there's nothing to go on, so let it through
+		if (renderer.GetMesh() == nullptr || renderer.GetShader() == nullptr)
+			return true;
+
+		//skyboxes are always around the camera, and custom vertex shaders could move the vertices anywhere, so never cull either
+		int vertShader = renderer.GetShader()->GetVertexShaderDefaultStatus();
+		if (vertShader == (int)TTN_DefaultShaders::VERT_SKYBOX || vertShader == (int)TTN_DefaultShaders::NOT_DEFAULT)
+			return true;
+
+		float radius = renderer.GetMesh()->GetBoundingSphereRadius();
+		//heightmaps push the vertices out along their normals by up to the influence, so grow the sphere to cover that
+		if ((vertShader == (int)TTN_DefaultShaders::VERT_COLOR_HEIGHTMAP || vertShader == (int)TTN_DefaultShaders::VERT_NO_COLOR_HEIGHTMAP)
+			&& renderer.GetMat() != nullptr)
+			radius += glm::abs(renderer.GetMat()->GetHeightInfluence());
+
+		//move the sphere into world space, scaling it by the biggest scale of the transform so it still covers the whole mesh
+		glm::mat4 model = transform.GetGlobal();
+		glm::vec3 center = glm::vec3(model * glm::vec4(renderer.GetMesh()->GetBoundingSphereCenter(), 1.0f));
+		float scale = glm::max(glm::dot(glm::vec3(model[0]), glm::vec3(model[0])), glm::max(glm::dot(glm::vec3(model[1]), glm::vec3(model[1])),
+			glm::dot(glm::vec3(model[2]), glm::vec3(model[2]))));
+
+		return m_Frustum.TestSphere(center, radius * glm::sqrt(scale));
+	}
+
+	//checks if two entities can be drawn with the same instanced draw call
+	bool TTN_Scene::CanInstanceTogether(entt::entity first, entt::entity other)
+	{
+		if (!m_InstancingEnabled) return false;
 
+		TTN_Renderer& firstRenderer = Get<TTN_Renderer>(first);
+		TTN_Renderer& otherRenderer = Get<TTN_Renderer>(other);
 
-				//if they're using a specular map 
-				if (shader->GetFragShaderDefaultStatus() == (int)TTN_DefaultShaders::FRAG_BLINN_PHONG_ALBEDO_AND_SPECULAR)
- 
-				{
-					//bind it so openGL can see it
-					renderer.GetMat()->GetSpecularMap()->Bind(textureSlot);
-					//update the texture slot for future textures to use
-					textureSlot++;
-				}
+		//they need to be drawn exactly the same way
+		if (firstRenderer.GetMesh() != otherRenderer.GetMesh() || firstRenderer.GetShader() != otherRenderer.GetShader()
+			|| firstRenderer.GetRenderLayer() != otherRenderer.GetRenderLayer())
+			return false;
+
+		//with the same material too, unless each instance can look it's material up in the material buffer and sample it's own handles
+		//(bindless handles have to be the same across a draw without GL_NV_gpu_shader5)
+		if (firstRenderer.GetMat() != otherRenderer.GetMat() && (!GetMixedMaterialBatchingActive() || !GetUsesMaterialBuffer(firstRenderer.GetShader())
+			|| firstRenderer.GetMat() == nullptr || otherRenderer.GetMat() == nullptr))
+			return false;
 
-				//if they're using a skybox
-				if (shader->GetFragShaderDefaultStatus() == (int)TTN_DefaultShaders::FRAG_SKYBOX)
-				{
-					//bind the skybox texture
-					renderer.GetMat()->GetSkybox()->Bind(textureSlot);
-					//set the rotation uniform
-					shader->SetUniformMatrix("u_EnvironmentRotation", glm::mat3(glm::rotate(glm::mat4(1.0f), glm::radians(180.0f), glm::vec3(1, 0, 0))));
-					//set the skybox matrix uniform
-					shader->SetUniformMatrix("u_SkyboxMatrix", Get<TTN_Camera>(m_Cam).GetProj() * glm::mat4(glm::mat3(viewMat)));
+		//only the basic default vertex shaders can read their model matrices from the instance buffer
+		int vertShader = firstRenderer.GetShader()->GetVertexShaderDefaultStatus();
+		if (vertShader != (int)TTN_DefaultShaders::VERT_NO_COLOR && vertShader != (int)TTN_DefaultShaders::VERT_COLOR)
+			return false;
+
+		//and morph animations need per entity uniforms, so they can't be batched
+		if (Has<TTN_MorphAnimator>(first) || Has<TTN_MorphAnimator>(other))
+			return false;
+
+		return true;
+	}
+
+	//draws all the entities in the current batch, as one instanced draw if there's more than one
+	void TTN_Scene::RenderBatch(const glm::mat4& vp, const glm::mat4& viewMat)
+	{
+		//if there's nothing to draw, just return
+		if (m_RenderBatch.empty()) return;
+
+		//every entity in the batch uses the same shader and material (or reads their material from the material buffer), so only send the uniforms for the first
+		entt::entity first = m_RenderBatch.front();
+		TTN_Renderer& renderer = Get<TTN_Renderer>(first);
+		{
+			TTN_ProfileScope uniformScope(TTN_ProfilePhase::RENDER_UNIFORMS);
+			SetRenderUniforms(first, renderer, viewMat);
+		}
+
+		TTN_ProfileScope drawScope(TTN_ProfilePhase::RENDER_DRAW);
+
+		//if there's more than one entity, draw them all at once
+		if (m_RenderBatch.size() > 1) {
+			//if the materials come from the material buffer, each instance needs to be told which one is it's
+			const bool materialIndices = GetBindlessActive() && GetUsesMaterialBuffer(renderer.GetShader());
+
+			//write the model and normal matrices of every instance straight into this batch's part of the instance buffer
+			TTN_InstanceData* instances = (TTN_InstanceData*)m_InstanceBuffer->BeginWrite(m_RenderBatch.size());
+			for (size_t i = 0; i < m_RenderBatch.size(); i++) {
+				TTN_InstanceData instance;
+				instance.Model = Get<TTN_Transform>(m_RenderBatch[i]).GetGlobal();
+				instance.NormalMat = glm::mat3(glm::transpose(glm::inverse(instance.Model)));
+				instance.MaterialIndex = 0;
+				if (materialIndices) {
+					auto it = m_MaterialIndices.find(Get<TTN_Renderer>(m_RenderBatch[i]).GetMat().get());
+					if (it != m_MaterialIndices.end())
+						instance.MaterialIndex = it->second;
 				}
 
+				//as one write since mapped memory is slow to read back from
+				instances[i] = instance;
 			}
-			//otherwise send a default shinnies value
-			else if (shader->GetFragShaderDefaultStatus() != (int)TTN_DefaultShaders::NOT_DEFAULT) {
-				shader->SetUniform("u_Shininess", 128.0f);
-			}
+			m_InstanceBuffer->EndWrite();
 
+			//and draw them all, the mesh's instanced vao is only set up the first time
+			renderer.GetMesh()->SetUpInstancedVao(m_InstanceBuffer);
+			renderer.RenderInstanced(m_RenderBatch.size(), m_InstanceBuffer->GetBaseElement());
+		}
+		//otherwise draw it normally
+		else {
 			//if the entity has an animator
-			if (Has<TTN_MorphAnimator>(entity)) {
+			if (Has<TTN_MorphAnimator>(first)) {
 				//set up the vao on the mesh properly
-				renderer.GetMesh()->SetUpVao(Get<TTN_MorphAnimator>(entity).getActiveAnimRef().getCurrentMeshIndex(),
-					Get<TTN_MorphAnimator>(entity).getActiveAnimRef().getNextMeshIndex());
+				renderer.GetMesh()->SetUpVao(Get<TTN_MorphAnimator>(first).getActiveAnimRef().getCurrentMeshIndex(),
+					Get<TTN_MorphAnimator>(first).getActiveAnimRef().getNextMeshIndex());
 			}
 			//if it doesn't
 			else {
@@ -416,8 +705,198 @@ namespace Titan {
 			}
 
 			//and finsih by rendering the mesh
-			renderer.Render(transform.GetGlobal(), vp);
+			renderer.Render(Get<TTN_Transform>(first).GetGlobal(), vp);
+		}
+
+		//clear the batch for the next one
+		m_RenderBatch.clear();
+	}
+
+	//binds the entity's shader and sends the uniforms and textures from it's material
+	void TTN_Scene::SetRenderUniforms(entt::entity entity, TTN_Renderer& renderer, const glm::mat4& viewMat)
+	{
+		//get the shader pointer
+		TTN_Shader::sshptr shader = renderer.GetShader();
+
+		//bind the shader
+		shader->Bind();
+
+		//wheter or not the shader reads the material from the material buffer rather than it's uniforms and texture slots
+		const bool bindless = GetUsesMaterialBuffer(shader) && GetBindlessActive() && renderer.GetMat() != nullptr;
+		if (GetUsesMaterialBuffer(shader))
+			shader->SetUniform("u_Bindless", bindless ? 1 : 0);
+
+		//if the mesh has a material send data from that
+		if (renderer.GetMat() != nullptr)
+		{
+			//give openGL the shinniess if it's not a skybox being renderered (or it's not in the material buffer)
+			if(shader->GetFragShaderDefaultStatus() != (int)TTN_DefaultShaders::FRAG_SKYBOX 
+				&& shader->GetFragShaderDefaultStatus() != (int)TTN_DefaultShaders::NOT_DEFAULT && !bindless)
+				shader->SetUniform("u_Shininess", renderer.GetMat()->GetShininess());
+
+			//if the material is in the material buffer, just tell the shader where (instanced draws get it from the instance data instead)
+			if (bindless) {
+				auto it = m_MaterialIndices.find(renderer.GetMat().get());
+				shader->SetUniform("u_MaterialIndex", (it != m_MaterialIndices.end()) ? (int)it->second : 0);
+			}
+
+			//texture slot to dynamically send textures across different types of shaders
+			int textureSlot = 0;
+
+			//if they're using a displacement map 
+			if (shader->GetVertexShaderDefaultStatus() == (int)TTN_DefaultShaders::VERT_COLOR_HEIGHTMAP
+				|| shader->GetVertexShaderDefaultStatus() == (int)TTN_DefaultShaders::VERT_NO_COLOR_HEIGHTMAP) 
+			{
+				//bind it to the slot 
+				renderer.GetMat()->GetHeightMap()->Bind(textureSlot);
+				//update the texture slot for future textures to use
+				textureSlot++;
+				//and pass in the influence
+				shader->SetUniform("u_influence", renderer.GetMat()->GetHeightInfluence());
+			}
+					
+			//if they're using an animator 
+			if (shader->GetVertexShaderDefaultStatus() == (int)TTN_DefaultShaders::VERT_MORPH_ANIMATION_NO_COLOR
+				|| shader->GetVertexShaderDefaultStatus() == (int)TTN_DefaultShaders::VERT_MORPH_ANIMATION_COLOR) {
+				//try to get an animator component 
+				if (Has<TTN_MorphAnimator>(entity)) {
+					shader->SetUniform("t", Get<TTN_MorphAnimator>(entity).getActiveAnimRef().getInterpolationParameter());
+				}
+				else
+					shader->SetUniform("t", 0.0f);
+			}
+
+			//if they're using an albedo texture (that isn't in the material buffer)
+			if ((shader->GetFragShaderDefaultStatus() == (int)TTN_DefaultShaders::FRAG_BLINN_PHONG_ALBEDO_ONLY 
+				|| shader->GetFragShaderDefaultStatus() == (int)TTN_DefaultShaders::FRAG_BLINN_PHONG_ALBEDO_AND_SPECULAR) && !bindless)
+ 
+			{
+				//bind it so openGL can see it
+				renderer.GetMat()->GetAlbedo()->Bind(textureSlot);
+				//update the texture slot for future textures to use
+				textureSlot++;
+			}
+ 
+			//if they're using a specular map (that isn't in the material buffer)
+			if (shader->GetFragShaderDefaultStatus() == (int)TTN_DefaultShaders::FRAG_BLINN_PHONG_ALBEDO_AND_SPECULAR && !bindless)
+ 
+			{
+				//bind it so openGL can see it
+				renderer.GetMat()->GetSpecularMap()->Bind(textureSlot);
+				//update the texture slot for future textures to use
+				textureSlot++;
+			}
+
+			//if they're using a skybox
+			if (shader->GetFragShaderDefaultStatus() == (int)TTN_DefaultShaders::FRAG_SKYBOX)
+			{
+				//bind the skybox texture
+				renderer.GetMat()->GetSkybox()->Bind(textureSlot);
+				//set the rotation uniform
+				shader->SetUniformMatrix("u_EnvironmentRotation", glm::mat3(glm::rotate(glm::mat4(1.0f), glm::radians(180.0f), glm::vec3(1, 0, 0))));
+				//set the skybox matrix uniform
+				shader->SetUniformMatrix("u_SkyboxMatrix", Get<TTN_Camera>(m_Cam).GetProj() * glm::mat4(glm::mat3(viewMat)));
+			}
+
+		}
+		//otherwise send a default shinnies value
+		else if (shader->GetFragShaderDefaultStatus() != (int)TTN_DefaultShaders::NOT_DEFAULT) {
+			shader->SetUniform("u_Shininess", 128.0f);
+		}
+	}
+
+	//checks if a shader reads it's material from the material buffer when bindless materials are being used, only the textured default
+	//fragment shaders do
+	bool TTN_Scene::GetUsesMaterialBuffer(const TTN_Shader::sshptr& shader)
+	{
+		return shader != nullptr && (shader->GetFragShaderDefaultStatus() == (int)TTN_DefaultShaders::FRAG_BLINN_PHONG_ALBEDO_ONLY
+			|| shader->GetFragShaderDefaultStatus() == (int)TTN_DefaultShaders::FRAG_BLINN_PHONG_ALBEDO_AND_SPECULAR);
+	}
+
+	//gathers every material drawn with a textured default shader into the material buffer and binds it so those shaders can read it
+	void TTN_Scene::UploadMaterials()
+	{
+		//give each material an index the first time it's seen this frame
+		m_MaterialIndices.clear();
+		m_NextMaterialData.clear();
+		m_RenderGroup->each([&](entt::entity, TTN_Transform&, TTN_Renderer& renderer) {
+			if (renderer.GetMat() == nullptr || !GetUsesMaterialBuffer(renderer.GetShader()))
+				return;
+
+			auto result = m_MaterialIndices.emplace(renderer.GetMat().get(), (uint32_t)m_NextMaterialData.size());
+			if (result.second)
+				m_NextMaterialData.push_back(renderer.GetMat()->GetBindlessData());
 		});
+
+		if (m_NextMaterialData.empty())
+			return;
+
+		//make the buffer the first time it's needed
+		if (m_MaterialBuffer == nullptr)
+			m_MaterialBuffer = TTN_ShaderStorageBuffer::Create();
+
+		//only upload it if something's changed since last frame, reallocating the storage if the number of materials changed
+		if (m_NextMaterialData.size() != m_MaterialData.size()) {
+			m_MaterialBuffer->LoadData(m_NextMaterialData.data(), m_NextMaterialData.size());
+		}
+		else if (memcmp(m_NextMaterialData.data(), m_MaterialData.data(), sizeof(TTN_MaterialData) * m_NextMaterialData.size()) != 0) {
+			m_MaterialBuffer->UpdateData(m_NextMaterialData.data(), sizeof(TTN_MaterialData) * m_NextMaterialData.size());
+		}
+		m_MaterialData.swap(m_NextMaterialData);
+
+		//and bind it to the binding point the shaders read from
+		m_MaterialBuffer->Bind((GLuint)TTN_StorageBlockBindings::MATERIAL_DATA_BINDING);
+	}
+
+	//fills the per-frame scene uniform buffer and binds it so all the default shaders can read it
+	void TTN_Scene::UploadSceneUniforms(const glm::mat4& view, const glm::mat4& proj)
+	{
+		//make the buffer the first time it's needed
+		if (m_SceneUniforms == nullptr)
+			m_SceneUniforms = TTN_UniformBuffer::Create();
+
+		TTN_SceneUniformData data;
+
+		//stuff from the camera
+		data.View = view;
+		data.Projection = proj;
+		data.ViewProjection = proj * view;
+		data.CamPos = glm::vec4(Get<TTN_Transform>(m_Cam).GetPos(), 1.0f);
+
+		//scene level ambient lighting
+		data.Ambient = glm::vec4(m_AmbientColor, m_AmbientStrength);
+
+		//stuff from the lights
+		int numOfLights = 0;
+		for (size_t i = 0; i < 16 && i < m_Lights.size(); i++) {
+			auto& light = Get<TTN_Light>(m_Lights[i]);
+			auto& lightTrans = Get<TTN_Transform>(m_Lights[i]);
+			data.LightPos[i] = glm::vec4(lightTrans.GetGlobalPos(), 1.0f);
+			data.LightCol[i] = glm::vec4(light.GetColor(), 1.0f);
+			data.LightStrength[i] = glm::vec4(light.GetAmbientStrength(), light.GetSpecularStrength(), 0.0f, 0.0f);
+			data.LightAttenuation[i] = glm::vec4(light.GetConstantAttenuation(), light.GetLinearAttenuation(),
+				light.GetQuadraticAttenuation(), 0.0f);
+			numOfLights++;
+		}
+		//zero out the unused lights
+		for (int i = numOfLights; i < 16; i++) {
+			data.LightPos[i] = glm::vec4(0.0f);
+			data.LightCol[i] = glm::vec4(0.0f);
+			data.LightStrength[i] = glm::vec4(0.0f);
+			data.LightAttenuation[i] = glm::vec4(0.0f);
+		}
+		//and tell it how many lights there actually are
+		data.NumOfLights = numOfLights;
+		data.padding[0] = data.padding[1] = data.padding[2] = 0;
+
+		//upload it, allocating the storage the first time and just updating it after that
+		if (m_SceneUniforms->GetTotalSize() != sizeof(TTN_SceneUniformData))
+			m_SceneUniforms->LoadData(&data, 1);
+		else
+			m_SceneUniforms->UpdateData(&data, sizeof(TTN_SceneUniformData));
+
+		//and bind it to the binding point the shaders read from
+		m_SceneUniforms->Bind((GLuint)TTN_UniformBlockBindings::SCENE_DATA_BINDING);
 	}
 
 	//sets wheter or not the scene should be rendered
@@ -469,51 +948,259 @@ namespace Titan {
 		return glm::vec3((float)grav.getX(), (float)grav.getY(), (float)grav.getZ());
 	}
 
-	//makes all the collision objects by going through all the overalapping manifolds in bullet
+	//sets wheter or not the transforms of physics bodies are interpolated between the last two physics steps
+	void TTN_Scene::SetPhysicsInterpolation(bool interpolate)
+	{
+		m_physicsWorld->setLatencyMotionStateInterpolation(interpolate);
+	}
+
+	//gets wheter or not the transforms of physics bodies are interpolated between the last two physics steps
+	bool TTN_Scene::GetPhysicsInterpolation()
+	{
+		return m_physicsWorld->getLatencyMotionStateInterpolation();
+	}
+
+	//called by bullet after every physics step
+	void TTN_Scene::PhysicsTickCallback(btDynamicsWorld* world, btScalar)
+	{
+		TTN_Scene* scene = static_cast<TTN_Scene*>(world->getWorldUserInfo());
+		scene->ConstructCollisions();
+	}
+
+	//checks if two entities' physics bodies were touching in the last physics update
+	bool TTN_Scene::GetAreTouching(entt::entity entity1, entt::entity entity2)
+	{
+		uint64_t first = (uint64_t)(uint32_t)std::min(entity1, entity2);
+		uint64_t second = (uint64_t)(uint32_t)std::max(entity1, entity2);
+		return m_lastContactPairs.count((first << 32) | second) != 0;
+	}
+
+	namespace {
+		//gets the entity a collision object belongs to
+		inline entt::entity GetObjectEntity(const btCollisionObject* object) {
+			return static_cast<entt::entity>((uint32_t)reinterpret_cast<uintptr_t>(object->getUserPointer()));
+		}
+
+		//collects the entities of every body the query object touches
+		struct OverlapCallback : public btCollisionWorld::ContactResultCallback {
+			const btCollisionObject* Query;
+			std::vector<entt::entity>* Results;
+
+			btScalar addSingleResult(btManifoldPoint&, const btCollisionObjectWrapper* colObj0Wrap, int, int,
+				const btCollisionObjectWrapper* colObj1Wrap, int, int) override
+			{
+				const btCollisionObject* other = (colObj0Wrap->getCollisionObject() == Query) ? colObj1Wrap->getCollisionObject()
+					: colObj0Wrap->getCollisionObject();
+				entt::entity entity = GetObjectEntity(other);
+				//there's a result for every contact point, so only add each body once
+				if (std::find(Results->begin(), Results->end(), entity) == Results->end())
+					Results->push_back(entity);
+				return 0;
+			}
+		};
+	}
+
+	//casts a ray and gets the closest body it hits
+	TTN_RaycastHit TTN_Scene::Raycast(glm::vec3 from, glm::vec3 to, uint32_t layerMask)
+	{
+		TTN_ProfileScope profileScope(TTN_ProfilePhase::SPATIAL_QUERIES);
+		return CastRay(from, to, layerMask);
+	}
+
+	//casts a ray without timing it, so batches are only timed once
+	TTN_RaycastHit TTN_Scene::CastRay(glm::vec3 from, glm::vec3 to, uint32_t layerMask)
+	{
+		btVector3 rayFrom = btVector3(from.x, from.y, from.z);
+		btVector3 rayTo = btVector3(to.x, to.y, to.z);
+		btCollisionWorld::ClosestRayResultCallback callback(rayFrom, rayTo);
+		//the query is in every group so the bodies' own masks don't hide them, and only finds bodies in the layer mask
+		callback.m_collisionFilterGroup = -1;
+		callback.m_collisionFilterMask = (int)layerMask;
+		m_physicsWorld->rayTest(rayFrom, rayTo, callback);
+
+		TTN_RaycastHit hit;
+		hit.Hit = callback.hasHit();
+		if (hit.Hit) {
+			hit.Entity = GetObjectEntity(callback.m_collisionObject);
+			hit.Point = glm::vec3((float)callback.m_hitPointWorld.getX(), (float)callback.m_hitPointWorld.getY(), (float)callback.m_hitPointWorld.getZ());
+			hit.Normal = glm::vec3((float)callback.m_hitNormalWorld.getX(), (float)callback.m_hitNormalWorld.getY(), (float)callback.m_hitNormalWorld.getZ());
+			hit.Fraction = (float)callback.m_closestHitFraction;
+		}
+		else {
+			hit.Entity = entt::null;
+			hit.Point = to;
+			hit.Normal = glm::vec3(0.0f);
+			hit.Fraction = 1.0f;
+		}
+
+		return hit;
+	}
+
+	//casts a batch of rays
+	void TTN_Scene::RaycastBatch(const std::vector<TTN_Ray>& rays, std::vector<TTN_RaycastHit>& hits, uint32_t layerMask)
+	{
+		TTN_ProfileScope profileScope(TTN_ProfilePhase::SPATIAL_QUERIES);
+		hits.resize(rays.size());
+		for (size_t i = 0; i < rays.size(); i++)
+			hits[i] = CastRay(rays[i].From, rays[i].To, layerMask);
+	}
+
+	//finds the entities whose bodies touch a sphere
+	void TTN_Scene::OverlapSphere(glm::vec3 center, float radius, std::vector<entt::entity>& results, uint32_t layerMask)
+	{
+		m_querySphere.setUnscaledRadius(radius);
+		m_queryObject.setCollisionShape(&m_querySphere);
+
+		btTransform trans;
+		trans.setIdentity();
+		trans.setOrigin(btVector3(center.x, center.y, center.z));
+		m_queryObject.setWorldTransform(trans);
+
+		Overlap(results, layerMask);
+	}
+
+	//finds the entities whose bodies touch a box
+	void TTN_Scene::OverlapBox(glm::vec3 center, glm::vec3 halfExtents, glm::quat rotation, std::vector<entt::entity>& results, uint32_t layerMask)
+	{
+		//the query box is 1 unit out from it's center on each side, so scaling it by the half extents gives the right size
+		m_queryBox.setLocalScaling(btVector3(halfExtents.x, halfExtents.y, halfExtents.z));
+		m_queryObject.setCollisionShape(&m_queryBox);
+
+		btTransform trans;
+		trans.setIdentity();
+		trans.setOrigin(btVector3(center.x, center.y, center.z));
+		trans.setRotation(btQuaternion(rotation.x, rotation.y, rotation.z, rotation.w));
+		m_queryObject.setWorldTransform(trans);
+
+		Overlap(results, layerMask);
+	}
+
+	//finds every body touching the query object, bullet tests the query's bounds against the broadphase tree then checks the shapes of what's inside
+	void TTN_Scene::Overlap(std::vector<entt::entity>& results, uint32_t layerMask)
+	{
+		TTN_ProfileScope profileScope(TTN_ProfilePhase::SPATIAL_QUERIES);
+		results.clear();
+
+		OverlapCallback callback;
+		callback.Query = &m_queryObject;
+		callback.Results = &results;
+		callback.m_collisionFilterGroup = -1;
+		callback.m_collisionFilterMask = (int)layerMask;
+		m_physicsWorld->contactTest(&m_queryObject, callback);
+	}
+
+	//finds the k entities whose bodies are closest to a point
+	void TTN_Scene::FindNearest(glm::vec3 point, size_t k, std::vector<entt::entity>& results, uint32_t layerMask, float maxDistance)
+	{
+		TTN_ProfileScope profileScope(TTN_ProfilePhase::SPATIAL_QUERIES);
+		results.clear();
+		if (k == 0)
+			return;
+
+		//the distance from the point to the bounds of a node, nothing inside it can be closer than this
+		btVector3 target = btVector3(point.x, point.y, point.z);
+		auto boundsDistance = [&target](const btDbvtNode* node) {
+			btVector3 closest = target;
+			closest.setMax(node->volume.Mins());
+			closest.setMin(node->volume.Maxs());
+			return (float)(closest - target).length();
+		};
+
+		//best first search through both of the broadphase's trees (moving and static bodies), always opening whatever's closest next
+		//once a leaf is opened it goes back in with the exact distance to the body, so when it comes out again nothing left can be closer
+		btDbvtBroadphase* broadphase = static_cast<btDbvtBroadphase*>(overlappingPairCache);
+		m_nearestHeap.clear();
+		for (int i = 0; i < 2; i++) {
+			if (broadphase->m_sets[i].m_root != nullptr) {
+				m_nearestHeap.push_back({ boundsDistance(broadphase->m_sets[i].m_root), broadphase->m_sets[i].m_root, false });
+				std::push_heap(m_nearestHeap.begin(), m_nearestHeap.end());
+			}
+		}
+
+		while (!m_nearestHeap.empty() && results.size() < k) {
+			std::pop_heap(m_nearestHeap.begin(), m_nearestHeap.end());
+			NearestNode nearest = m_nearestHeap.back();
+			m_nearestHeap.pop_back();
+			if (nearest.Distance > maxDistance)
+				break;
+
+			const btDbvtNode* node = nearest.Node;
+			if (node->isinternal()) {
+				for (int i = 0; i < 2; i++) {
+					m_nearestHeap.push_back({ boundsDistance(node->childs[i]), node->childs[i], false });
+					std::push_heap(m_nearestHeap.begin(), m_nearestHeap.end());
+				}
+				continue;
+			}
+
+			const btBroadphaseProxy* proxy = static_cast<const btBroadphaseProxy*>(node->data);
+			const btCollisionObject* object = static_cast<const btCollisionObject*>(proxy->m_clientObject);
+			if (nearest.Exact) {
+				results.push_back(GetObjectEntity(object));
+			}
+			else if ((uint32_t)proxy->m_collisionFilterGroup & layerMask) {
+				float distance = (float)(object->getWorldTransform().getOrigin() - target).length();
+				m_nearestHeap.push_back({ distance, node, true });
+				std::push_heap(m_nearestHeap.begin(), m_nearestHeap.end());
+			}
+		}
+	}
+
+	//makes the collision events by going through all the overalapping manifolds in bullet
 	//based on code from https://andysomogyi.github.io/mechanica/bullet.html specfically the first block in the bullet callbacks and triggers section
 	void TTN_Scene::ConstructCollisions()
 	{
-		//clear all the collisions from the previous frame
-		collisions.clear();
+		TTN_ProfileScope profileScope(TTN_ProfilePhase::CONSTRUCT_COLLISIONS);
+
+		//start a new set of pairs for this step (the events are cleared once per update, not every step)
+		m_contactPairs.clear();
 
 		int numManifolds = m_physicsWorld->getDispatcher()->getNumManifolds();
+		TTN_Profiler::AddCount(TTN_ProfileCounter::CONTACT_MANIFOLDS, (uint64_t)numManifolds);
 		//iterate through all the manifolds
 		for (int i = 0; i < numManifolds; i++) {
 			//get the contact manifolds and both objects
 			btPersistentManifold* contactManifold = m_physicsWorld->getDispatcher()->getManifoldByIndexInternal(i);
 
+			//the bodies are only touching if at least one of the contact points is within the contact point distance
+			bool touching = false;
+			int numOfContacts = contactManifold->getNumContacts();
+			for (int j = 0; j < numOfContacts && !touching; j++)
+				touching = contactManifold->getContactPoint(j).getDistance() < 0.f;
+			if (!touching)
+				continue;
+
+			//get the entities and groups, which were saved in bullet so the components don't have to be looked up
 			const btCollisionObject* obj0 = contactManifold->getBody0();
 			const btCollisionObject* obj1 = contactManifold->getBody1();
-
-			//iterate through all the contact points
-			int numOfContacts = contactManifold->getNumContacts();
-			for (int j = 0; j < numOfContacts; j++)
-			{
-				//get the contact point
-				btManifoldPoint& point = contactManifold->getContactPoint(j);
-				//if it's within the contact point distance
-				if (point.getDistance() < 0.f) {
-					//get the rigid bodies
-					const btRigidBody* b0 = btRigidBody::upcast(obj0);
-					const btRigidBody* b1 = btRigidBody::upcast(obj1);
-
-					//and make a collision object
-					TTN_Collision::scolptr newCollision = TTN_Collision::Create();
-					newCollision->SetBody1(static_cast<entt::entity>(reinterpret_cast<uint32_t>(b0->getUserPointer())));
-					newCollision->SetBody2(static_cast<entt::entity>(reinterpret_cast<uint32_t>(b1->getUserPointer())));
-
-					//compare it to all the previous collisions
-					bool shouldAdd = true;
-					for (int k = 0; k < collisions.size(); k++) {
-						if (TTN_Collision::same(newCollision, collisions[k])) {
-							shouldAdd = false;
-							break;
-						}
-					}
-					//if it's a new collision then add to the list of collisions
-					if (shouldAdd) collisions.push_back(newCollision);
-				}
+			uint32_t group0 = (uint32_t)obj0->getUserIndex();
+			uint32_t group1 = (uint32_t)obj1->getUserIndex();
+			if (!(group0 & m_collisionEventMask) || !(group1 & m_collisionEventMask))
+				continue;
+			uint32_t entity0 = (uint32_t)GetObjectEntity(obj0);
+			uint32_t entity1 = (uint32_t)GetObjectEntity(obj1);
+
+			//key the pair with the lower entity first, so the same two bodies always make the same key no matter which is body 0
+			if (entity1 < entity0) {
+				std::swap(entity0, entity1);
+				std::swap(group0, group1);
 			}
+			uint64_t key = ((uint64_t)entity0 << 32) | entity1;
+
+			//if this is the first manifold for the pair this step, and they weren't touching last step, they've just started touching
+			if (m_contactPairs.emplace(key, ((uint64_t)group0 << 32) | group1).second && m_lastContactPairs.count(key) == 0)
+				m_collisionEvents.push_back({ TTN_CollisionEventType::BEGIN, static_cast<entt::entity>(entity0), static_cast<entt::entity>(entity1),
+					group0, group1 });
 		}
+
+		//any pair from the last step that isn't touching anymore has stopped touching
+		for (const auto& pair : m_lastContactPairs) {
+			if (m_contactPairs.count(pair.first) == 0)
+				m_collisionEvents.push_back({ TTN_CollisionEventType::END, static_cast<entt::entity>((uint32_t)(pair.first >> 32)),
+					static_cast<entt::entity>((uint32_t)pair.first), (uint32_t)(pair.second >> 32), (uint32_t)pair.second });
+		}
+
+		//this step's pairs are what the next step compares against
+		std::swap(m_contactPairs, m_lastContactPairs);
 	}
 }
\ No newline at end of file
@@ -1,14 +1,17 @@
 //Titan Engine, by Atlas X Games
 // Shader.cpp - source file for the class that wraps around an openGL shader program
 #include "Titan/Shader.h"
+#include "Titan/ShaderCache.h"
 #include "Logging.h"
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <sstream>
 
 namespace Titan {
 	//default constructor, makes an empty shader program
 	TTN_Shader::TTN_Shader() :
-		_vs(0), _fs(0), _handle(0)
+		_vs(0), _fs(0), _hasTransformFeedback(false), _feedbackBufferMode(GL_INTERLEAVED_ATTRIBS), _handle(0)
 	{
 		_handle = glCreateProgram();
 		setDefault = false;
@@ -27,6 +30,17 @@ namespace Titan {
 		}
 	}
 
+	//gets roughly how many bytes the linked program takes up
+	size_t TTN_Shader::GetMemorySize() const
+	{
+		GLint linked = GL_FALSE, length = 0;
+		glGetProgramiv(_handle, GL_LINK_STATUS, &linked);
+		if (linked == GL_FALSE)
+			return 0;
+		glGetProgramiv(_handle, GL_PROGRAM_BINARY_LENGTH, &length);
+		return (size_t)std::max(length, 0);
+	}
+
 	//Load a shader stage into the pipeline
 	bool TTN_Shader::LoadShaderStage(const char* sourceCode, GLenum shaderType)
 	{
@@ -39,6 +53,21 @@ namespace Titan {
 				fragShaderTTNIdentity = 0;
 		}
 
+		//if the shader cache is on, just hold onto the source for now, Link only compiles it if the program isn't cached
+		if (TTN_ShaderCache::GetActive() && (shaderType == GL_VERTEX_SHADER || shaderType == GL_FRAGMENT_SHADER)) {
+			if (shaderType == GL_VERTEX_SHADER)
+				_vsSource = sourceCode;
+			else
+				_fsSource = sourceCode;
+			return true;
+		}
+
+		return CompileShaderStage(sourceCode, shaderType);
+	}
+
+	//compiles a shader stage
+	bool TTN_Shader::CompileShaderStage(const char* sourceCode, GLenum shaderType)
+	{
 		//Create the new shader steage (vs, fs, etc.)
 		GLuint handle = glCreateShader(shaderType);
 
@@ -106,6 +135,8 @@ namespace Titan {
 		std::stringstream stream;
 		//begin parsing it
 		stream << file.rdbuf();
+		//remember the file for the logs
+		_name += (_name.empty() ? "" : " + ") + std::string(filePath);
 		//use the load function earlier to load the shader from the stream and save if it was sucessful in a boolean
 		bool result = LoadShaderStage(stream.str().c_str(), shaderType);
 		//close the file
@@ -201,14 +232,74 @@ namespace Titan {
 		return result;
 	}
 
+	//set the vertex shader outputs that transform feedback will capture
+	void TTN_Shader::SetTransformFeedbackVaryings(const std::vector<const char*>& varyings, GLenum bufferMode)
+	{
+		glTransformFeedbackVaryings(_handle, (GLsizei)varyings.size(), varyings.data(), bufferMode);
+		_hasTransformFeedback = !varyings.empty();
+		_feedbackVaryings.assign(varyings.begin(), varyings.end());
+		_feedbackBufferMode = bufferMode;
+	}
+
 	bool TTN_Shader::Link()
 	{
-		//if the program doesn't have both a vertex and a fragment shader log an error
-		LOG_ASSERT(_vs != 0 && _fs != 0, "Both a vertex and fragment shader need to be attached to the shader program.");
+		auto start = std::chrono::high_resolution_clock::now();
+
+		//if the stages were held back for the shader cache, try loading the linked program from it before compiling anything
+		const bool cached = !_vsSource.empty();
+		uint64_t cacheKey = 0;
+		if (cached) {
+			cacheKey = TTN_ShaderCache::GetKey(_vsSource, _fsSource, _feedbackVaryings, _feedbackBufferMode);
+			//programs loaded from source rather than files go by their cache file in the logs
+			if (_name.empty())
+				_name = TTN_ShaderCache::GetCachePath(cacheKey);
+			if (TTN_ShaderCache::Load(_handle, cacheKey)) {
+				_vsSource.clear();
+				_fsSource.clear();
+				BindSharedBlocks();
+
+				double time = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+				TTN_ShaderCache::RecordLink(true, time);
+				LOG_INFO("Loaded shader program {} from the shader cache in {:.2f}ms", _name, time);
+				return true;
+			}
+
+			//if it's not there, compile the stages now, and ask the driver to keep the binary around so it can be cached
+			bool compiled = CompileShaderStage(_vsSource.c_str(), GL_VERTEX_SHADER);
+			if (!_fsSource.empty())
+				compiled = CompileShaderStage(_fsSource.c_str(), GL_FRAGMENT_SHADER) && compiled;
+
+			//if either stage failed there's nothing worth linking or caching, so clean up whichever one did compile and stop
+			if (!compiled) {
+				if (_vs != 0) {
+					glDeleteShader(_vs);
+					_vs = 0;
+				}
+				if (_fs != 0) {
+					glDeleteShader(_fs);
+					_fs = 0;
+				}
+				LOG_ERROR("Shader program {} was not linked because a stage failed to compile", _name);
+				return false;
+			}
+			glProgramParameteri(_handle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+			//a rejected binary counts as a failed link, so give the program it's transform feedback outputs again to be safe
+			if (_hasTransformFeedback) {
+				std::vector<const char*> varyings;
+				for (const std::string& varying : _feedbackVaryings)
+					varyings.push_back(varying.c_str());
+				glTransformFeedbackVaryings(_handle, (GLsizei)varyings.size(), varyings.data(), _feedbackBufferMode);
+			}
+		}
+
+		//if the program doesn't have both a vertex and a fragment shader log an error (transform feedback programs only need a vertex shader)
+		LOG_ASSERT(_vs != 0 && (_fs != 0 || _hasTransformFeedback), "Both a vertex and fragment shader need to be attached to the shader program.");
 
 		//Attach our shaders
 		glAttachShader(_handle, _vs);
-		glAttachShader(_handle, _fs);
+		if (_fs != 0)
+			glAttachShader(_handle, _fs);
 
 		//Perform linking
 		glLinkProgram(_handle);
@@ -216,8 +307,10 @@ namespace Titan {
 		//Remove shader stages to save memory (because the shader program has now been compiled we no longer need them seperatedly)
 		glDetachShader(_handle, _vs);
 		glDeleteShader(_vs);
-		glDetachShader(_handle, _fs);
-		glDeleteShader(_fs);
+		if (_fs != 0) {
+			glDetachShader(_handle, _fs);
+			glDeleteShader(_fs);
+		}
 
 		//Setup a check to make sure the shader program compiled and linked correclty
 		GLint status = 0;
@@ -245,11 +338,40 @@ namespace Titan {
 				LOG_ERROR("Shader failed to link for an unknown reason");
 			}
 		}
+		else {
+			BindSharedBlocks();
+
+			//save the binary so the next run can skip all of this
+			if (cached) {
+				_vsSource.clear();
+				_fsSource.clear();
+				TTN_ShaderCache::Save(_handle, cacheKey);
+
+				double time = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+				TTN_ShaderCache::RecordLink(false, time);
+				LOG_INFO("Compiled and linked shader program {} in {:.2f}ms (not in the shader cache)", _name, time);
+			}
+		}
 
 		//return wheter or not the link was sucessful
 		return status != GL_FALSE;
 	}
 
+	//points the program's blocks at titan's shared bindings, block bindings aren't part of a program binary so this is done after
+	//every link, wheter it was compiled or loaded from the cache
+	void TTN_Shader::BindSharedBlocks()
+	{
+		//if the program reads titan's per-frame scene data, point that block at the binding the scene uploads it to
+		GLuint sceneBlockIndex = glGetUniformBlockIndex(_handle, "TTN_SceneData");
+		if (sceneBlockIndex != GL_INVALID_INDEX)
+			glUniformBlockBinding(_handle, sceneBlockIndex, (GLuint)TTN_UniformBlockBindings::SCENE_DATA_BINDING);
+
+		//and the same for titan's material storage block, if it reads that
+		GLuint materialBlockIndex = glGetProgramResourceIndex(_handle, GL_SHADER_STORAGE_BLOCK, "TTN_Materials");
+		if (materialBlockIndex != GL_INVALID_INDEX)
+			glShaderStorageBlockBinding(_handle, materialBlockIndex, (GLuint)TTN_StorageBlockBindings::MATERIAL_DATA_BINDING);
+	}
+
 	//bind the program so we can use it
 	void TTN_Shader::Bind()
 	{
@@ -0,0 +1,163 @@
+//Titan Engine, by Atlas X Games
+// ShaderCache.cpp - source file for the class that saves linked shader programs to disk as program binaries so they don't have to be compiled again
+
+//include the header
+#include "Titan/ShaderCache.h"
+#include "Titan/Hash.h"
+#include "Titan/MappedFile.h"
+#include "Logging.h"
+//import other required features
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace Titan {
+	namespace {
+		//builds a four character code
+		constexpr uint32_t FourCC(char a, char b, char c, char d) {
+			return (uint32_t)(uint8_t)a | ((uint32_t)(uint8_t)b << 8) | ((uint32_t)(uint8_t)c << 16) | ((uint32_t)(uint8_t)d << 24);
+		}
+
+		//the tag at the start of every cached program
+		const uint32_t c_titanTag = FourCC('T', 'T', 'N', 'P');
+		//the version of the file layout, files from other versions are ignored and rewritten
+		const uint32_t c_version = 1;
+
+		//the header before the binary, the key is checked as well as the file name in case of a collision or a renamed file
+		struct BinaryHeader {
+			uint32_t Tag;
+			uint32_t Version;
+			uint64_t Key;
+			uint32_t Format;
+			uint32_t Length;
+		};
+
+		//hashes a string along with it's length, so the strings in a key can't run into each other
+		uint64_t HashString(const std::string& text, uint64_t hash) {
+			uint64_t length = text.size();
+			hash = TTN_Hash::FNV1a(&length, sizeof(length), hash);
+			return TTN_Hash::FNV1a(text.data(), text.size(), hash);
+		}
+	}
+
+	//returns wheter or not the driver can save program binaries
+	bool TTN_ShaderCache::GetSupported()
+	{
+		static const bool supported = []() {
+			GLint formats = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+			return formats > 0;
+		}();
+		return supported;
+	}
+
+	//gets the key for a program linked from the given sources
+	uint64_t TTN_ShaderCache::GetKey(const std::string& vertexSource, const std::string& fragmentSource,
+		const std::vector<std::string>& feedbackVaryings, GLenum feedbackBufferMode)
+	{
+		uint64_t hash = HashString(GetDriverString(), TTN_Hash::FNVOffsetBasis);
+		hash = HashString(vertexSource, hash);
+		hash = HashString(fragmentSource, hash);
+		for (const std::string& varying : feedbackVaryings)
+			hash = HashString(varying, hash);
+		return TTN_Hash::FNV1a(&feedbackBufferMode, sizeof(feedbackBufferMode), hash);
+	}
+
+	//loads the cached binary for a key into a program
+	bool TTN_ShaderCache::Load(GLuint program, uint64_t key)
+	{
+		//make sure the file is one of ours and is for this key
+		TTN_MappedFile file(GetCachePath(key));
+		if (!file.GetIsOpen() || file.GetSize() < sizeof(BinaryHeader))
+			return false;
+		BinaryHeader header;
+		memcpy(&header, file.GetData(), sizeof(BinaryHeader));
+		if (header.Tag != c_titanTag || header.Version != c_version || header.Key != key || header.Length != file.GetSize() - sizeof(BinaryHeader))
+			return false;
+
+		//hand it to the driver, which can still turn it down (it's allowed to stop taking binaries it made for any reason)
+		glProgramBinary(program, header.Format, file.GetData() + sizeof(BinaryHeader), (GLsizei)header.Length);
+		GLint status = GL_FALSE;
+		glGetProgramiv(program, GL_LINK_STATUS, &status);
+		if (status == GL_FALSE) {
+			LOG_WARN("Driver rejected cached shader program {}, compiling it again", GetCachePath(key));
+			s_stats.Rejected++;
+			return false;
+		}
+
+		return true;
+	}
+
+	//saves the binary of a linked program under a key
+	bool TTN_ShaderCache::Save(GLuint program, uint64_t key)
+	{
+		GLint length = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0)
+			return false;
+
+		//read the binary out of the driver
+		std::vector<char> binary((size_t)length);
+		GLenum format = 0;
+		glGetProgramBinary(program, length, &length, &format, binary.data());
+		if (length <= 0)
+			return false;
+
+		BinaryHeader header;
+		header.Tag = c_titanTag;
+		header.Version = c_version;
+		header.Key = key;
+		header.Format = format;
+		header.Length = (uint32_t)length;
+
+		//and write it out
+		std::string fileName = GetCachePath(key);
+		std::error_code error;
+		std::filesystem::create_directories(std::filesystem::path(fileName).parent_path(), error);
+		std::ofstream out = std::ofstream(fileName, std::ios::binary | std::ios::trunc);
+		if (!out) {
+			LOG_WARN("Shader cache could not write {}", fileName);
+			return false;
+		}
+		out.write((const char*)&header, sizeof(BinaryHeader));
+		out.write(binary.data(), length);
+		return (bool)out;
+	}
+
+	//gets the path of the file the binary for a key is saved to
+	std::string TTN_ShaderCache::GetCachePath(uint64_t key)
+	{
+		char keyText[17];
+		snprintf(keyText, sizeof(keyText), "%016llx", (unsigned long long)key);
+		return (std::filesystem::path(s_directory) / (std::string(keyText) + ".bin")).string();
+	}
+
+	//adds a program to the stats
+	void TTN_ShaderCache::RecordLink(bool fromCache, double milliseconds)
+	{
+		if (fromCache) {
+			s_stats.Hits++;
+			s_stats.HitTime += milliseconds;
+		}
+		else {
+			s_stats.Misses++;
+			s_stats.CompileTime += milliseconds;
+		}
+	}
+
+	//gets the vendor, renderer, and version of the driver
+	const std::string& TTN_ShaderCache::GetDriverString()
+	{
+		static const std::string driver = []() {
+			std::string result;
+			for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+				const GLubyte* text = glGetString(name);
+				result += (text != nullptr) ? (const char*)text : "";
+				result += "|";
+			}
+			return result;
+		}();
+		return driver;
+	}
+}
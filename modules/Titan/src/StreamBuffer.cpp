@@ -0,0 +1,124 @@
+//Titan Engine, by Atlas X Games
+// StreamBuffer.cpp - source file for the class that stores a vertex buffer that gets rewritten every frame (like per-instance data)
+
+#include "Titan/StreamBuffer.h"
+#include "Logging.h"
+
+//import other required features
+#include <stdexcept>
+
+namespace Titan {
+	//the flags the persistently mapped buffers are made and mapped with
+	static const GLbitfield s_persistentFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	//constructor, makes the buffer and maps it if it can
+	TTN_StreamBuffer::TTN_StreamBuffer(size_t elementSize, size_t capacity, unsigned numOfRegions)
+		: TTN_VertexBuffer(GL_STREAM_DRAW), m_capacity(capacity), m_region(0), m_written(0), m_partStart(0), m_mapped(nullptr), m_writing(false)
+	{
+		_elementSize = elementSize;
+		_elementCount = capacity;
+
+		m_persistent = GetPersistentMappingSupported() && numOfRegions > 0;
+		m_numOfRegions = m_persistent ? numOfRegions : 1;
+
+		if (m_persistent) {
+			//make immutable storage big enough for every region, and keep it mapped for the life of the buffer
+			GLsizeiptr totalSize = (GLsizeiptr)(elementSize * capacity * m_numOfRegions);
+			glNamedBufferStorage(_handle, totalSize, nullptr, s_persistentFlags);
+			m_mapped = (uint8_t*)glMapNamedBufferRange(_handle, 0, totalSize, s_persistentFlags);
+
+			//if it couldn't be mapped for whatever reason, fall back to orphaning (the storage is immutable so it needs a new buffer)
+			if (m_mapped == nullptr) {
+				LOG_WARN("Failed to persistently map a stream buffer, falling back to orphaning");
+				glDeleteBuffers(1, &_handle);
+				glCreateBuffers(1, &_handle);
+				m_persistent = false;
+				m_numOfRegions = 1;
+			}
+		}
+
+		if (!m_persistent)
+			glNamedBufferData(_handle, (GLsizeiptr)(elementSize * capacity), nullptr, _usage);
+
+		m_fences = std::vector<GLsync>(m_numOfRegions, nullptr);
+	}
+
+	//destructor, unmaps the buffer and deletes the fences (the buffer itself is deleted by the base class)
+	TTN_StreamBuffer::~TTN_StreamBuffer()
+	{
+		for (GLsync& fence : m_fences) {
+			if (fence != nullptr) {
+				glDeleteSync(fence);
+				fence = nullptr;
+			}
+		}
+
+		if ((m_mapped != nullptr || m_writing) && _handle != 0)
+			glUnmapNamedBuffer(_handle);
+	}
+
+	//gets a pointer to write the next part of this frame's data to
+	void* TTN_StreamBuffer::BeginWrite(size_t count)
+	{
+		if (count > m_capacity - m_written) {
+			LOG_ERROR("Tried to write {} elements to a stream buffer that only has room for {} more this frame", count, m_capacity - m_written);
+			throw std::runtime_error("Stream buffer overflow");
+		}
+
+		//this part goes right after the last one
+		m_partStart = m_written;
+		m_written += count;
+
+		if (m_persistent) {
+			//if the gpu might still be reading this region from a few frames ago, wait for it to finish (only the first part can have to)
+			GLsync& fence = m_fences[m_region];
+			if (fence != nullptr) {
+				GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+				while (result == GL_TIMEOUT_EXPIRED)
+					result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+				glDeleteSync(fence);
+				fence = nullptr;
+			}
+
+			return m_mapped + GetBaseElement() * _elementSize;
+		}
+
+		//otherwise orphan the old storage for the first part (so the driver can give us fresh memory instead of waiting for the gpu) and map it,
+		//later parts go into memory nothing has drawn from yet this frame, so they can be mapped without waiting
+		m_writing = true;
+		GLbitfield invalidate = (m_partStart == 0) ? GL_MAP_INVALIDATE_BUFFER_BIT : GL_MAP_INVALIDATE_RANGE_BIT;
+		return glMapNamedBufferRange(_handle, (GLintptr)(m_partStart * _elementSize), (GLsizeiptr)(count * _elementSize),
+			GL_MAP_WRITE_BIT | invalidate | GL_MAP_UNSYNCHRONIZED_BIT);
+	}
+
+	//finishes writing the current part of this frame's data
+	void TTN_StreamBuffer::EndWrite()
+	{
+		//persistent buffers are coherent, so the data is already visible to the gpu, orphaned ones need to be unmapped
+		if (m_writing) {
+			glUnmapNamedBuffer(_handle);
+			m_writing = false;
+		}
+	}
+
+	//fences the region that was just drawn from and moves on to the next one
+	void TTN_StreamBuffer::EndFrame()
+	{
+		m_written = 0;
+		m_partStart = 0;
+
+		if (!m_persistent)
+			return;
+
+		m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		m_region = (m_region + 1) % m_numOfRegions;
+	}
+
+	//checks if the current opengl context supports persistently mapped buffers
+	bool TTN_StreamBuffer::GetPersistentMappingSupported()
+	{
+		//buffer storage and the base instance draws are needed, along with fences
+		return glNamedBufferStorage != nullptr && glMapNamedBufferRange != nullptr && glFenceSync != nullptr &&
+			glClientWaitSync != nullptr && glDrawArraysInstancedBaseInstance != nullptr && glDrawElementsInstancedBaseInstance != nullptr;
+	}
+}
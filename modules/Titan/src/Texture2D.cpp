@@ -3,8 +3,11 @@
 
 //include the header
 #include "Titan/Texture2D.h"
+#include "Titan/TextureCompressor.h"
 //include other required features
 #include <stb_image.h>
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
 
 namespace Titan {
@@ -18,6 +21,32 @@ namespace Titan {
 		if (sourceData != nullptr) {
 			memcpy(_data, sourceData, _dataSize);
 		}
+		_levelOffsets.push_back(0);
+	}
+
+	//creates block compressed data, with each mip level's blocks right after the level before it
+	TTN_Texture2DData::TTN_Texture2DData(uint32_t width, uint32_t height, Texture_Internal_Format compressedFormat, uint32_t numOfLevels, const void* sourceData) :
+		_width(width), _height(height), _type(Texture_Pixel_Data_Type::UByte), _recommendedFormat(compressedFormat), _data(nullptr)
+	{
+		LOG_ASSERT(width > 0 && height > 0, "Width and height must both be greater than zero! Got {}x{}", width, height);
+		LOG_ASSERT(GetIsCompressedFormat(compressedFormat), "Format {} is not a compressed format!", compressedFormat);
+
+		//the pixel format is what the blocks decode to
+		Texture_Internal_Format linearFormat = GetLinearCompressedFormat(compressedFormat);
+		_format = (linearFormat == Texture_Internal_Format::BC1) ? Texture_Pixel_Format::RGB :
+			(linearFormat == Texture_Internal_Format::BC5) ? Texture_Pixel_Format::RG : Texture_Pixel_Format::RGBA;
+
+		_dataSize = 0;
+		for (uint32_t level = 0; level < std::max(numOfLevels, 1u); level++) {
+			_levelOffsets.push_back(_dataSize);
+			_dataSize += GetCompressedLevelSize(compressedFormat, std::max(width >> level, 1u), std::max(height >> level, 1u));
+		}
+
+		_data = malloc(_dataSize);
+		LOG_ASSERT(_data != nullptr, "Failed to allocate texture data!");
+		if (sourceData != nullptr) {
+			memcpy(_data, sourceData, _dataSize);
+		}
 	}
 
 	TTN_Texture2DData::~TTN_Texture2DData()
@@ -27,12 +56,16 @@ namespace Titan {
 
 	TTN_Texture2DData::st2ddptr TTN_Texture2DData::LoadFromFile(const std::string& file, bool flipped, bool forceRgba)
 	{
+		// DDS files are already block compressed, so they're read as they are
+		if (TTN_TextureCompressor::GetIsDDSFile(file))
+			return TTN_TextureCompressor::LoadDDS(file, flipped);
+
 		// Variables that will store properties about our image
 		int width, height, numChannels;
 		const int targetChannels = forceRgba ? 4 : 0;
 
-		// Use STBI to load the image
-		stbi_set_flip_vertically_on_load(flipped);
+		// Use STBI to load the image, it's flip setting is shared by every thread (and textures can be loaded on worker threads)
+		// so it's left alone and the rows are flipped when they're copied out below instead
 		uint8_t* data = stbi_load(file.c_str(), &width, &height, &numChannels, targetChannels);
 
 		// If we could not load any data, warn and return null
@@ -79,7 +112,14 @@ namespace Titan {
 
 		// Create the result and store our image data in it
 		// Note that stbi will always give us an array of unsigned bytes (uint8_t)
-		TTN_Texture2DData::st2ddptr result = std::make_shared<TTN_Texture2DData>(width, height, image_format, Texture_Pixel_Data_Type::UByte, data, internal_format);
+		TTN_Texture2DData::st2ddptr result = std::make_shared<TTN_Texture2DData>(width, height, image_format, Texture_Pixel_Data_Type::UByte,
+			flipped ? nullptr : data, internal_format);
+		if (flipped) {
+			size_t rowSize = (size_t)width * numChannels;
+			uint8_t* dest = (uint8_t*)result->GetDataPtr();
+			for (int row = 0; row < height; row++)
+				memcpy(dest + rowSize * row, data + rowSize * (height - 1 - row), rowSize);
+		}
 		result->DebugName = std::filesystem::path(file).filename().string();
 
 		// We now have a copy in our ptr, we can free STBI's copy of it
@@ -93,19 +133,28 @@ namespace Titan {
 		: TTN_ITexture()
 	{
 		m_data = TTN_Texture2DDesc();
+		m_levels = 1;
 	}
 
 	//constructor that takes in a descpiriton for the texture
 	TTN_Texture2D::TTN_Texture2D(const TTN_Texture2DDesc& description)
 		: TTN_ITexture(), m_data(description)
 	{
+		m_levels = m_data.GenerateMipMaps ? GetNumOfMipLevels(m_data.width, m_data.height) : 1;
 		RecreateTexture();
 	}
 
+	//destructor, the handle has to be let go of before the base class deletes the texture
+	TTN_Texture2D::~TTN_Texture2D()
+	{
+		ReleaseBindlessHandle();
+	}
+
 	//loads a texture in from a file
 	TTN_Texture2D::st2dptr TTN_Texture2D::LoadFromFile(const std::string& fileName, bool flipped, bool forceRgba)
 	{
-		TTN_Texture2DData::st2ddptr data = TTN_Texture2DData::LoadFromFile(fileName, flipped, forceRgba);
+		//the compressor hands back the baked compressed copy if compression is on, or the plain image if it isn't
+		TTN_Texture2DData::st2ddptr data = TTN_TextureCompressor::LoadFromFile(fileName, flipped, forceRgba);
 		LOG_ASSERT(data != nullptr, "Failed to load image from file!");
 		TTN_Texture2D::st2dptr result = TTN_Texture2D::Create();
 		result->LoadData(data);
@@ -114,41 +163,74 @@ namespace Titan {
 
 	void TTN_Texture2D::LoadData(const TTN_Texture2DData::st2ddptr& data)
 	{
+		//opengl can't generate mipmaps for compressed formats, so compressed data brings it's own, otherwise it gets a full chain to generate into
+		uint32_t levels = 1;
+		if (m_data.GenerateMipMaps)
+			levels = data->GetIsCompressed() ? data->GetNumOfLevels() : GetNumOfMipLevels(data->GetWidth(), data->GetHeight());
+
+		//compressed data also has to go into storage of it's own format
+		bool formatChanged = data->GetIsCompressed() ? (m_data.format != data->GetRecommendedFormat())
+			: GetIsCompressedFormat((Texture_Internal_Format)m_data.format);
+
 		if (m_data.width != data->GetWidth() ||
-			m_data.height != data->GetHeight())
+			m_data.height != data->GetHeight() ||
+			m_levels != levels || formatChanged)
 		{
 			m_data.width = data->GetWidth();
 			m_data.height = data->GetHeight();
+			m_levels = levels;
 
-			if (m_data.format == Texture_Internal_Format::Interal_Format_Unknown) {
+			if (m_data.format == Texture_Internal_Format::Interal_Format_Unknown || formatChanged) {
 				m_data.format = data->GetRecommendedFormat();
 			}
 
 			RecreateTexture();
 		}
 
+		// We can get better error logs by attaching an object label!
+		if (!data->DebugName.empty()) {
+			glObjectLabel(GL_TEXTURE, _handle, data->DebugName.length(), data->DebugName.c_str());
+		}
+
+		//compressed data gets each of it's mip levels uploaded as is
+		if (data->GetIsCompressed()) {
+			for (uint32_t level = 0; level < m_levels; level++) {
+				glCompressedTextureSubImage2D(_handle, level, 0, 0, std::max(m_data.width >> level, 1u), std::max(m_data.height >> level, 1u),
+					m_data.format, (GLsizei)data->GetLevelDataSize(level), data->GetLevelDataPtr(level));
+			}
+			return;
+		}
+
 		// Align the data store to the size of a single component in
 		// See https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glPixelStore.xhtml
 		int componentSize = (GLint)GetTexelComponentSize(data->GetPixelType());
-		glPixelStorei(GL_PACK_ALIGNMENT, componentSize);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, componentSize);
 		// Upload our data to our image
 		glTextureSubImage2D(_handle, 0, 0, 0, m_data.width, m_data.height, data->GetFormat(),
 			data->GetPixelType(), data->GetDataPtr());
 
-		// We can get better error logs by attaching an object label!
-		if (!data->DebugName.empty()) {
-			glObjectLabel(GL_TEXTURE, _handle, data->DebugName.length(), data->DebugName.c_str());
-		}
-
-		//mipmaping
-		if (m_data.GenerateMipMaps) {
+		//mipmaping, fills in the rest of the levels from the first one
+		if (m_levels > 1) {
 			glGenerateTextureMipmap(_handle);
 		}
 	}
 
+	//gets roughly how many bytes the texture takes up on the gpu
+	size_t TTN_Texture2D::GetMemorySize() const
+	{
+		size_t size = 0;
+		for (uint32_t level = 0; level < m_levels; level++)
+			size += GetInternalFormatLevelSize((Texture_Internal_Format)m_data.format, std::max(m_data.width >> level, 1u), std::max(m_data.height >> level, 1u));
+		return size;
+	}
+
 	//sets the minification filter
 	void TTN_Texture2D::SetMinFilter(Texture_Min_Filter filter)
 	{
+		if (m_bindlessHandle != 0) {
+			LOG_WARN("Can't change the sampler state of a texture once it has a bindless handle");
+			return;
+		}
 		m_data.minificationFilter = filter;
 		if (_handle != 0)
 			glTextureParameteri(_handle, GL_TEXTURE_MIN_FILTER, (GLenum)m_data.minificationFilter);
@@ -157,6 +239,10 @@ namespace Titan {
 	////sets the magnification filter
 	void TTN_Texture2D::SetMagFilter(Texture_Mag_Filter filter)
 	{
+		if (m_bindlessHandle != 0) {
+			LOG_WARN("Can't change the sampler state of a texture once it has a bindless handle");
+			return;
+		}
 		m_data.magnificationFilter = filter;
 		if (_handle != 0)
 			glTextureParameteri(_handle, GL_TEXTURE_MAG_FILTER, (GLenum)m_data.magnificationFilter);
@@ -165,6 +251,10 @@ namespace Titan {
 	//sets the horizontal wrap mode
 	void TTN_Texture2D::SetHoriWrapMode(Texture_Wrap_Mode mode)
 	{
+		if (m_bindlessHandle != 0) {
+			LOG_WARN("Can't change the sampler state of a texture once it has a bindless handle");
+			return;
+		}
 		m_data.horiWrapMode = mode;
 		if (_handle != 0)
 			glTextureParameteri(_handle, GL_TEXTURE_WRAP_S, (GLenum)m_data.horiWrapMode);
@@ -173,6 +263,10 @@ namespace Titan {
 	//sets the verticla wrap mode
 	void TTN_Texture2D::SetVertWrapMode(Texture_Wrap_Mode mode)
 	{
+		if (m_bindlessHandle != 0) {
+			LOG_WARN("Can't change the sampler state of a texture once it has a bindless handle");
+			return;
+		}
 		m_data.vertWrapMode = mode;
 		if (_handle != 0)
 		glTextureParameteri(_handle, GL_TEXTURE_WRAP_T, (GLenum)m_data.vertWrapMode);
@@ -181,6 +275,10 @@ namespace Titan {
 	//sets the Anisotropic filtering
 	void TTN_Texture2D::SetAnisotropicFiltering(float level)
 	{
+		if (m_bindlessHandle != 0) {
+			LOG_WARN("Can't change the sampler state of a texture once it has a bindless handle");
+			return;
+		}
 		if (level < 0.0f) {
 			level = TTN_Texture2D::GetLimits().MAX_ANISOTROPY;
 		}
@@ -193,6 +291,7 @@ namespace Titan {
 	//recreates the texture in openGL
 	void TTN_Texture2D::RecreateTexture()
 	{
+		ReleaseBindlessHandle();
 		if (_handle != 0) {
 			glDeleteTextures(1, &_handle);
 			_handle = 0;
@@ -206,11 +305,52 @@ namespace Titan {
 
 		if (m_data.width * m_data.height > 0 && m_data.format != Texture_Internal_Format::Interal_Format_Unknown)
 		{
-			glTextureStorage2D(_handle, 1, m_data.format, m_data.width, m_data.height);
+			glTextureStorage2D(_handle, m_levels, m_data.format, m_data.width, m_data.height);
 			glTextureParameteri(_handle, GL_TEXTURE_WRAP_S, (GLenum)m_data.horiWrapMode);
 			glTextureParameteri(_handle, GL_TEXTURE_WRAP_T, (GLenum)m_data.vertWrapMode);
 			glTextureParameteri(_handle, GL_TEXTURE_MIN_FILTER, (GLenum)m_data.minificationFilter);
 			glTextureParameteri(_handle, GL_TEXTURE_MAG_FILTER, (GLenum)m_data.magnificationFilter);
 		}
 	}
+
+	//gets the bindless handle for the texture, making it if it doesn't have one yet
+	GLuint64 TTN_Texture2D::GetBindlessHandle()
+	{
+		//only textures with storage can have handles
+		if (m_bindlessHandle == 0 && _handle != 0 && GetBindlessSupported()
+			&& m_data.width * m_data.height > 0 && m_data.format != Texture_Internal_Format::Interal_Format_Unknown) {
+			m_bindlessHandle = glGetTextureHandleARB(_handle);
+			glMakeTextureHandleResidentARB(m_bindlessHandle);
+		}
+
+		return m_bindlessHandle;
+	}
+
+	//checks the driver's extensions for GL_NV_gpu_shader5 the first time it's asked, glad wasn't generated with it
+	bool TTN_Texture2D::GetNonUniformBindlessSupported()
+	{
+		if (s_nvGpuShader5 < 0) {
+			s_nvGpuShader5 = 0;
+			GLint numOfExtensions = 0;
+			glGetIntegerv(GL_NUM_EXTENSIONS, &numOfExtensions);
+			for (GLint i = 0; i < numOfExtensions; i++) {
+				const char* name = (const char*)glGetStringi(GL_EXTENSIONS, (GLuint)i);
+				if (name != nullptr && strcmp(name, "GL_NV_gpu_shader5") == 0) {
+					s_nvGpuShader5 = 1;
+					break;
+				}
+			}
+		}
+
+		return GetBindlessSupported() && s_nvGpuShader5 == 1;
+	}
+
+	//lets go of the bindless handle
+	void TTN_Texture2D::ReleaseBindlessHandle()
+	{
+		if (m_bindlessHandle != 0) {
+			glMakeTextureHandleNonResidentARB(m_bindlessHandle);
+			m_bindlessHandle = 0;
+		}
+	}
 }
\ No newline at end of file
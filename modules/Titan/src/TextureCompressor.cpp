@@ -0,0 +1,642 @@
+//Titan Engine, by Atlas X Games
+// TextureCompressor.cpp - source file for the class that block compresses textures and reads and writes them as dds files
+
+//include the header
+#include "Titan/TextureCompressor.h"
+#include "Titan/Hash.h"
+#include "Titan/MappedFile.h"
+#include "Titan/ThreadPool.h"
+//import other required features
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace Titan {
+	namespace {
+#pragma region DDS
+		//builds a dds four character code
+		constexpr uint32_t FourCC(char a, char b, char c, char d) {
+			return (uint32_t)(uint8_t)a | ((uint32_t)(uint8_t)b << 8) | ((uint32_t)(uint8_t)c << 16) | ((uint32_t)(uint8_t)d << 24);
+		}
+
+		//the first 4 bytes of every dds file
+		const uint32_t c_ddsMagic = FourCC('D', 'D', 'S', ' ');
+		//the tag titan puts in the first reserved value of the files it writes, so it knows the rest of it's info is there
+		const uint32_t c_titanTag = FourCC('T', 'T', 'N', 'B');
+		//the version of titan's info, baked textures from other versions are rebaked
+		const uint32_t c_version = 1;
+		//flag in titan's info for files whose rows are stored bottom row first
+		const uint32_t c_bottomUp = 1u << 0;
+
+		//header flags
+		const uint32_t c_ddsdCaps = 0x1, c_ddsdHeight = 0x2, c_ddsdWidth = 0x4, c_ddsdPixelFormat = 0x1000, c_ddsdMipMapCount = 0x20000,
+			c_ddsdLinearSize = 0x80000;
+		//pixel format flags
+		const uint32_t c_ddpfFourCC = 0x4;
+		//caps
+		const uint32_t c_capsComplex = 0x8, c_capsTexture = 0x1000, c_capsMipMap = 0x400000;
+		//the dxgi formats that can be read out of a dx10 header
+		const uint32_t c_dxgiBC1 = 71, c_dxgiBC1Srgb = 72, c_dxgiBC3 = 77, c_dxgiBC3Srgb = 78, c_dxgiBC5 = 83;
+		//the resource dimension a dx10 header uses for 2D textures
+		const uint32_t c_dimensionTexture2D = 3;
+
+		struct DDSPixelFormat {
+			uint32_t Size;
+			uint32_t Flags;
+			uint32_t FourCC;
+			uint32_t RGBBitCount;
+			uint32_t RBitMask;
+			uint32_t GBitMask;
+			uint32_t BBitMask;
+			uint32_t ABitMask;
+		};
+
+		//the header after the magic, titan's info goes in Reserved1: the tag, the version, the flags, then the size and timestamp of the
+		//image a baked texture was made from (each split into 2 values)
+		struct DDSHeader {
+			uint32_t Size;
+			uint32_t Flags;
+			uint32_t Height;
+			uint32_t Width;
+			uint32_t PitchOrLinearSize;
+			uint32_t Depth;
+			uint32_t MipMapCount;
+			uint32_t Reserved1[11];
+			DDSPixelFormat PixelFormat;
+			uint32_t Caps;
+			uint32_t Caps2;
+			uint32_t Caps3;
+			uint32_t Caps4;
+			uint32_t Reserved2;
+		};
+
+		//the extra header that follows when the four character code is DX10
+		struct DDSHeaderDX10 {
+			uint32_t DxgiFormat;
+			uint32_t ResourceDimension;
+			uint32_t MiscFlag;
+			uint32_t ArraySize;
+			uint32_t MiscFlags2;
+		};
+
+		//reads the header of a dds file, works out it's format and where the data starts, returns false if titan can't load it
+		bool ReadHeader(const TTN_MappedFile& file, DDSHeader& header, Texture_Internal_Format& format, size_t& dataOffset) {
+			if (!file.GetIsOpen() || file.GetSize() < sizeof(uint32_t) + sizeof(DDSHeader))
+				return false;
+
+			uint32_t magic;
+			memcpy(&magic, file.GetData(), sizeof(uint32_t));
+			memcpy(&header, file.GetData() + sizeof(uint32_t), sizeof(DDSHeader));
+			if (magic != c_ddsMagic || header.Size != sizeof(DDSHeader) || header.Width == 0 || header.Height == 0)
+				return false;
+			dataOffset = sizeof(uint32_t) + sizeof(DDSHeader);
+
+			format = Texture_Internal_Format::Interal_Format_Unknown;
+			if (!(header.PixelFormat.Flags & c_ddpfFourCC))
+				return false;
+
+			uint32_t fourCC = header.PixelFormat.FourCC;
+			if (fourCC == FourCC('D', 'X', 'T', '1'))
+				format = Texture_Internal_Format::BC1;
+			else if (fourCC == FourCC('D', 'X', 'T', '5'))
+				format = Texture_Internal_Format::BC3;
+			else if (fourCC == FourCC('A', 'T', 'I', '2') || fourCC == FourCC('B', 'C', '5', 'U'))
+				format = Texture_Internal_Format::BC5;
+			else if (fourCC == FourCC('D', 'X', '1', '0')) {
+				if (file.GetSize() < dataOffset + sizeof(DDSHeaderDX10))
+					return false;
+				DDSHeaderDX10 dx10;
+				memcpy(&dx10, file.GetData() + dataOffset, sizeof(DDSHeaderDX10));
+				dataOffset += sizeof(DDSHeaderDX10);
+
+				if (dx10.DxgiFormat == c_dxgiBC1)
+					format = Texture_Internal_Format::BC1;
+				else if (dx10.DxgiFormat == c_dxgiBC1Srgb)
+					format = Texture_Internal_Format::BC1_SRGB;
+				else if (dx10.DxgiFormat == c_dxgiBC3)
+					format = Texture_Internal_Format::BC3;
+				else if (dx10.DxgiFormat == c_dxgiBC3Srgb)
+					format = Texture_Internal_Format::BC3_SRGB;
+				else if (dx10.DxgiFormat == c_dxgiBC5)
+					format = Texture_Internal_Format::BC5;
+			}
+
+			return format != Texture_Internal_Format::Interal_Format_Unknown;
+		}
+
+		//writes compressed data out as a dds file with titan's info
+		bool WriteDDS(const std::string& fileName, const TTN_Texture2DData& data, bool flipped, uint64_t sourceSize, int64_t sourceTimestamp) {
+			DDSHeader header = {};
+			header.Size = sizeof(DDSHeader);
+			header.Flags = c_ddsdCaps | c_ddsdHeight | c_ddsdWidth | c_ddsdPixelFormat | c_ddsdMipMapCount | c_ddsdLinearSize;
+			header.Height = data.GetHeight();
+			header.Width = data.GetWidth();
+			header.PitchOrLinearSize = (uint32_t)data.GetLevelDataSize(0);
+			header.MipMapCount = data.GetNumOfLevels();
+			header.Reserved1[0] = c_titanTag;
+			header.Reserved1[1] = c_version;
+			header.Reserved1[2] = flipped ? c_bottomUp : 0;
+			header.Reserved1[3] = (uint32_t)sourceSize;
+			header.Reserved1[4] = (uint32_t)(sourceSize >> 32);
+			header.Reserved1[5] = (uint32_t)(uint64_t)sourceTimestamp;
+			header.Reserved1[6] = (uint32_t)((uint64_t)sourceTimestamp >> 32);
+			header.PixelFormat.Size = sizeof(DDSPixelFormat);
+			header.PixelFormat.Flags = c_ddpfFourCC;
+			DDSHeaderDX10 dx10 = {};
+			switch (data.GetRecommendedFormat()) {
+			case Texture_Internal_Format::BC1_SRGB:
+			case Texture_Internal_Format::BC3_SRGB:
+				header.PixelFormat.FourCC = FourCC('D', 'X', '1', '0');
+				dx10.DxgiFormat = (data.GetRecommendedFormat() == Texture_Internal_Format::BC1_SRGB) ? c_dxgiBC1Srgb : c_dxgiBC3Srgb;
+				dx10.ResourceDimension = c_dimensionTexture2D;
+				dx10.ArraySize = 1;
+				break;
+			case Texture_Internal_Format::BC1:
+				header.PixelFormat.FourCC = FourCC('D', 'X', 'T', '1');
+				break;
+			case Texture_Internal_Format::BC3:
+				header.PixelFormat.FourCC = FourCC('D', 'X', 'T', '5');
+				break;
+			default:
+				header.PixelFormat.FourCC = FourCC('A', 'T', 'I', '2');
+				break;
+			}
+			header.Caps = c_capsTexture | ((data.GetNumOfLevels() > 1) ? (c_capsComplex | c_capsMipMap) : 0);
+
+			std::error_code error;
+			std::filesystem::path parent = std::filesystem::path(fileName).parent_path();
+			if (!parent.empty())
+				std::filesystem::create_directories(parent, error);
+			std::ofstream out = std::ofstream(fileName, std::ios::binary | std::ios::trunc);
+			if (!out) {
+				LOG_WARN("Texture compressor could not write {}", fileName);
+				return false;
+			}
+			out.write((const char*)&c_ddsMagic, sizeof(uint32_t));
+			out.write((const char*)&header, sizeof(DDSHeader));
+			if (header.PixelFormat.FourCC == FourCC('D', 'X', '1', '0'))
+				out.write((const char*)&dx10, sizeof(DDSHeaderDX10));
+			out.write((const char*)data.GetDataPtr(), (std::streamsize)data.GetDataSize());
+			return (bool)out;
+		}
+#pragma endregion
+
+#pragma region Flipping
+		//flips the first few rows of the 2 bit indices in a BC1 color block
+		void FlipColorRows(uint8_t* block, uint32_t rows) {
+			std::reverse(block + 4, block + 4 + rows);
+		}
+
+		//flips the first few rows of the 3 bit indices in a BC4 block (BC3's alpha, or one of BC5's channels), each row is 12 bits
+		void FlipAlphaRows(uint8_t* block, uint32_t rows) {
+			uint64_t bits = 0;
+			for (int i = 0; i < 6; i++)
+				bits |= (uint64_t)block[2 + i] << (8 * i);
+
+			uint64_t flipped = bits;
+			for (uint32_t row = 0; row < rows; row++) {
+				uint64_t rowBits = (bits >> (12 * row)) & 0xFFF;
+				uint32_t target = rows - 1 - row;
+				flipped = (flipped & ~(0xFFFull << (12 * target))) | (rowBits << (12 * target));
+			}
+
+			for (int i = 0; i < 6; i++)
+				block[2 + i] = (uint8_t)(flipped >> (8 * i));
+		}
+
+		//flips the first few rows of pixels inside a block of any of the formats
+		void FlipBlockRows(uint8_t* block, Texture_Internal_Format format, uint32_t rows) {
+			format = GetLinearCompressedFormat(format);
+			if (format == Texture_Internal_Format::BC1)
+				FlipColorRows(block, rows);
+			else if (format == Texture_Internal_Format::BC3) {
+				FlipAlphaRows(block, rows);
+				FlipColorRows(block + 8, rows);
+			}
+			else {
+				FlipAlphaRows(block, rows);
+				FlipAlphaRows(block + 8, rows);
+			}
+		}
+
+		//flips a mip level of compressed data upside down by swapping the rows of blocks and flipping the rows inside each block
+		//returns false if it can't, which is when the level is taller than a block but not a multiple of 4 (the padding would end up on top)
+		bool FlipLevel(uint8_t* level, Texture_Internal_Format format, uint32_t width, uint32_t height) {
+			size_t blockSize = GetCompressedBlockSize(format);
+			uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+			size_t rowSize = blockSize * blocksX;
+
+			//levels shorter than a block just flip the rows they use
+			if (height < 4) {
+				for (uint32_t block = 0; block < blocksX; block++)
+					FlipBlockRows(level + blockSize * block, format, height);
+				return true;
+			}
+			if (height % 4 != 0)
+				return false;
+
+			std::vector<uint8_t> temp = std::vector<uint8_t>(rowSize);
+			for (uint32_t row = 0; row < blocksY / 2; row++) {
+				uint8_t* top = level + rowSize * row;
+				uint8_t* bottom = level + rowSize * (blocksY - 1 - row);
+				memcpy(temp.data(), top, rowSize);
+				memcpy(top, bottom, rowSize);
+				memcpy(bottom, temp.data(), rowSize);
+			}
+			for (uint32_t block = 0; block < blocksX * blocksY; block++)
+				FlipBlockRows(level + blockSize * block, format, 4);
+			return true;
+		}
+#pragma endregion
+
+#pragma region Encoding
+		//turns a color into a 565 color, rounding to the nearest
+		uint16_t To565(const float color[3]) {
+			int r = (int)(std::clamp(color[0], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+			int g = (int)(std::clamp(color[1], 0.0f, 255.0f) * 63.0f / 255.0f + 0.5f);
+			int b = (int)(std::clamp(color[2], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+			return (uint16_t)((r << 11) | (g << 5) | b);
+		}
+
+		//turns a 565 color back into 8 bits a channel
+		void From565(uint16_t color, int out[3]) {
+			int r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+			out[0] = (r << 3) | (r >> 2);
+			out[1] = (g << 2) | (g >> 4);
+			out[2] = (b << 3) | (b >> 2);
+		}
+
+		//encodes the rgb of a 4x4 block of rgba pixels into an 8 byte BC1 block
+		//the end points are the furthest pixels along the line the colors spread out along the most, then each pixel gets the closest of the 4 colors
+		void EncodeColorBlock(const uint8_t pixels[16][4], uint8_t* out) {
+			float mean[3] = { 0.0f, 0.0f, 0.0f };
+			for (int i = 0; i < 16; i++)
+				for (int c = 0; c < 3; c++)
+					mean[c] += pixels[i][c] / 16.0f;
+
+			//the covariance of the colors
+			float cov[3][3] = {};
+			for (int i = 0; i < 16; i++) {
+				float d[3] = { pixels[i][0] - mean[0], pixels[i][1] - mean[1], pixels[i][2] - mean[2] };
+				for (int a = 0; a < 3; a++)
+					for (int b = 0; b < 3; b++)
+						cov[a][b] += d[a] * d[b];
+			}
+
+			//a few rounds of power iteration to find the axis the colors are spread out along the most
+			float axis[3] = { 0.57735f, 0.57735f, 0.57735f };
+			for (int iteration = 0; iteration < 8; iteration++) {
+				float next[3];
+				for (int a = 0; a < 3; a++)
+					next[a] = cov[a][0] * axis[0] + cov[a][1] * axis[1] + cov[a][2] * axis[2];
+				float length = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2]);
+				//if the colors are all the same there's no axis, the end points will be the same either way
+				if (length < 1e-6f)
+					break;
+				for (int a = 0; a < 3; a++)
+					axis[a] = next[a] / length;
+			}
+
+			float minT = 0.0f, maxT = 0.0f;
+			for (int i = 0; i < 16; i++) {
+				float t = (pixels[i][0] - mean[0]) * axis[0] + (pixels[i][1] - mean[1]) * axis[1] + (pixels[i][2] - mean[2]) * axis[2];
+				minT = std::min(minT, t);
+				maxT = std::max(maxT, t);
+			}
+			float end0[3], end1[3];
+			for (int c = 0; c < 3; c++) {
+				end0[c] = mean[c] + axis[c] * maxT;
+				end1[c] = mean[c] + axis[c] * minT;
+			}
+
+			//the first color has to be the bigger one for the block to use 4 colors
+			uint16_t color0 = To565(end0), color1 = To565(end1);
+			if (color0 < color1)
+				std::swap(color0, color1);
+
+			uint32_t indices = 0;
+			if (color0 != color1) {
+				int palette[4][3];
+				From565(color0, palette[0]);
+				From565(color1, palette[1]);
+				for (int c = 0; c < 3; c++) {
+					palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+					palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+				}
+
+				for (int i = 0; i < 16; i++) {
+					int best = 0, bestDistance = INT32_MAX;
+					for (int p = 0; p < 4; p++) {
+						int dr = pixels[i][0] - palette[p][0], dg = pixels[i][1] - palette[p][1], db = pixels[i][2] - palette[p][2];
+						int distance = dr * dr + dg * dg + db * db;
+						if (distance < bestDistance) {
+							bestDistance = distance;
+							best = p;
+						}
+					}
+					indices |= (uint32_t)best << (2 * i);
+				}
+			}
+
+			out[0] = (uint8_t)color0;
+			out[1] = (uint8_t)(color0 >> 8);
+			out[2] = (uint8_t)color1;
+			out[3] = (uint8_t)(color1 >> 8);
+			for (int i = 0; i < 4; i++)
+				out[4 + i] = (uint8_t)(indices >> (8 * i));
+		}
+
+		//encodes one channel of a 4x4 block of rgba pixels into an 8 byte BC4 block, using the channel's min and max as the end points
+		void EncodeChannelBlock(const uint8_t pixels[16][4], int channel, uint8_t* out) {
+			uint8_t min = 255, max = 0;
+			for (int i = 0; i < 16; i++) {
+				min = std::min(min, pixels[i][channel]);
+				max = std::max(max, pixels[i][channel]);
+			}
+
+			uint64_t indices = 0;
+			if (max != min) {
+				//the first value being bigger means there are 6 values between the end points
+				int palette[8] = { max, min };
+				for (int p = 2; p < 8; p++)
+					palette[p] = ((8 - p) * max + (p - 1) * min) / 7;
+
+				for (int i = 0; i < 16; i++) {
+					int best = 0, bestDistance = INT32_MAX;
+					for (int p = 0; p < 8; p++) {
+						int distance = std::abs(pixels[i][channel] - palette[p]);
+						if (distance < bestDistance) {
+							bestDistance = distance;
+							best = p;
+						}
+					}
+					indices |= (uint64_t)best << (3 * i);
+				}
+			}
+
+			out[0] = max;
+			out[1] = min;
+			for (int i = 0; i < 6; i++)
+				out[2 + i] = (uint8_t)(indices >> (8 * i));
+		}
+
+		//encodes a whole level of rgba pixels, the blocks on the right and top edges repeat the last pixel if the size isn't a multiple of 4
+		void EncodeLevel(const std::vector<uint8_t>& pixels, uint32_t width, uint32_t height, Texture_Internal_Format format, uint8_t* out) {
+			size_t blockSize = GetCompressedBlockSize(format);
+			uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+			format = GetLinearCompressedFormat(format);
+
+			//every row of blocks is independent, so they're spread over the shared pool
+			TTN_ThreadPool::GetShared().ParallelFor(blocksY, 8, [&](size_t begin, size_t end) {
+				uint8_t block[16][4];
+				for (size_t by = begin; by < end; by++) {
+					for (uint32_t bx = 0; bx < blocksX; bx++) {
+						for (uint32_t y = 0; y < 4; y++) {
+							uint32_t py = std::min((uint32_t)by * 4 + y, height - 1);
+							for (uint32_t x = 0; x < 4; x++) {
+								uint32_t px = std::min(bx * 4 + x, width - 1);
+								memcpy(block[y * 4 + x], &pixels[((size_t)py * width + px) * 4], 4);
+							}
+						}
+
+						uint8_t* dest = out + (by * blocksX + bx) * blockSize;
+						if (format == Texture_Internal_Format::BC1)
+							EncodeColorBlock(block, dest);
+						else if (format == Texture_Internal_Format::BC3) {
+							EncodeChannelBlock(block, 3, dest);
+							EncodeColorBlock(block, dest + 8);
+						}
+						else {
+							EncodeChannelBlock(block, 0, dest);
+							EncodeChannelBlock(block, 1, dest + 8);
+						}
+					}
+				}
+			});
+		}
+
+		//halves a level of rgba pixels by averaging each 2x2 square, sides of 1 pixel stay at 1
+		void Downsample(const std::vector<uint8_t>& pixels, uint32_t width, uint32_t height, std::vector<uint8_t>& out) {
+			uint32_t newWidth = std::max(width / 2, 1u), newHeight = std::max(height / 2, 1u);
+			out.resize((size_t)newWidth * newHeight * 4);
+			for (uint32_t y = 0; y < newHeight; y++) {
+				uint32_t y0 = std::min(y * 2, height - 1), y1 = std::min(y * 2 + 1, height - 1);
+				for (uint32_t x = 0; x < newWidth; x++) {
+					uint32_t x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+					for (int c = 0; c < 4; c++) {
+						int sum = pixels[((size_t)y0 * width + x0) * 4 + c] + pixels[((size_t)y0 * width + x1) * 4 + c]
+							+ pixels[((size_t)y1 * width + x0) * 4 + c] + pixels[((size_t)y1 * width + x1) * 4 + c];
+						out[((size_t)y * newWidth + x) * 4 + c] = (uint8_t)((sum + 2) / 4);
+					}
+				}
+			}
+		}
+#pragma endregion
+
+		//reads the data out of a dds file whose header has already been read, flipping it if the rows aren't in the order that was asked for
+		TTN_Texture2DData::st2ddptr ReadData(const TTN_MappedFile& file, const DDSHeader& header, Texture_Internal_Format format,
+			size_t dataOffset, bool flipped, const std::string& fileName)
+		{
+			uint32_t levels = (header.Flags & c_ddsdMipMapCount) ? std::max(header.MipMapCount, 1u) : 1;
+			levels = std::min(levels, GetNumOfMipLevels(header.Width, header.Height));
+
+			TTN_Texture2DData::st2ddptr data = std::make_shared<TTN_Texture2DData>(header.Width, header.Height, format, levels, nullptr);
+			if (file.GetSize() < dataOffset + data->GetDataSize()) {
+				LOG_WARN("DDS file \"{}\" is missing some of it's data", fileName);
+				return nullptr;
+			}
+			uint8_t* dest = (uint8_t*)data->GetDataPtr();
+			memcpy(dest, file.GetData() + dataOffset, data->GetDataSize());
+
+			bool bottomUp = header.Reserved1[0] == c_titanTag && (header.Reserved1[2] & c_bottomUp);
+			if (bottomUp != flipped) {
+				bool flippedAll = true;
+				for (uint32_t level = 0; level < levels; level++) {
+					uint8_t* levelData = dest + ((const uint8_t*)data->GetLevelDataPtr(level) - (const uint8_t*)data->GetDataPtr());
+					flippedAll &= FlipLevel(levelData, format, std::max(header.Width >> level, 1u), std::max(header.Height >> level, 1u));
+				}
+				if (!flippedAll)
+					LOG_WARN("DDS file \"{}\" has mip levels that aren't a multiple of 4 pixels tall, they'll be upside down", fileName);
+			}
+
+			data->DebugName = std::filesystem::path(fileName).filename().string();
+			return data;
+		}
+	}
+
+	//loads the data for a 2D texture from an image, compressed if compression is on
+	TTN_Texture2DData::st2ddptr TTN_TextureCompressor::LoadFromFile(const std::string& fileName, bool flipped, bool forceRgba)
+	{
+		if (!s_enabled || forceRgba || GetIsDDSFile(fileName))
+			return TTN_Texture2DData::LoadFromFile(fileName, flipped, forceRgba);
+
+		//use the baked copy if it was made from the image as it is now
+		uint64_t sourceSize = 0;
+		int64_t sourceTimestamp = 0;
+		bool haveInfo = TTN_Hash::GetFileInfo(fileName, sourceSize, sourceTimestamp);
+		std::string cachePath = GetCachePath(fileName, flipped);
+		if (haveInfo) {
+			TTN_MappedFile baked(cachePath);
+			DDSHeader header;
+			Texture_Internal_Format format;
+			size_t dataOffset;
+			if (ReadHeader(baked, header, format, dataOffset) && header.Reserved1[0] == c_titanTag && header.Reserved1[1] == c_version
+				&& (header.Reserved1[3] | ((uint64_t)header.Reserved1[4] << 32)) == sourceSize
+				&& (int64_t)(header.Reserved1[5] | ((uint64_t)header.Reserved1[6] << 32)) == sourceTimestamp) {
+				TTN_Texture2DData::st2ddptr data = ReadData(baked, header, format, dataOffset, flipped, cachePath);
+				if (data != nullptr) {
+					data->DebugName = std::filesystem::path(fileName).filename().string();
+					return data;
+				}
+			}
+		}
+
+		//otherwise load the image and compress it, if it can't be compressed just use the image
+		TTN_Texture2DData::st2ddptr image = TTN_Texture2DData::LoadFromFile(fileName, flipped, false);
+		if (image == nullptr)
+			return nullptr;
+		TTN_Texture2DData::st2ddptr compressed = Compress(*image);
+		if (compressed == nullptr)
+			return image;
+		compressed->DebugName = image->DebugName;
+
+		//and bake it so the next load can skip decoding and encoding
+		if (haveInfo)
+			WriteDDS(cachePath, *compressed, flipped, sourceSize, sourceTimestamp);
+
+		return compressed;
+	}
+
+	//picks the format an image would be compressed to
+	Texture_Internal_Format TTN_TextureCompressor::ChooseFormat(const TTN_Texture2DData& image)
+	{
+		if (image.GetIsCompressed() || image.GetPixelType() != Texture_Pixel_Data_Type::UByte)
+			return Texture_Internal_Format::Interal_Format_Unknown;
+
+		switch (image.GetFormat()) {
+		case Texture_Pixel_Format::RG:
+			return Texture_Internal_Format::BC5;
+		case Texture_Pixel_Format::RGB:
+		case Texture_Pixel_Format::BGR:
+			return Texture_Internal_Format::BC1;
+		case Texture_Pixel_Format::RGBA:
+		case Texture_Pixel_Format::BGRA: {
+			//lots of images have an alpha channel that's all opaque, those don't need the bigger format
+			const uint8_t* pixels = (const uint8_t*)image.GetDataPtr();
+			size_t numOfPixels = (size_t)image.GetWidth() * image.GetHeight();
+			for (size_t i = 0; i < numOfPixels; i++) {
+				if (pixels[i * 4 + 3] != 255)
+					return Texture_Internal_Format::BC3;
+			}
+			return Texture_Internal_Format::BC1;
+		}
+		default:
+			return Texture_Internal_Format::Interal_Format_Unknown;
+		}
+	}
+
+	//compresses an uncompressed image, with a full mip chain
+	TTN_Texture2DData::st2ddptr TTN_TextureCompressor::Compress(const TTN_Texture2DData& image, Texture_Internal_Format format)
+	{
+		if (format == Texture_Internal_Format::Interal_Format_Unknown)
+			format = ChooseFormat(image);
+		if (!GetIsCompressedFormat(format) || image.GetIsCompressed() || image.GetPixelType() != Texture_Pixel_Data_Type::UByte)
+			return nullptr;
+
+		//expand the image to rgba so every format can read it the same way
+		const uint32_t width = image.GetWidth(), height = image.GetHeight();
+		const size_t numOfPixels = (size_t)width * height;
+		const int channels = GetTexelComponentCount(image.GetFormat());
+		const bool swapRedBlue = image.GetFormat() == Texture_Pixel_Format::BGR || image.GetFormat() == Texture_Pixel_Format::BGRA;
+		if (channels < 1 || channels > 4)
+			return nullptr;
+
+		const uint8_t* source = (const uint8_t*)image.GetDataPtr();
+		std::vector<uint8_t> pixels = std::vector<uint8_t>(numOfPixels * 4);
+		for (size_t i = 0; i < numOfPixels; i++) {
+			const uint8_t* in = source + i * channels;
+			uint8_t* out = &pixels[i * 4];
+			//single channel images are treated as grey
+			out[0] = in[0];
+			out[1] = (channels >= 2) ? in[1] : in[0];
+			out[2] = (channels >= 3) ? in[2] : (channels == 1) ? in[0] : 0;
+			out[3] = (channels == 4) ? in[3] : 255;
+			if (swapRedBlue)
+				std::swap(out[0], out[2]);
+		}
+
+		//encode every level, halving the pixels after each one
+		const uint32_t levels = GetNumOfMipLevels(width, height);
+		std::vector<size_t> levelOffsets;
+		size_t totalSize = 0;
+		for (uint32_t level = 0; level < levels; level++) {
+			levelOffsets.push_back(totalSize);
+			totalSize += GetCompressedLevelSize(format, std::max(width >> level, 1u), std::max(height >> level, 1u));
+		}
+
+		std::vector<uint8_t> blocks = std::vector<uint8_t>(totalSize);
+		std::vector<uint8_t> nextPixels;
+		for (uint32_t level = 0; level < levels; level++) {
+			uint32_t levelWidth = std::max(width >> level, 1u), levelHeight = std::max(height >> level, 1u);
+			EncodeLevel(pixels, levelWidth, levelHeight, format, blocks.data() + levelOffsets[level]);
+
+			if (level + 1 < levels) {
+				Downsample(pixels, levelWidth, levelHeight, nextPixels);
+				pixels.swap(nextPixels);
+			}
+		}
+
+		TTN_Texture2DData::st2ddptr result = std::make_shared<TTN_Texture2DData>(width, height, format, levels, blocks.data());
+		result->DebugName = image.DebugName;
+		return result;
+	}
+
+	//checks a file's extension against .dds, ignoring case
+	bool TTN_TextureCompressor::GetIsDDSFile(const std::string& fileName)
+	{
+		std::string extension = std::filesystem::path(fileName).extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+		return extension == ".dds";
+	}
+
+	//loads a compressed dds file
+	TTN_Texture2DData::st2ddptr TTN_TextureCompressor::LoadDDS(const std::string& fileName, bool flipped)
+	{
+		TTN_MappedFile file(fileName);
+		DDSHeader header;
+		Texture_Internal_Format format;
+		size_t dataOffset;
+		if (!ReadHeader(file, header, format, dataOffset)) {
+			LOG_WARN("Failed to load \"{}\", only BC1, BC3, and BC5 dds files are supported", fileName);
+			return nullptr;
+		}
+
+		return ReadData(file, header, format, dataOffset, flipped, fileName);
+	}
+
+	//writes compressed data out to a dds file
+	bool TTN_TextureCompressor::SaveDDS(const std::string& fileName, const TTN_Texture2DData& data, bool flipped)
+	{
+		if (!data.GetIsCompressed())
+			return false;
+
+		return WriteDDS(fileName, data, flipped, 0, 0);
+	}
+
+	//gets the path of the baked copy of an image, named after the image and a hash of it's path and orientation
+	std::string TTN_TextureCompressor::GetCachePath(const std::string& fileName, bool flipped)
+	{
+		uint64_t hash = TTN_Hash::FNV1a(fileName.data(), fileName.size());
+		hash = TTN_Hash::FNV1a(flipped ? "1" : "0", 1, hash);
+
+		char hashText[17];
+		snprintf(hashText, sizeof(hashText), "%016llx", (unsigned long long)hash);
+		std::string name = std::filesystem::path(fileName).stem().string();
+		return (std::filesystem::path(s_directory) / (name + "_" + hashText + ".dds")).string();
+	}
+}
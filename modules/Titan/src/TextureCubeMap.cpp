@@ -5,6 +5,7 @@
 #include "Titan/TextureCubeMap.h"
 //include other required features
 #include <stb_image.h>
+#include <algorithm>
 #include <filesystem>
 
 namespace Titan {
@@ -80,7 +81,11 @@ namespace Titan {
 
 	void TTN_TextureCubeMapData::LoadFaceData(const TTN_Texture2DData::st2ddptr& data, CubeMapFace face)
 	{
-		if (data != nullptr) {
+		//faces are copied pixel by pixel, so they can't be block compressed
+		if (data != nullptr && data->GetIsCompressed()) {
+			LOG_WARN("Data for face {} is compressed, cubemap faces have to be uncompressed images, ignoring", face);
+		}
+		else if (data != nullptr) {
 			LOG_ASSERT(data->GetWidth() == data->GetHeight() && data->GetWidth() == _size, "Data is not square or does not match size of cubemap! {}x{} vs {}", data->GetWidth(), data->GetHeight(), _size);
 			LOG_ASSERT(data->GetFormat() == _format, "Data format does not match! {} vs {}", data->GetFormat(), _format);
 			LOG_ASSERT(data->GetPixelType() == _type, "Data pixel type does not match! {} vs {}", data->GetPixelType(), _type);
@@ -126,7 +131,7 @@ namespace Titan {
 		// Align the data store to the size of a single component in
 		// See https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glPixelStore.xhtml
 		int componentSize = (GLint)GetTexelComponentSize(data->GetPixelType());
-		glPixelStorei(GL_PACK_ALIGNMENT, componentSize);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, componentSize);
 		// Upload our data to our image
 		glTextureSubImage3D(_handle, 0, 0, 0, 0, m_data.Size, m_data.Size, 6, data->GetPixelFormat(), data->GetPixelType(), data->GetDataPtr());
 
@@ -144,6 +149,16 @@ namespace Titan {
 		return result;
 	}
 
+	//gets roughly how many bytes the texture takes up on the gpu
+	size_t TTN_TextureCubeMap::GetMemorySize() const
+	{
+		uint32_t levels = m_data.GenerateMipMaps ? GetNumOfMipLevels(m_data.Size, m_data.Size) : 1;
+		size_t size = 0;
+		for (uint32_t level = 0; level < levels; level++)
+			size += GetInternalFormatLevelSize(m_data.Format, std::max(m_data.Size >> level, 1u), std::max(m_data.Size >> level, 1u));
+		return size * 6;
+	}
+
 	//sets the minification filter
 	void TTN_TextureCubeMap::SetMinFilter(Texture_Min_Filter filter)
 	{
@@ -173,7 +188,8 @@ namespace Titan {
 		glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &_handle);
 		if (m_data.Size > 0 && m_data.Format != Texture_Internal_Format::Interal_Format_Unknown)
 		{
-			glTextureStorage2D(_handle, 1, m_data.Format, m_data.Size, m_data.Size);
+			//a full mip chain if it's generating mipmaps, otherwise there'd be nothing to generate them into
+			glTextureStorage2D(_handle, m_data.GenerateMipMaps ? GetNumOfMipLevels(m_data.Size, m_data.Size) : 1, m_data.Format, m_data.Size, m_data.Size);
 			glTextureParameteri(_handle, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 			glTextureParameteri(_handle, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 			glTextureParameteri(_handle, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
@@ -0,0 +1,143 @@
+//Titan Engine, by Atlas X Games
+// ThreadPool.cpp - source file for the class that keeps a set of worker threads around to run jobs on
+
+#include "Titan/ThreadPool.h"
+
+//import other required features
+#include <algorithm>
+
+namespace Titan {
+	namespace {
+		//the chunks of one ParallelFor call, whichever thread gets to a chunk first runs it
+		//the queued jobs keep it alive, since they can still be waiting in the queue after the call has run every chunk itself and returned
+		struct ParallelForChunks {
+			std::mutex mutex;
+			std::condition_variable done;
+			size_t count = 0;
+			size_t chunkSize = 0;
+			size_t numOfChunks = 0;
+			//the next chunk nobody has started yet, and how many have finished
+			size_t next = 0;
+			size_t finished = 0;
+
+			//runs the next chunk nobody has started yet, returns false if they've all been started
+			bool RunNext(const std::function<void(size_t, size_t)>* function)
+			{
+				size_t chunk;
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					if (next == numOfChunks) return false;
+					chunk = next++;
+				}
+
+				size_t begin = chunk * chunkSize;
+				(*function)(begin, std::min(begin + chunkSize, count));
+
+				std::lock_guard<std::mutex> lock(mutex);
+				if (++finished == numOfChunks)
+					done.notify_all();
+				return true;
+			}
+		};
+	}
+
+	//gets the pool shared by the whole engine
+	TTN_ThreadPool& TTN_ThreadPool::GetShared()
+	{
+		static TTN_ThreadPool sharedPool;
+		return sharedPool;
+	}
+
+	//constructor, starts the worker threads
+	TTN_ThreadPool::TTN_ThreadPool(unsigned numOfThreads)
+	{
+		//if no number was given, use every core but the main thread's
+		if (numOfThreads == 0) {
+			unsigned cores = std::thread::hardware_concurrency();
+			numOfThreads = (cores > 1) ? cores - 1 : 1;
+		}
+
+		m_workers.reserve(numOfThreads);
+		for (unsigned i = 0; i < numOfThreads; i++)
+			m_workers.emplace_back(&TTN_ThreadPool::WorkerLoop, this);
+	}
+
+	//destructor, finishes the queued jobs and stops the workers
+	TTN_ThreadPool::~TTN_ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+		m_jobAdded.notify_all();
+
+		for (std::thread& worker : m_workers)
+			worker.join();
+	}
+
+	//adds a job to the queue
+	void TTN_ThreadPool::Push(std::function<void()> job)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_jobs.push(std::move(job));
+		}
+		m_jobAdded.notify_one();
+	}
+
+	//splits a range into chunks and runs them across the workers and the calling thread
+	void TTN_ThreadPool::ParallelFor(size_t count, size_t minChunkSize, const std::function<void(size_t, size_t)>& function)
+	{
+		if (count == 0) return;
+
+		//work out how many chunks to split it into, no more than one for each thread (including this one)
+		minChunkSize = std::max(minChunkSize, (size_t)1);
+		size_t numOfChunks = std::min((size_t)m_workers.size() + 1, (count + minChunkSize - 1) / minChunkSize);
+
+		//if it's not worth splitting up, just do it here
+		if (numOfChunks <= 1) {
+			function(0, count);
+			return;
+		}
+
+		std::shared_ptr<ParallelForChunks> chunks = std::make_shared<ParallelForChunks>();
+		chunks->count = count;
+		chunks->chunkSize = (count + numOfChunks - 1) / numOfChunks;
+		chunks->numOfChunks = numOfChunks;
+
+		//queue up a job for every chunk but one, each runs whichever chunk is next (if the calling thread hasn't gotten to them all first)
+		//the function is only called after a chunk is claimed, and this call doesn't return until every claimed chunk is done, so it's still around
+		const std::function<void(size_t, size_t)>* functionPtr = &function;
+		for (size_t chunk = 1; chunk < numOfChunks; chunk++)
+			Push([chunks, functionPtr]() { chunks->RunNext(functionPtr); });
+
+		//run chunks on this thread until they've all been started, only this call's chunks, so it can't get stuck running some other long job
+		while (chunks->RunNext(functionPtr)) {}
+
+		//then wait for the workers to finish the ones they started
+		std::unique_lock<std::mutex> lock(chunks->mutex);
+		chunks->done.wait(lock, [&chunks]() { return chunks->finished == chunks->numOfChunks; });
+	}
+
+	//the loop each worker runs
+	void TTN_ThreadPool::WorkerLoop()
+	{
+		while (true) {
+			std::function<void()> job;
+			{
+				//wait for a job (or to be told to stop)
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_jobAdded.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+
+				//only stop once the queue is empty
+				if (m_jobs.empty())
+					return;
+
+				job = std::move(m_jobs.front());
+				m_jobs.pop();
+			}
+
+			job();
+		}
+	}
+}
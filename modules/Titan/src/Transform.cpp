@@ -12,29 +12,29 @@ namespace Titan {
 		m_pos = glm::vec3(0.0f, 0.0f, 0.0f);
 		m_scale = glm::vec3(1.0f, 1.0f, 1.0f);
 		m_rotation = glm::quat(glm::radians(glm::vec3(0.0f, 0.0f, 0.0f)));
-		m_Parent = nullptr;
-		m_parentEntity = nullptr;
-		m_Children = std::vector<TTN_Transform*>();
+		m_hasParent = false;
 		Recompute();
+		//work out the matrices straight away so a transform that never makes it into a scene still has them
+		RecomputeLocal();
+		m_global = m_transform;
 	}
 
 	//constructor that takes all the data and makes a transform out of it
-	TTN_Transform::TTN_Transform(glm::vec3 pos, glm::vec3 rotation, glm::vec3 scale, TTN_Transform* parent, entt::entity* parentEntity)
+	TTN_Transform::TTN_Transform(glm::vec3 pos, glm::vec3 rotation, glm::vec3 scale)
 	{
 		m_pos = pos;
 		m_rotation = glm::quat(glm::radians(rotation));
 		m_scale = scale;
-
-		m_Parent = parent;
-		m_parentEntity = parentEntity;
-		m_Children = std::vector<TTN_Transform*>();
+		m_hasParent = false;
 
 		Recompute();
+		//work out the matrices straight away so a transform that never makes it into a scene still has them
+		RecomputeLocal();
+		m_global = m_transform;
 	}
 
 	TTN_Transform::~TTN_Transform()
 	{
-		SetParent(nullptr, nullptr);
 	}
 
 	//sets the position to the value passed in
@@ -63,28 +63,6 @@ namespace Titan {
 		Recompute();
 	}
 
-	//sets the transform that acts as this object's parent
-	void TTN_Transform::SetParent(TTN_Transform* parent, entt::entity* parentEntity)
-	{
-		//if this tranform already had a parent
-		if (m_Parent != nullptr) {
-			//remove this object from it's child list
-			m_Parent->RemoveChild(this);
-		}
-
-		//set the new parent
-		m_Parent = parent;
-		m_parentEntity = parentEntity;
-
-		if (m_Parent != nullptr) {
-			//add this object as a child of the new parent
-			m_Parent->AddChild(this);
-			Recompute();
-		}
-
-		
-	}
-
 	//returns the position value
 	glm::vec3 TTN_Transform::GetPos()
 	{
@@ -93,7 +71,7 @@ namespace Titan {
 
 	glm::vec3 TTN_Transform::GetGlobalPos()
 	{
-		return m_global * glm::vec4(0,0,0,1);
+		return GetGlobal() * glm::vec4(0,0,0,1);
 	}
 
 	//returns the scale value
@@ -110,19 +88,19 @@ namespace Titan {
 	//returns the 4x4 matrix representing the combiation of all other elements
 	glm::mat4 TTN_Transform::GetMatrix()
 	{
+		RecomputeLocal();
 		return m_transform;
 	}
 
 	//returns the 4x4 matrix reprensenting the combination of all other elements in global space
 	glm::mat4 TTN_Transform::GetGlobal()
 	{
-		return m_global;
-	}
+		//without a parent the global and local transforms are the same, so it can always be up to date
+		if (!m_hasParent)
+			return GetMatrix();
 
-	//returns a pointer to this object's parent
-	TTN_Transform* TTN_Transform::GetParent()
-	{
-		return m_Parent;
+		//otherwise it's the one the scene worked out in it's last world matrix pass
+		return m_global;
 	}
 
 	void TTN_Transform::RotateRelative(glm::vec3 rotation)
@@ -149,47 +127,23 @@ namespace Titan {
 		Recompute();
 	}
 
+	//marks the transform as dirty, the matrices get rebuilt when they're next needed
 	void TTN_Transform::Recompute()
 	{
+		m_localDirty = true;
+		m_changed = true;
+	}
+
+	//rebuilds the local matrix if it's out of date
+	void TTN_Transform::RecomputeLocal()
+	{
+		if (!m_localDirty) return;
+
 		//convert the position, rotation, and scale into their matrix forms and multiplys them together into the overall local transform matrix
 		m_transform = glm::translate(m_pos) *
 			glm::toMat4(m_rotation) *
 			glm::scale(m_scale);
 
-		//check if the object has a parent
-		if (m_Parent != nullptr) {
-			//if it does then use it to caculate the global transformation matrix
-			m_global = m_Parent->GetGlobal() * m_transform;
-
-			//repeat on all the children (this is will do forward kinematics) 
-			for (int i = 0; i < m_Children.size(); i++) {
-				m_Children[i]->Recompute();
-			}
-		}
-		else {
-			//if it doesn't then the global and local transforms must be the same
-			m_global = m_transform;
-		}
-
-		
-	}
-
-	//adds a child to this object
-	void TTN_Transform::AddChild(TTN_Transform* child)
-	{
-		m_Children.push_back(child);
-	}
-
-	//removes a child from the object
-	void TTN_Transform::RemoveChild(TTN_Transform* child)
-	{
-		//go through all the children of the object
-		for (int i = 0; i < m_Children.size(); i++) {
-			//and check for the one that matches the given child
-			if (m_Children[i] == child) {
-				//when it's found erase it from the vector and break
-				m_Children.erase(m_Children.begin() + i);
-			}
-		}
+		m_localDirty = false;
 	}
 }
\ No newline at end of file
@@ -78,7 +78,12 @@ namespace Titan {
 		//send the data on them to openGL 
 		for (const BufferAttribute& attrib : attributes) {
 			glEnableVertexArrayAttrib(_handle, attrib.Slot);
-			glVertexAttribPointer(attrib.Slot, attrib.Size, attrib.Type, attrib.Normalized, attrib.Stride, (void*)attrib.Offset);
+			//integers that aren't normalized stay integers, so shaders can read them as ints and uints rather than floats
+			if (!attrib.Normalized && (attrib.Type == GL_BYTE || attrib.Type == GL_UNSIGNED_BYTE || attrib.Type == GL_SHORT
+				|| attrib.Type == GL_UNSIGNED_SHORT || attrib.Type == GL_INT || attrib.Type == GL_UNSIGNED_INT))
+				glVertexAttribIPointer(attrib.Slot, attrib.Size, attrib.Type, attrib.Stride, (void*)attrib.Offset);
+			else
+				glVertexAttribPointer(attrib.Slot, attrib.Size, attrib.Type, attrib.Normalized, attrib.Stride, (void*)attrib.Offset);
 			if (attrib.attribDivisor != 0) glVertexAttribDivisor(attrib.Slot, attrib.attribDivisor);
 		}
 		//unbind the vbo
@@ -137,18 +142,23 @@ namespace Titan {
 	}
 
 	//calls the openGL functions to acutally draw the triangles contained within the VAO, but does so with instancing
-	void TTN_VertexArrayObject::RenderInstanced(size_t numOfObjects, size_t numOfVerts) const
+	void TTN_VertexArrayObject::RenderInstanced(size_t numOfObjects, size_t numOfVerts, size_t baseInstance) const
 	{
 		//bind the VAO so we can use it
 		Bind();
+		//work out how many vertices to draw
+		GLsizei vertCount = (numOfVerts == 0) ? _vertexCount : (GLsizei)numOfVerts;
 		//check if the VAO has an IBO bound to it 
-		if (_ibo != nullptr)
+		if (_ibo != nullptr) {
 			//if it does, then use the ibo to draw the triangles
-			glDrawElementsInstanced(GL_TRIANGLES, _ibo->GetElementCount(), _ibo->GetElementType(), nullptr, numOfObjects);
-		else
+			if (baseInstance == 0) glDrawElementsInstanced(GL_TRIANGLES, _ibo->GetElementCount(), _ibo->GetElementType(), nullptr, numOfObjects);
+			else glDrawElementsInstancedBaseInstance(GL_TRIANGLES, _ibo->GetElementCount(), _ibo->GetElementType(), nullptr, numOfObjects, (GLuint)baseInstance);
+		}
+		else {
 			//otherwise it must only have vbos, so use those vbos to draw the triangles
-			if(numOfVerts == 0) glDrawArraysInstanced(GL_TRIANGLES, 0, _vertexCount, numOfObjects);
-			else glDrawArraysInstanced(GL_TRIANGLES, 0, numOfVerts, numOfObjects);
+			if (baseInstance == 0) glDrawArraysInstanced(GL_TRIANGLES, 0, vertCount, numOfObjects);
+			else glDrawArraysInstancedBaseInstance(GL_TRIANGLES, 0, vertCount, numOfObjects, (GLuint)baseInstance);
+		}
 		//unbind the VAO
 		UnBind();
 	}
@@ -0,0 +1,39 @@
+//Titan Benchmarks, by Atlas X Games
+//Benchmarks.cpp, the source file with the helpers shared by all the benchmark suites
+#include "Benchmarks.h"
+
+//import other required features
+#include <algorithm>
+#include <cstdio>
+
+//gets a percentile (0-1) out of a list of timings
+double Percentile(std::vector<double> values, double p) {
+	if (values.empty()) return 0.0;
+	std::sort(values.begin(), values.end());
+	size_t index = (size_t)(p * (double)(values.size() - 1) + 0.5);
+	return values[index];
+}
+
+//gets the average of a list of timings
+double Mean(const std::vector<double>& values) {
+	if (values.empty()) return 0.0;
+	double total = 0.0;
+	for (double v : values) total += v;
+	return total / (double)values.size();
+}
+
+//prints the header of a results table
+void PrintHeader(const char* firstColumn) {
+	printf("  %-24s %10s %10s %10s %10s\n", firstColumn, "mean", "p50", "p95", "p99");
+}
+
+//prints one row of a results table
+void PrintRow(const char* name, const std::vector<double>& values) {
+	printf("  %-24s %10.3f %10.3f %10.3f %10.3f\n", name, Mean(values), Percentile(values, 0.5),
+		Percentile(values, 0.95), Percentile(values, 0.99));
+}
+
+//gets the milliseconds between two points in time
+double MillisecondsBetween(std::chrono::high_resolution_clock::time_point start, std::chrono::high_resolution_clock::time_point end) {
+	return std::chrono::duration<double, std::milli>(end - start).count();
+}
@@ -0,0 +1,41 @@
+//Titan Benchmarks, by Atlas X Games
+//Benchmarks.h, the header file with the shared helpers and the entry points for each benchmark suite
+#pragma once
+
+//import required titan features
+#include "Titan/Application.h"
+#include "Titan/HeadlessGL.h"
+#include "Titan/Profiler.h"
+
+//import other required features
+#include <chrono>
+#include <vector>
+
+using namespace Titan;
+
+//gets a percentile (0-1) out of a list of timings
+double Percentile(std::vector<double> values, double p);
+//gets the average of a list of timings
+double Mean(const std::vector<double>& values);
+//prints the header of a results table
+void PrintHeader(const char* firstColumn);
+//prints one row of a results table
+void PrintRow(const char* name, const std::vector<double>& values);
+//gets the milliseconds between two points in time
+double MillisecondsBetween(std::chrono::high_resolution_clock::time_point start, std::chrono::high_resolution_clock::time_point end);
+
+//the benchmark suites, each takes the command line arguments after the suite name
+//usage: Benchmarks scene [frames] [entity count] [entity count] ...
+int RunSceneBenchmark(int argc, char** argv);
+//usage: Benchmarks transforms [frames] [entity count] [chain length]
+int RunTransformBenchmark(int argc, char** argv);
+//usage: Benchmarks particles [frames] [particle count] [particle count] ...
+int RunParticleBenchmark(int argc, char** argv);
+//usage: Benchmarks models [repeats] [folder], the folder defaults to models (relative to the working directory)
+int RunObjBenchmark(int argc, char** argv);
+//usage: Benchmarks physics [frames] [bodies spawned per frame] [bodies spawned per frame] ...
+int RunPhysicsBenchmark(int argc, char** argv);
+//usage: Benchmarks solver [frames] [body count] [body count] ...
+int RunSolverBenchmark(int argc, char** argv);
+//usage: Benchmarks textures [repeats] [folder], the folder defaults to textures (relative to the working directory)
+int RunTextureBenchmark(int argc, char** argv);
@@ -0,0 +1,168 @@
+//Titan Benchmarks, by Atlas X Games
+//ObjBenchmark.cpp, the source file for the benchmark that times loading every obj file in a folder, comparing the mapped and indexed loader
+//to the line by line stringstream loader titan used to have, and to loading the baked copy from the mesh cache
+#include "Benchmarks.h"
+#include "Titan/ObjLoader.h"
+#include "Titan/MeshCache.h"
+
+//import other required features
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace {
+//settings for an obj benchmark run
+struct ObjBenchmarkSettings {
+	//number of times to load each file
+	int repeats = 5;
+	//the folder to search for obj files (including it's subfolders)
+	std::string folder = "models";
+};
+
+//the old loader, reads the file line by line and makes a new stringstream for each line, then builds the mesh without any indices
+//kept here (without the trimming, which only ever removed whitespace) so the new one has something to be compared to
+TTN_Mesh::smptr LoadLegacy(const std::string& fileName) {
+	std::vector<glm::vec3> vertexPos;
+	std::vector<glm::vec2> vertexUV;
+	std::vector<glm::vec3> vertexNorms;
+	std::vector<GLint> vertexPosIndices;
+	std::vector<GLint> vertexUvsIndices;
+	std::vector<GLint> vertexNormIndices;
+
+	std::ifstream file;
+	file.open(fileName, std::ios::binary);
+	std::string line;
+	while (std::getline(file, line)) {
+		if (line.substr(0, 2) == "v ") {
+			std::istringstream ss = std::istringstream(line.substr(2));
+			vertexPos.push_back(glm::vec3(1.0f));
+			ss >> vertexPos.back().x >> vertexPos.back().y >> vertexPos.back().z;
+		}
+		else if (line.substr(0, 2) == "vt") {
+			std::istringstream ss = std::istringstream(line.substr(2));
+			vertexUV.push_back(glm::vec2(1.0f));
+			ss >> vertexUV.back().x >> vertexUV.back().y;
+		}
+		else if (line.substr(0, 2) == "vn") {
+			std::istringstream ss = std::istringstream(line.substr(2));
+			vertexNorms.push_back(glm::vec3(1.0f));
+			ss >> vertexNorms.back().x >> vertexNorms.back().y >> vertexNorms.back().z;
+		}
+		else if (line.substr(0, 1) == "f") {
+			int counter = 0;
+			GLint temp;
+			std::istringstream ss = std::istringstream(line.substr(1));
+			while (ss >> temp) {
+				if (counter == 0) vertexPosIndices.push_back(temp);
+				else if (counter == 1) vertexUvsIndices.push_back(temp);
+				else if (counter == 2) vertexNormIndices.push_back(temp);
+
+				if (ss.peek() == '/') {
+					counter++;
+					ss.ignore(1, '/');
+				}
+				else if (ss.peek() == ' ') {
+					counter++;
+					ss.ignore(1, ' ');
+				}
+				if (counter > 2)
+					counter = 0;
+			}
+		}
+	}
+
+	//out of range indices are clamped, the old loader just read past the end of the vectors
+	auto get = [](const auto& values, GLint index) { return values[std::clamp(index - 1, 0, std::max((int)values.size() - 1, 0))]; };
+	std::vector<glm::vec3> meshVertPos = std::vector<glm::vec3>(vertexPosIndices.size());
+	std::vector<glm::vec2> meshVertUvs = std::vector<glm::vec2>(vertexUvsIndices.size());
+	std::vector<glm::vec3> meshVertNorms = std::vector<glm::vec3>(vertexNormIndices.size());
+	for (size_t i = 0; i < meshVertPos.size() && !vertexPos.empty(); i++) meshVertPos[i] = get(vertexPos, vertexPosIndices[i]);
+	for (size_t i = 0; i < meshVertUvs.size() && !vertexUV.empty(); i++) meshVertUvs[i] = get(vertexUV, vertexUvsIndices[i]);
+	for (size_t i = 0; i < meshVertNorms.size() && !vertexNorms.empty(); i++) meshVertNorms[i] = get(vertexNorms, vertexNormIndices[i]);
+
+	TTN_Mesh::smptr newMesh = TTN_Mesh::Create();
+	newMesh->AddVertices(meshVertPos);
+	newMesh->AddNormals(meshVertNorms);
+	newMesh->SetUVs(meshVertUvs);
+	return newMesh;
+}
+
+//finds every obj file in the folder and it's subfolders, sorted so runs are comparable
+std::vector<std::string> FindObjFiles(const std::string& folder) {
+	std::vector<std::string> files;
+	std::error_code error;
+	for (auto it = std::filesystem::recursive_directory_iterator(folder, error); !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+		if (it->is_regular_file() && it->path().extension() == ".obj")
+			files.push_back(it->path().string());
+	}
+	std::sort(files.begin(), files.end());
+	return files;
+}
+}
+
+//runs the obj loading benchmark
+int RunObjBenchmark(int argc, char** argv) {
+	//read the settings from the command line
+	ObjBenchmarkSettings settings;
+	if (argc > 0) settings.repeats = std::max(1, atoi(argv[0]));
+	if (argc > 1) settings.folder = argv[1];
+
+	std::vector<std::string> files = FindObjFiles(settings.folder);
+	if (files.empty()) {
+		printf("no obj files found in \"%s\"\n", settings.folder.c_str());
+		return 1;
+	}
+
+	//time loading every file with both loaders and from the cache, the totals are over the whole folder
+	//the loader is timed with the cache off so it acutally parses, then every file is baked before the cache is timed
+	std::vector<double> legacyTotals, loaderTotals, cacheTotals;
+	printf("\n%zu obj files in \"%s\", %d repeats (times in ms, vertex counts from the last load)\n", files.size(), settings.folder.c_str(), settings.repeats);
+	printf("  %-40s %10s %10s %10s %10s %10s\n", "file", "legacy", "loader", "cache", "old verts", "new verts");
+	for (int repeat = 0; repeat < settings.repeats; repeat++) {
+		double legacyTotal = 0.0, loaderTotal = 0.0, cacheTotal = 0.0;
+		for (const std::string& file : files) {
+			auto start = std::chrono::high_resolution_clock::now();
+			TTN_Mesh::smptr legacy = LoadLegacy(file);
+			auto middle = std::chrono::high_resolution_clock::now();
+			TTN_MeshCache::SetEnabled(false);
+			TTN_Mesh::smptr loaded = TTN_ObjLoader::LoadFromFile(file);
+			TTN_MeshCache::SetEnabled(true);
+			auto end = std::chrono::high_resolution_clock::now();
+
+			TTN_MeshCache::Save({ file }, *loaded);
+			auto cacheStart = std::chrono::high_resolution_clock::now();
+			TTN_Mesh::smptr cached = TTN_MeshCache::Load({ file });
+			auto cacheEnd = std::chrono::high_resolution_clock::now();
+
+			double legacyTime = MillisecondsBetween(start, middle);
+			double loaderTime = MillisecondsBetween(middle, end);
+			double cacheTime = MillisecondsBetween(cacheStart, cacheEnd);
+			legacyTotal += legacyTime;
+			loaderTotal += loaderTime;
+			cacheTotal += cacheTime;
+
+			if (repeat == settings.repeats - 1) {
+				std::string name = std::filesystem::path(file).filename().string();
+				printf("  %-40s %10.3f %10.3f %10.3f %10d %10d\n", name.c_str(), legacyTime, loaderTime, cacheTime, legacy->GetVertCount(),
+					(cached != nullptr) ? cached->GetVertCount() : loaded->GetVertCount());
+			}
+		}
+		legacyTotals.push_back(legacyTotal);
+		loaderTotals.push_back(loaderTotal);
+		cacheTotals.push_back(cacheTotal);
+	}
+
+	printf("\nwhole folder (times in ms)\n");
+	PrintHeader("loader");
+	PrintRow("legacy stringstream", legacyTotals);
+	PrintRow("mapped + indexed", loaderTotals);
+	PrintRow("baked cache", cacheTotals);
+	printf("  %-24s %10.2fx\n", "speedup", Mean(legacyTotals) / std::max(Mean(loaderTotals), 0.000001));
+	printf("  %-24s %10.2fx\n", "cache speedup", Mean(loaderTotals) / std::max(Mean(cacheTotals), 0.000001));
+
+	return 0;
+}
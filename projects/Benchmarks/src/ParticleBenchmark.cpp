@@ -0,0 +1,170 @@
+//Titan Benchmarks, by Atlas X Games
+//ParticleBenchmark.cpp, the source file for the benchmark that times particle system bursts and updates, single threaded and on the thread pool,
+//the cost of streaming the instance data to the gpu, and the cpu cost of the gpu (transform feedback) backend
+#include "Benchmarks.h"
+
+//import required titan features
+#include "Titan/ThreadPool.h"
+#include "Titan/StreamBuffer.h"
+#include "GLM/gtc/matrix_transform.hpp"
+
+//import other required features
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+//settings for a particle benchmark run
+struct ParticleBenchmarkSettings {
+	//number of frames to throw away before recording
+	int warmupFrames = 10;
+	//number of frames to record
+	int frames = 200;
+	//the time step for each frame
+	float deltaTime = 1.0f / 60.0f;
+	//the particle counts to test
+	std::vector<size_t> particleCounts = { 1000, 10000, 100000 };
+};
+
+//makes a particle system that can hold the given number of particles
+//if churn is on, particles live for about a second and are constantly replaced, otherwise they stay alive for the whole run
+TTN_ParticleSystem::spsptr MakeParticleSystem(size_t maxParticles, bool churn, TTN_ParticleBackend backend = TTN_ParticleBackend::CPU) {
+	TTN_ParticleTemplate particle = TTN_ParticleTemplate();
+	particle.SetTwoStartSpeeds(1.0f, 3.0f);
+	particle.SetTwoEndSpeeds(0.0f, 0.5f);
+	particle.SetTwoStartColors(glm::vec4(1.0f, 0.5f, 0.0f, 1.0f), glm::vec4(1.0f, 1.0f, 0.0f, 1.0f));
+	particle.SetOneEndColor(glm::vec4(0.2f, 0.2f, 0.2f, 0.0f));
+	if (churn)
+		particle.SetTwoLifetimes(0.5f, 1.5f);
+	else
+		particle.SetOneLifetime(1000.0f);
+
+	//churning systems emit their whole capacity every second, the others only ever burst
+	float emissionRate = churn ? (float)maxParticles : 0.0f;
+	TTN_ParticleSystem::spsptr system = std::make_shared<TTN_ParticleSystem>(maxParticles, emissionRate, particle, 1.0f, true, backend);
+	system->MakeConeEmitter(15.0f);
+
+	return system;
+}
+
+//times the updates of one particle system, with the given multithreading threshold
+void RunUpdates(const char* name, size_t count, bool churn, size_t threshold, const ParticleBenchmarkSettings& settings) {
+	TTN_ParticleSystem::SetMultithreadThreshold(threshold);
+	TTN_ParticleSystem::spsptr system = MakeParticleSystem(count, churn);
+
+	//fill it up
+	auto start = std::chrono::high_resolution_clock::now();
+	system->Burst(count);
+	std::vector<double> burstTime = { MillisecondsBetween(start, std::chrono::high_resolution_clock::now()) };
+
+	//and time the updates
+	std::vector<double> updateTimes;
+	std::vector<double> aliveCounts;
+	for (int frame = 0; frame < settings.warmupFrames + settings.frames; frame++) {
+		start = std::chrono::high_resolution_clock::now();
+		system->Update(settings.deltaTime);
+		auto end = std::chrono::high_resolution_clock::now();
+
+		if (frame >= settings.warmupFrames) {
+			updateTimes.push_back(MillisecondsBetween(start, end));
+			aliveCounts.push_back((double)system->GetNumOfAliveParticles());
+		}
+	}
+
+	char rowName[64];
+	snprintf(rowName, sizeof(rowName), "%s burst", name);
+	PrintRow(rowName, burstTime);
+	snprintf(rowName, sizeof(rowName), "%s update", name);
+	PrintRow(rowName, updateTimes);
+	printf("  %-24s %10.0f\n", "average alive", Mean(aliveCounts));
+}
+
+//times rendering one full particle system, including writing its instance data, and reports how much data went to the gpu each frame
+void RunRender(const char* name, size_t count, const ParticleBenchmarkSettings& settings) {
+	TTN_ParticleSystem::spsptr system = MakeParticleSystem(count, false);
+	system->Burst(count);
+
+	glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, -10.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	glm::mat4 proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.01f, 100.0f);
+
+	std::vector<double> renderTimes;
+	std::vector<double> bytesUploaded;
+	for (int frame = 0; frame < settings.warmupFrames + settings.frames; frame++) {
+		TTN_Profiler::BeginFrame();
+		system->Update(settings.deltaTime);
+
+		auto start = std::chrono::high_resolution_clock::now();
+		system->Render(glm::vec3(0.0f), view, proj);
+		auto end = std::chrono::high_resolution_clock::now();
+
+		if (frame >= settings.warmupFrames) {
+			renderTimes.push_back(MillisecondsBetween(start, end));
+			bytesUploaded.push_back((double)TTN_Profiler::GetCount(TTN_ProfileCounter::PARTICLE_BYTES_UPLOADED));
+		}
+	}
+
+	PrintRow(name, renderTimes);
+	printf("  %-24s %10.0f\n", "average bytes uploaded", Mean(bytesUploaded));
+}
+
+//times a whole frame (update and render) of a churning particle system on the gpu backend, which should barely depend on the particle count
+void RunGPU(const char* name, size_t count, const ParticleBenchmarkSettings& settings) {
+	TTN_ParticleSystem::spsptr system = MakeParticleSystem(count, true, TTN_ParticleBackend::GPU);
+	system->Burst(count);
+
+	glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, -10.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	glm::mat4 proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.01f, 100.0f);
+
+	std::vector<double> frameTimes;
+	for (int frame = 0; frame < settings.warmupFrames + settings.frames; frame++) {
+		auto start = std::chrono::high_resolution_clock::now();
+		system->Update(settings.deltaTime);
+		system->Render(glm::vec3(0.0f), view, proj);
+		auto end = std::chrono::high_resolution_clock::now();
+
+		if (frame >= settings.warmupFrames)
+			frameTimes.push_back(MillisecondsBetween(start, end));
+	}
+
+	PrintRow(name, frameTimes);
+}
+}
+
+//runs the particle benchmark
+int RunParticleBenchmark(int argc, char** argv) {
+	//read the settings from the command line
+	ParticleBenchmarkSettings settings;
+	if (argc > 0) settings.frames = std::max(1, atoi(argv[0]));
+	if (argc > 1) {
+		settings.particleCounts.clear();
+		for (int i = 1; i < argc; i++)
+			settings.particleCounts.push_back((size_t)std::max(1, atoi(argv[i])));
+	}
+
+	size_t defaultThreshold = TTN_ParticleSystem::GetMultithreadThreshold();
+	unsigned workers = TTN_ThreadPool::GetShared().GetNumOfThreads();
+
+	//the render cases need the particle shader and default texture
+	TTN_ParticleSystem::InitParticleShader();
+	const char* renderName = TTN_StreamBuffer::GetPersistentMappingSupported() ? "render persistent" : "render orphaned";
+
+	for (size_t count : settings.particleCounts) {
+		printf("\n%zu particles, %d frames, %u pool workers, threshold %zu (times in ms)\n", count, settings.frames, workers, defaultThreshold);
+		PrintHeader("case");
+
+		//every particle alive the whole time
+		RunUpdates("steady 1 thread", count, false, (size_t)-1, settings);
+		RunUpdates("steady pool", count, false, defaultThreshold, settings);
+		//particles dying and being replaced every frame
+		RunUpdates("churn 1 thread", count, true, (size_t)-1, settings);
+		RunUpdates("churn pool", count, true, defaultThreshold, settings);
+		//writing the instance data and drawing
+		RunRender(renderName, count, settings);
+		//the same particles updated and drawn without the cpu touching them
+		if (TTN_ParticleSystem::GetGPUBackendSupported())
+			RunGPU("gpu update+render", count, settings);
+	}
+
+	TTN_ParticleSystem::SetMultithreadThreshold(defaultThreshold);
+	return 0;
+}
@@ -0,0 +1,223 @@
+//Titan Benchmarks, by Atlas X Games
+//PhysicsBenchmark.cpp, the source file for the benchmarks that stress the physics side of titan scenes, spawning and deleting bodies
+//every frame (like cannonballs) and counting how many times bullet goes to the heap, and comparing the single and multithreaded worlds
+#include "Benchmarks.h"
+
+//import required titan features
+#include "Titan/PhysicsPool.h"
+
+//import other required features
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <thread>
+
+namespace {
+//settings for a physics benchmark run
+struct PhysicsBenchmarkSettings {
+	//number of frames to throw away before recording
+	int warmupFrames = 30;
+	//number of frames to record
+	int frames = 300;
+	//how many frames each spawned body lives for before it's deleted
+	int lifetime = 20;
+	//the numbers of bodies to spawn every frame
+	std::vector<int> spawnCounts = { 10, 100, 1000 };
+};
+
+//settings for a solver benchmark run
+struct SolverBenchmarkSettings {
+	//number of frames to throw away before recording
+	int warmupFrames = 30;
+	//number of frames to record
+	int frames = 300;
+	//the numbers of dynamic bodies to test
+	std::vector<int> bodyCounts = { 1000, 5000, 10000 };
+};
+
+//the number of allocations bullet has made, everything bullet (and the physics pool) allocates goes through it's aligned allocator
+uint64_t s_bulletAllocations = 0;
+
+//the allocator bullet is given, it's just malloc and free with a count
+void* CountingAlloc(size_t size) {
+	s_bulletAllocations++;
+	return malloc(size);
+}
+void CountingFree(void* memblock) {
+	free(memblock);
+}
+
+//runs a scene that spawns and deletes bodies every frame, with the physics pool on or off
+void RunSpawnStress(const char* name, int spawnCount, bool pooled, const PhysicsBenchmarkSettings& settings) {
+	TTN_PhysicsPool::SetEnabled(pooled);
+	std::unique_ptr<TTN_Scene> scene = std::make_unique<TTN_Scene>(glm::vec3(1.0f), 0.5f);
+	entt::registry* reg = scene->GetScene();
+
+	std::deque<std::vector<entt::entity>> alive;
+	std::vector<double> spawnTimes;
+	std::vector<double> deleteTimes;
+	std::vector<double> updateTimes;
+	uint64_t allocationsBefore = 0;
+	uint64_t poolAllocationsBefore = 0;
+	std::chrono::high_resolution_clock::time_point recordStart;
+	const float deltaTime = 1.0f / 60.0f;
+
+	for (int frame = 0; frame < settings.warmupFrames + settings.frames; frame++) {
+		bool recording = frame >= settings.warmupFrames;
+		if (frame == settings.warmupFrames) {
+			allocationsBefore = s_bulletAllocations;
+			poolAllocationsBefore = TTN_PhysicsPool::GetNumOfAllocations();
+			recordStart = std::chrono::high_resolution_clock::now();
+		}
+
+		//spawn this frame's bodies, a few different sizes so the shapes aren't all shared
+		auto start = std::chrono::high_resolution_clock::now();
+		std::vector<entt::entity> spawned;
+		spawned.reserve(spawnCount);
+		for (int i = 0; i < spawnCount; i++) {
+			entt::entity entity = scene->CreateEntity();
+			glm::vec3 pos = glm::vec3(TTN_Random::RandomFloat(-50.0f, 50.0f), TTN_Random::RandomFloat(-50.0f, 50.0f),
+				TTN_Random::RandomFloat(-50.0f, 50.0f));
+			glm::vec3 scale = glm::vec3(0.5f + 0.25f * (float)(i % 4));
+			reg->emplace<TTN_Transform>(entity, pos, glm::vec3(0.0f), scale);
+			reg->emplace<TTN_Physics>(entity, pos, glm::vec3(0.0f), scale, entity);
+			reg->get<TTN_Physics>(entity).SetLinearVelocity(glm::vec3(0.0f, 0.0f, 20.0f));
+			spawned.push_back(entity);
+		}
+		alive.push_back(std::move(spawned));
+		auto spawnEnd = std::chrono::high_resolution_clock::now();
+
+		//step the scene
+		scene->Update(deltaTime);
+		auto updateEnd = std::chrono::high_resolution_clock::now();
+
+		//delete the bodies that have lived long enough
+		if ((int)alive.size() > settings.lifetime) {
+			for (entt::entity entity : alive.front())
+				scene->DeleteEntity(entity);
+			alive.pop_front();
+		}
+		auto deleteEnd = std::chrono::high_resolution_clock::now();
+
+		if (recording) {
+			spawnTimes.push_back(MillisecondsBetween(start, spawnEnd));
+			updateTimes.push_back(MillisecondsBetween(spawnEnd, updateEnd));
+			deleteTimes.push_back(MillisecondsBetween(updateEnd, deleteEnd));
+		}
+	}
+
+	double seconds = MillisecondsBetween(recordStart, std::chrono::high_resolution_clock::now()) / 1000.0;
+	double allocations = (double)(s_bulletAllocations - allocationsBefore);
+	double bodyAllocations = (double)(TTN_PhysicsPool::GetNumOfAllocations() - poolAllocationsBefore);
+	double spawned = (double)spawnCount * (double)settings.frames;
+
+	char rowName[64];
+	snprintf(rowName, sizeof(rowName), "%s spawn", name);
+	PrintRow(rowName, spawnTimes);
+	snprintf(rowName, sizeof(rowName), "%s update", name);
+	PrintRow(rowName, updateTimes);
+	snprintf(rowName, sizeof(rowName), "%s delete", name);
+	PrintRow(rowName, deleteTimes);
+	printf("  %-24s %10.0f allocations/s, %.2f per body (%.2f for motion states and rigid bodies)\n", "bullet heap", allocations / seconds,
+		allocations / spawned, bodyAllocations / spawned);
+}
+
+//runs a scene with a pile of dynamic bodies falling onto a floor with the given number of physics workers
+void RunPile(const char* name, int bodyCount, int workers, const SolverBenchmarkSettings& settings) {
+	std::unique_ptr<TTN_Scene> scene = std::make_unique<TTN_Scene>(glm::vec3(1.0f), 0.5f, workers);
+	entt::registry* reg = scene->GetScene();
+	scene->SetGravity(glm::vec3(0.0f, -9.8f, 0.0f));
+
+	//the floor
+	entt::entity floor = reg->create();
+	glm::vec3 floorScale = glm::vec3(400.0f, 2.0f, 400.0f);
+	reg->emplace<TTN_Transform>(floor, glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f), floorScale);
+	reg->emplace<TTN_Physics>(floor, glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f), floorScale, floor, TTN_PhysicsBodyType::STATIC);
+
+	//stacks of boxes spread out over it, so there are lots of separate islands for the solver pool to split up
+	int side = std::max(1, (int)std::sqrt((float)bodyCount / 10.0f));
+	for (int i = 0; i < bodyCount; i++) {
+		entt::entity entity = reg->create();
+		int column = i % (side * side);
+		glm::vec3 pos = glm::vec3((float)(column % side) * 3.0f - side * 1.5f, 0.5f + 1.05f * (float)(i / (side * side)),
+			(float)(column / side) * 3.0f - side * 1.5f);
+		reg->emplace<TTN_Transform>(entity, pos, glm::vec3(0.0f), glm::vec3(1.0f));
+		reg->emplace<TTN_Physics>(entity, pos, glm::vec3(0.0f), glm::vec3(1.0f), entity);
+	}
+
+	std::vector<double> updateTimes;
+	std::vector<double> stepTimes;
+	const float deltaTime = 1.0f / 60.0f;
+	for (int frame = 0; frame < settings.warmupFrames + settings.frames; frame++) {
+		TTN_Profiler::BeginFrame();
+		auto start = std::chrono::high_resolution_clock::now();
+		scene->Update(deltaTime);
+		auto end = std::chrono::high_resolution_clock::now();
+
+		if (frame >= settings.warmupFrames) {
+			updateTimes.push_back(MillisecondsBetween(start, end));
+			stepTimes.push_back(TTN_Profiler::GetTime(TTN_ProfilePhase::PHYSICS_STEP));
+		}
+	}
+
+	char rowName[64];
+	snprintf(rowName, sizeof(rowName), "%s update", name);
+	PrintRow(rowName, updateTimes);
+	snprintf(rowName, sizeof(rowName), "%s step", name);
+	PrintRow(rowName, stepTimes);
+}
+}
+
+//runs the physics benchmark
+int RunPhysicsBenchmark(int argc, char** argv) {
+	//read the settings from the command line
+	PhysicsBenchmarkSettings settings;
+	if (argc > 0) settings.frames = std::max(1, atoi(argv[0]));
+	if (argc > 1) {
+		settings.spawnCounts.clear();
+		for (int i = 1; i < argc; i++)
+			settings.spawnCounts.push_back(std::max(1, atoi(argv[i])));
+	}
+
+	//count bullet's allocations, this has to be set before anything is allocated through bullet
+	btAlignedAllocSetCustom(CountingAlloc, CountingFree);
+	bool defaultPooled = TTN_PhysicsPool::GetEnabled();
+
+	for (int spawnCount : settings.spawnCounts) {
+		printf("\n%d bodies spawned a frame, each living %d frames, %d frames (times in ms)\n", spawnCount, settings.lifetime, settings.frames);
+		PrintHeader("case");
+		RunSpawnStress("unpooled", spawnCount, false, settings);
+		RunSpawnStress("pooled", spawnCount, true, settings);
+	}
+
+	TTN_PhysicsPool::SetEnabled(defaultPooled);
+	return 0;
+}
+
+//runs the solver benchmark
+int RunSolverBenchmark(int argc, char** argv) {
+	//read the settings from the command line
+	SolverBenchmarkSettings settings;
+	if (argc > 0) settings.frames = std::max(1, atoi(argv[0]));
+	if (argc > 1) {
+		settings.bodyCounts.clear();
+		for (int i = 1; i < argc; i++)
+			settings.bodyCounts.push_back(std::max(1, atoi(argv[i])));
+	}
+
+	int workers = std::max(1, (int)std::thread::hardware_concurrency());
+	if (!TTN_Scene::GetPhysicsMultithreadingSupported())
+		printf("bullet was built without threading, the multithreaded world will only use one thread\n");
+
+	for (int bodyCount : settings.bodyCounts) {
+		printf("\n%d dynamic bodies, %d frames, %d workers (times in ms)\n", bodyCount, settings.frames, workers);
+		PrintHeader("case");
+		RunPile("single", bodyCount, 0, settings);
+		RunPile("multithreaded", bodyCount, workers, settings);
+	}
+
+	return 0;
+}
@@ -0,0 +1,216 @@
+//Titan Benchmarks, by Atlas X Games
+//SceneBenchmark.cpp, the source file for the benchmark that runs whole titan scenes headlessly (no window or gpu) and reports how long each phase of a frame takes
+#include "Benchmarks.h"
+
+//import other required features
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+//settings for a scene benchmark run
+struct BenchmarkSettings {
+	//number of frames to throw away before recording
+	int warmupFrames = 10;
+	//number of frames to record
+	int frames = 300;
+	//how many of the entities should have a physics body (0-1)
+	float physicsFraction = 0.1f;
+	//the sizes of the scenes to test
+	std::vector<int> entityCounts = { 1000, 10000, 100000 };
+};
+
+//the timings recorded for every frame of a run
+struct BenchmarkResults {
+	std::vector<double> frameTimes;
+	std::vector<double> updateTimes;
+	std::vector<double> renderTimes;
+	std::vector<double> phaseTimes[(int)TTN_ProfilePhase::COUNT];
+	std::vector<double> counts[(int)TTN_ProfileCounter::COUNT];
+	TTN_GLCallStats glTotals;
+};
+
+//makes a unit cube mesh in code so the benchmark doesn't depend on any model files
+TTN_Mesh::smptr MakeCubeMesh() {
+	//the 6 faces of the cube, each with a normal and two axes on the face
+	const glm::vec3 normals[6] = { glm::vec3(1, 0, 0), glm::vec3(-1, 0, 0), glm::vec3(0, 1, 0),
+		glm::vec3(0, -1, 0), glm::vec3(0, 0, 1), glm::vec3(0, 0, -1) };
+
+	std::vector<glm::vec3> verts;
+	std::vector<glm::vec3> norms;
+	std::vector<glm::vec2> uvs;
+	for (int i = 0; i < 6; i++) {
+		glm::vec3 n = normals[i];
+		//pick two axes that lie on the face
+		glm::vec3 u = (glm::abs(n.y) > 0.5f) ? glm::vec3(1, 0, 0) : glm::vec3(0, 1, 0);
+		glm::vec3 v = glm::cross(n, u);
+
+		//the corners of the face
+		glm::vec3 corners[4] = { 0.5f * (n - u - v), 0.5f * (n + u - v), 0.5f * (n + u + v), 0.5f * (n - u + v) };
+		glm::vec2 cornerUvs[4] = { glm::vec2(0, 0), glm::vec2(1, 0), glm::vec2(1, 1), glm::vec2(0, 1) };
+
+		//two triangles per face
+		const int order[6] = { 0, 1, 2, 0, 2, 3 };
+		for (int j = 0; j < 6; j++) {
+			verts.push_back(corners[order[j]]);
+			norms.push_back(n);
+			uvs.push_back(cornerUvs[order[j]]);
+		}
+	}
+
+	TTN_Mesh::smptr mesh = TTN_Mesh::Create();
+	mesh->AddVertices(verts);
+	mesh->AddNormals(norms);
+	mesh->SetUVs(uvs);
+	mesh->SetUpVao();
+
+	return mesh;
+}
+
+//makes a shader program out of two of titan's default shaders
+TTN_Shader::sshptr MakeShader(TTN_DefaultShaders vert, TTN_DefaultShaders frag) {
+	TTN_Shader::sshptr shader = TTN_Shader::Create();
+	shader->LoadDefaultShader(vert);
+	shader->LoadDefaultShader(frag);
+	shader->Link();
+	return shader;
+}
+
+//builds a scene with the given number of entities
+TTN_Scene* MakeScene(int entityCount, const BenchmarkSettings& settings) {
+	TTN_Scene* scene = new TTN_Scene(glm::vec3(1.0f), 0.5f);
+	entt::registry* reg = scene->GetScene();
+
+	//a few meshes, shaders and materials so the render sort has something to do
+	std::vector<TTN_Mesh::smptr> meshes = { MakeCubeMesh(), MakeCubeMesh(), MakeCubeMesh() };
+	std::vector<TTN_Shader::sshptr> shaders = {
+		MakeShader(TTN_DefaultShaders::VERT_NO_COLOR, TTN_DefaultShaders::FRAG_BLINN_PHONG_NO_TEXTURE),
+		MakeShader(TTN_DefaultShaders::VERT_NO_COLOR, TTN_DefaultShaders::FRAG_BLINN_PHONG_ALBEDO_ONLY)
+	};
+	std::vector<TTN_Material::smatptr> materials = { TTN_Material::Create(), TTN_Material::Create(),
+		TTN_Material::Create(), TTN_Material::Create() };
+
+	//the camera
+	entt::entity camera = reg->create();
+	reg->emplace<TTN_Transform>(camera, glm::vec3(0.0f, 0.0f, -50.0f), glm::vec3(0.0f), glm::vec3(1.0f));
+	reg->emplace<TTN_Camera>(camera);
+	reg->get<TTN_Camera>(camera).CalcPerspective(60.0f, 1.78f, 0.01f, 1000.0f);
+	scene->SetCamEntity(camera);
+
+	//a few lights
+	for (int i = 0; i < 4; i++) {
+		entt::entity light = reg->create();
+		reg->emplace<TTN_Transform>(light, glm::vec3(-30.0f + 20.0f * i, 10.0f, 0.0f), glm::vec3(0.0f), glm::vec3(1.0f));
+		reg->emplace<TTN_Light>(light, glm::vec3(1.0f), 0.6f, 2.0f, 0.3f, 0.3f, 0.3f);
+		scene->m_Lights.push_back(light);
+	}
+
+	//the entities, these are added straight to the registry rather than through TTN_Scene::CreateEntity and Attach so
+	//setup doesn't rebuild the scenegraph once per entity
+	int physicsEvery = (settings.physicsFraction > 0.0f) ? std::max(1, (int)(1.0f / settings.physicsFraction)) : 0;
+	int side = std::max(1, (int)std::cbrt((float)entityCount));
+	for (int i = 0; i < entityCount; i++) {
+		entt::entity entity = reg->create();
+
+		//lay them out in a grid
+		glm::vec3 pos = glm::vec3((float)(i % side), (float)((i / side) % side), (float)(i / (side * side))) * 2.0f
+			- glm::vec3((float)side);
+		reg->emplace<TTN_Transform>(entity, pos, glm::vec3(0.0f), glm::vec3(1.0f));
+		reg->emplace<TTN_Renderer>(entity, meshes[i % meshes.size()], shaders[i % shaders.size()],
+			materials[i % materials.size()]);
+
+		//and give some of them physics bodies that move
+		if (physicsEvery > 0 && i % physicsEvery == 0) {
+			reg->emplace<TTN_Physics>(entity, pos, glm::vec3(0.0f), glm::vec3(1.0f), entity);
+			reg->get<TTN_Physics>(entity).SetLinearVelocity(glm::vec3(TTN_Random::RandomFloat(-1.0f, 1.0f),
+				TTN_Random::RandomFloat(-1.0f, 1.0f), TTN_Random::RandomFloat(-1.0f, 1.0f)));
+		}
+	}
+
+	return scene;
+}
+
+//runs a scene for the set number of frames and records the timings
+BenchmarkResults RunScene(TTN_Scene* scene, const BenchmarkSettings& settings) {
+	BenchmarkResults results;
+	const float deltaTime = 1.0f / 60.0f;
+
+	for (int frame = 0; frame < settings.warmupFrames + settings.frames; frame++) {
+		//start the frame
+		TTN_Profiler::BeginFrame();
+		bool recording = frame >= settings.warmupFrames;
+		if (frame == settings.warmupFrames) TTN_HeadlessGL::ResetStats();
+
+		//update and render the scene, the same way TTN_Application::Update does
+		auto start = std::chrono::high_resolution_clock::now();
+		scene->Update(deltaTime);
+		auto updated = std::chrono::high_resolution_clock::now();
+		scene->Render();
+		scene->PostRender();
+		auto rendered = std::chrono::high_resolution_clock::now();
+
+		//record the frame
+		if (recording) {
+			results.updateTimes.push_back(MillisecondsBetween(start, updated));
+			results.renderTimes.push_back(MillisecondsBetween(updated, rendered));
+			results.frameTimes.push_back(MillisecondsBetween(start, rendered));
+			for (int i = 0; i < (int)TTN_ProfilePhase::COUNT; i++)
+				results.phaseTimes[i].push_back(TTN_Profiler::GetTime((TTN_ProfilePhase)i));
+			for (int i = 0; i < (int)TTN_ProfileCounter::COUNT; i++)
+				results.counts[i].push_back((double)TTN_Profiler::GetCount((TTN_ProfileCounter)i));
+		}
+	}
+
+	results.glTotals = TTN_HeadlessGL::GetStats();
+	return results;
+}
+
+//prints the results of a run
+void PrintResults(int entityCount, const BenchmarkSettings& settings, const BenchmarkResults& results) {
+	printf("\n%d entities, %d frames (times in ms)\n", entityCount, settings.frames);
+	PrintHeader("phase");
+	PrintRow("frame", results.frameTimes);
+	PrintRow("update", results.updateTimes);
+	PrintRow("render", results.renderTimes);
+	for (int i = 0; i < (int)TTN_ProfilePhase::COUNT; i++)
+		PrintRow(TTN_Profiler::GetPhaseName((TTN_ProfilePhase)i), results.phaseTimes[i]);
+
+	//print the counters, per frame
+	printf("\n");
+	PrintHeader("counter");
+	for (int i = 0; i < (int)TTN_ProfileCounter::COUNT; i++)
+		PrintRow(TTN_Profiler::GetCounterName((TTN_ProfileCounter)i), results.counts[i]);
+
+	//print the opengl calls made per frame
+	double frames = (double)std::max(1, settings.frames);
+	const TTN_GLCallStats& gl = results.glTotals;
+	printf("  gl calls per frame: draws %.0f (instanced %.0f, instances %.0f), shader binds %.0f, texture binds %.0f, "
+		"vao binds %.0f, buffer binds %.0f, uniform uploads %.0f, buffer uploads %.0f (%.0f bytes), total %.0f\n",
+		gl.DrawCalls / frames, gl.InstancedDrawCalls / frames, gl.InstancesDrawn / frames, gl.ShaderBinds / frames,
+		gl.TextureBinds / frames, gl.VaoBinds / frames, gl.BufferBinds / frames, gl.UniformUploads / frames,
+		gl.BufferUploads / frames, gl.BufferBytes / frames, gl.TotalCalls / frames);
+}
+}
+
+//runs the scene benchmark
+int RunSceneBenchmark(int argc, char** argv) {
+	//read the settings from the command line
+	BenchmarkSettings settings;
+	if (argc > 0) settings.frames = std::max(1, atoi(argv[0]));
+	if (argc > 1) {
+		settings.entityCounts.clear();
+		for (int i = 1; i < argc; i++)
+			settings.entityCounts.push_back(std::max(1, atoi(argv[i])));
+	}
+
+	//run each scene size
+	for (int entityCount : settings.entityCounts) {
+		TTN_Scene* scene = MakeScene(entityCount, settings);
+		BenchmarkResults results = RunScene(scene, settings);
+		PrintResults(entityCount, settings, results);
+		delete scene;
+	}
+
+	return 0;
+}
@@ -0,0 +1,209 @@
+//Titan Benchmarks, by Atlas X Games
+//TextureBenchmark.cpp, the source file for the benchmark that compresses every image in a folder, comparing the time it takes and the memory
+//it saves against the image with a full set of mipmaps, how close the compressed texture is to the image, and how long the baked copy takes to load
+#include "Benchmarks.h"
+#include "Titan/TextureCompressor.h"
+
+//import other required features
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+namespace {
+//settings for a texture benchmark run
+struct TextureBenchmarkSettings {
+	//number of times to compress each image
+	int repeats = 3;
+	//the folder to search for images (including it's subfolders)
+	std::string folder = "textures";
+};
+
+//turns a 565 color back into 8 bits a channel
+void Decode565(uint16_t color, int out[3]) {
+	int r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+	out[0] = (r << 3) | (r >> 2);
+	out[1] = (g << 2) | (g >> 4);
+	out[2] = (b << 3) | (b >> 2);
+}
+
+//decodes a BC1 block into the rgb of 16 rgba pixels
+void DecodeColorBlock(const uint8_t* block, uint8_t pixels[16][4]) {
+	uint16_t color0 = block[0] | (block[1] << 8), color1 = block[2] | (block[3] << 8);
+	int palette[4][3];
+	Decode565(color0, palette[0]);
+	Decode565(color1, palette[1]);
+	for (int c = 0; c < 3; c++) {
+		palette[2][c] = (color0 > color1) ? (2 * palette[0][c] + palette[1][c]) / 3 : (palette[0][c] + palette[1][c]) / 2;
+		palette[3][c] = (color0 > color1) ? (palette[0][c] + 2 * palette[1][c]) / 3 : 0;
+	}
+
+	uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | ((uint32_t)block[7] << 24);
+	for (int i = 0; i < 16; i++)
+		for (int c = 0; c < 3; c++)
+			pixels[i][c] = (uint8_t)palette[(indices >> (2 * i)) & 3][c];
+}
+
+//decodes a BC4 block into one channel of 16 rgba pixels
+void DecodeChannelBlock(const uint8_t* block, int channel, uint8_t pixels[16][4]) {
+	int palette[8] = { block[0], block[1] };
+	if (block[0] > block[1]) {
+		for (int p = 2; p < 8; p++)
+			palette[p] = ((8 - p) * block[0] + (p - 1) * block[1]) / 7;
+	}
+	else {
+		for (int p = 2; p < 6; p++)
+			palette[p] = ((6 - p) * block[0] + (p - 1) * block[1]) / 5;
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+
+	uint64_t indices = 0;
+	for (int i = 0; i < 6; i++)
+		indices |= (uint64_t)block[2 + i] << (8 * i);
+	for (int i = 0; i < 16; i++)
+		pixels[i][channel] = (uint8_t)palette[(indices >> (3 * i)) & 7];
+}
+
+//gets the root mean square error between the first level of a compressed texture and the image it was made from, over the channels the format keeps
+double GetError(const TTN_Texture2DData& image, const TTN_Texture2DData& compressed) {
+	const uint8_t* source = (const uint8_t*)image.GetDataPtr();
+	const uint8_t* blocks = (const uint8_t*)compressed.GetLevelDataPtr(0);
+	const int channels = GetTexelComponentCount(image.GetFormat());
+	const bool swapRedBlue = image.GetFormat() == Texture_Pixel_Format::BGR || image.GetFormat() == Texture_Pixel_Format::BGRA;
+	const Texture_Internal_Format format = compressed.GetRecommendedFormat();
+	const int comparedChannels = (format == Texture_Internal_Format::BC5) ? 2 : (format == Texture_Internal_Format::BC3) ? 4 : std::min(channels, 3);
+	const uint32_t width = image.GetWidth(), height = image.GetHeight(), blocksX = (width + 3) / 4;
+	const size_t blockSize = GetCompressedBlockSize(format);
+
+	double error = 0.0;
+	size_t count = 0;
+	for (uint32_t by = 0; by < (height + 3) / 4; by++) {
+		for (uint32_t bx = 0; bx < blocksX; bx++) {
+			uint8_t pixels[16][4] = {};
+			const uint8_t* block = blocks + ((size_t)by * blocksX + bx) * blockSize;
+			if (format == Texture_Internal_Format::BC1)
+				DecodeColorBlock(block, pixels);
+			else if (format == Texture_Internal_Format::BC3) {
+				DecodeChannelBlock(block, 3, pixels);
+				DecodeColorBlock(block + 8, pixels);
+			}
+			else {
+				DecodeChannelBlock(block, 0, pixels);
+				DecodeChannelBlock(block + 8, 1, pixels);
+			}
+
+			for (uint32_t i = 0; i < 16; i++) {
+				uint32_t x = bx * 4 + i % 4, y = by * 4 + i / 4;
+				if (x >= width || y >= height)
+					continue;
+				const uint8_t* texel = source + ((size_t)y * width + x) * channels;
+				for (int c = 0; c < comparedChannels; c++) {
+					int sourceChannel = (swapRedBlue && c < 3) ? 2 - c : c;
+					double difference = (double)pixels[i][c] - (channels == 1 ? texel[0] : texel[sourceChannel]);
+					error += difference * difference;
+					count++;
+				}
+			}
+		}
+	}
+
+	return (count > 0) ? std::sqrt(error / (double)count) : 0.0;
+}
+
+//gets the size of an image with a full set of mipmaps, which is what opengl stores when it generates them
+size_t GetMippedSize(const TTN_Texture2DData& image) {
+	size_t size = 0;
+	for (uint32_t level = 0; level < GetNumOfMipLevels(image.GetWidth(), image.GetHeight()); level++)
+		size += (size_t)std::max(image.GetWidth() >> level, 1u) * std::max(image.GetHeight() >> level, 1u)
+			* GetTexelSize(image.GetFormat(), image.GetPixelType());
+	return size;
+}
+
+//finds every image in the folder and it's subfolders, sorted so runs are comparable
+std::vector<std::string> FindImageFiles(const std::string& folder) {
+	std::vector<std::string> files;
+	std::error_code error;
+	for (auto it = std::filesystem::recursive_directory_iterator(folder, error); !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+		std::string extension = it->path().extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return (char)tolower(c); });
+		if (it->is_regular_file() && (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" || extension == ".bmp"))
+			files.push_back(it->path().string());
+	}
+	std::sort(files.begin(), files.end());
+	return files;
+}
+}
+
+//runs the texture compression benchmark
+int RunTextureBenchmark(int argc, char** argv) {
+	//read the settings from the command line
+	TextureBenchmarkSettings settings;
+	if (argc > 0) settings.repeats = std::max(1, atoi(argv[0]));
+	if (argc > 1) settings.folder = argv[1];
+
+	std::vector<std::string> files = FindImageFiles(settings.folder);
+	if (files.empty()) {
+		printf("no images found in \"%s\"\n", settings.folder.c_str());
+		return 1;
+	}
+
+	//time decoding each image, compressing it, and loading the baked copy, the totals are over the whole folder
+	std::vector<double> decodeTotals, compressTotals, bakedTotals;
+	size_t mippedBytes = 0, compressedBytes = 0;
+	printf("\n%zu images in \"%s\", %d repeats (times in ms, sizes in KB, from the last run)\n", files.size(), settings.folder.c_str(), settings.repeats);
+	printf("  %-40s %6s %10s %10s %10s %10s %10s %8s\n", "file", "format", "decode", "compress", "baked", "mipped", "compressed", "rmse");
+	TTN_TextureCompressor::SetEnabled(true);
+	for (int repeat = 0; repeat < settings.repeats; repeat++) {
+		double decodeTotal = 0.0, compressTotal = 0.0, bakedTotal = 0.0;
+		for (const std::string& file : files) {
+			auto start = std::chrono::high_resolution_clock::now();
+			TTN_Texture2DData::st2ddptr image = TTN_Texture2DData::LoadFromFile(file);
+			auto middle = std::chrono::high_resolution_clock::now();
+			TTN_Texture2DData::st2ddptr compressed = (image != nullptr) ? TTN_TextureCompressor::Compress(*image) : nullptr;
+			auto end = std::chrono::high_resolution_clock::now();
+			if (compressed == nullptr)
+				continue;
+
+			//the first load bakes the image if there isn't an up to date copy already, so only the second one is timed
+			TTN_TextureCompressor::LoadFromFile(file);
+			auto bakedStart = std::chrono::high_resolution_clock::now();
+			TTN_Texture2DData::st2ddptr baked = TTN_TextureCompressor::LoadFromFile(file);
+			auto bakedEnd = std::chrono::high_resolution_clock::now();
+
+			double decodeTime = MillisecondsBetween(start, middle);
+			double compressTime = MillisecondsBetween(middle, end);
+			double bakedTime = MillisecondsBetween(bakedStart, bakedEnd);
+			decodeTotal += decodeTime;
+			compressTotal += compressTime;
+			bakedTotal += bakedTime;
+
+			if (repeat == settings.repeats - 1) {
+				const char* formatName = (compressed->GetRecommendedFormat() == Texture_Internal_Format::BC1) ? "BC1" :
+					(compressed->GetRecommendedFormat() == Texture_Internal_Format::BC3) ? "BC3" : "BC5";
+				std::string name = std::filesystem::path(file).filename().string();
+				printf("  %-40s %6s %10.3f %10.3f %10.3f %10.1f %10.1f %8.2f\n", name.c_str(), formatName, decodeTime, compressTime, bakedTime,
+					GetMippedSize(*image) / 1024.0, compressed->GetDataSize() / 1024.0, GetError(*image, *compressed));
+				mippedBytes += GetMippedSize(*image);
+				compressedBytes += compressed->GetDataSize();
+			}
+		}
+		decodeTotals.push_back(decodeTotal);
+		compressTotals.push_back(compressTotal);
+		bakedTotals.push_back(bakedTotal);
+	}
+	TTN_TextureCompressor::SetEnabled(false);
+
+	printf("\nwhole folder (times in ms)\n");
+	PrintHeader("step");
+	PrintRow("decode image", decodeTotals);
+	PrintRow("compress + mips", compressTotals);
+	PrintRow("load baked dds", bakedTotals);
+	printf("  %-24s %10.1f KB\n", "mipped images", mippedBytes / 1024.0);
+	printf("  %-24s %10.1f KB\n", "compressed", compressedBytes / 1024.0);
+	printf("  %-24s %10.2fx\n", "memory saved", (double)mippedBytes / std::max((double)compressedBytes, 1.0));
+
+	return 0;
+}
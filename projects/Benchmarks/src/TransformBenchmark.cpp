@@ -0,0 +1,193 @@
+//Titan Benchmarks, by Atlas X Games
+//TransformBenchmark.cpp, the source file for the benchmark that compares the world matrix pass on deep and wide transform hierarchies
+#include "Benchmarks.h"
+
+//import other required features
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+//the shapes of hierarchy that get tested
+enum class HierarchyShape {
+	//no parents at all
+	FLAT,
+	//one root with everything else as it's direct children
+	WIDE,
+	//lots of long chains, each transform is the parent of the next
+	DEEP
+};
+
+//settings for a transform benchmark run
+struct TransformBenchmarkSettings {
+	//number of frames to throw away before recording
+	int warmupFrames = 10;
+	//number of frames to record
+	int frames = 200;
+	//number of transforms in each hierarchy
+	int entityCount = 10000;
+	//how long each chain is in the deep hierarchy
+	int chainLength = 64;
+};
+
+//a scene full of transforms in one of the hierarchy shapes
+struct TransformHierarchy {
+	TTN_Scene* scene = nullptr;
+	//the entities, in the order they were made
+	std::vector<entt::entity> entities;
+	//the indices of the transforms without parents
+	std::vector<size_t> roots;
+	//how long it took to make and link all the entities, in milliseconds
+	double buildTime = 0.0;
+};
+
+//gets the name of a hierarchy shape
+const char* GetShapeName(HierarchyShape shape) {
+	switch (shape) {
+	case HierarchyShape::FLAT:
+		return "flat";
+	case HierarchyShape::WIDE:
+		return "wide";
+	case HierarchyShape::DEEP:
+		return "deep";
+	default:
+		return "unknown";
+	}
+}
+
+//builds a scene with the transforms set up in the given shape
+TransformHierarchy MakeHierarchy(HierarchyShape shape, const TransformBenchmarkSettings& settings) {
+	TransformHierarchy hierarchy;
+	hierarchy.scene = new TTN_Scene();
+	hierarchy.entities.reserve(settings.entityCount);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < settings.entityCount; i++) {
+		//make the entity and it's transform
+		entt::entity entity = hierarchy.scene->CreateEntity();
+		hierarchy.scene->AttachCopy(entity, TTN_Transform(glm::vec3((float)(i % 100), 0.0f, (float)(i / 100)), glm::vec3(0.0f), glm::vec3(1.0f)));
+		hierarchy.entities.push_back(entity);
+
+		//work out the parent for this shape, -1 for a root
+		int parent = -1;
+		if (shape == HierarchyShape::WIDE && i > 0)
+			parent = 0;
+		else if (shape == HierarchyShape::DEEP && i % settings.chainLength != 0)
+			parent = i - 1;
+
+		if (parent < 0) {
+			hierarchy.roots.push_back(i);
+			continue;
+		}
+
+		hierarchy.scene->SetParent(entity, hierarchy.entities[parent]);
+	}
+
+	//do one pass so the hierarchy order gets built, that's part of the cost of spawning too
+	hierarchy.scene->UpdateWorldMatrices();
+	hierarchy.buildTime = MillisecondsBetween(start, std::chrono::high_resolution_clock::now());
+
+	return hierarchy;
+}
+
+//deletes a hierarchy
+void DeleteHierarchy(TransformHierarchy& hierarchy) {
+	delete hierarchy.scene;
+	hierarchy.scene = nullptr;
+}
+
+//the different kinds of frames that get tested
+enum class TransformScenario {
+	//nothing moves, so the pass should only be checking flags
+	STATIC,
+	//only the roots move, everything under them needs a new world matrix
+	ROOTS_MOVE,
+	//every transform gets moved three times in the frame, like a physics body being set by a few systems
+	ALL_MOVE_THREE_TIMES
+};
+
+//gets the name of a scenario
+const char* GetScenarioName(TransformScenario scenario) {
+	switch (scenario) {
+	case TransformScenario::STATIC:
+		return "static";
+	case TransformScenario::ROOTS_MOVE:
+		return "roots move";
+	case TransformScenario::ALL_MOVE_THREE_TIMES:
+		return "all move x3";
+	default:
+		return "unknown";
+	}
+}
+
+//runs one scenario on a hierarchy and prints the timings
+void RunScenario(TransformHierarchy& hierarchy, TransformScenario scenario, const TransformBenchmarkSettings& settings) {
+	entt::registry* reg = hierarchy.scene->GetScene();
+	std::vector<double> setTimes;
+	std::vector<double> passTimes;
+
+	for (int frame = 0; frame < settings.warmupFrames + settings.frames; frame++) {
+		float offset = (float)(frame % 2);
+
+		//make the changes for this frame
+		auto start = std::chrono::high_resolution_clock::now();
+		if (scenario == TransformScenario::ROOTS_MOVE) {
+			for (size_t root : hierarchy.roots) {
+				TTN_Transform& trans = reg->get<TTN_Transform>(hierarchy.entities[root]);
+				trans.SetPos(glm::vec3(trans.GetPos().x, offset, trans.GetPos().z));
+			}
+		}
+		else if (scenario == TransformScenario::ALL_MOVE_THREE_TIMES) {
+			for (entt::entity entity : hierarchy.entities) {
+				TTN_Transform& trans = reg->get<TTN_Transform>(entity);
+				glm::vec3 pos = trans.GetPos();
+				trans.SetPos(glm::vec3(pos.x, offset, pos.z));
+				trans.SetPos(glm::vec3(pos.x, offset + 0.5f, pos.z));
+				trans.SetPos(glm::vec3(pos.x, offset + 1.0f, pos.z));
+			}
+		}
+		auto set = std::chrono::high_resolution_clock::now();
+
+		//and rebuild the world matrices
+		hierarchy.scene->UpdateWorldMatrices();
+		auto passed = std::chrono::high_resolution_clock::now();
+
+		if (frame >= settings.warmupFrames) {
+			setTimes.push_back(MillisecondsBetween(start, set));
+			passTimes.push_back(MillisecondsBetween(set, passed));
+		}
+	}
+
+	char name[64];
+	snprintf(name, sizeof(name), "%s set", GetScenarioName(scenario));
+	PrintRow(name, setTimes);
+	snprintf(name, sizeof(name), "%s pass", GetScenarioName(scenario));
+	PrintRow(name, passTimes);
+}
+}
+
+//runs the transform benchmark
+int RunTransformBenchmark(int argc, char** argv) {
+	//read the settings from the command line
+	TransformBenchmarkSettings settings;
+	if (argc > 0) settings.frames = std::max(1, atoi(argv[0]));
+	if (argc > 1) settings.entityCount = std::max(1, atoi(argv[1]));
+	if (argc > 2) settings.chainLength = std::max(1, atoi(argv[2]));
+
+	//run every scenario on every shape
+	const HierarchyShape shapes[] = { HierarchyShape::FLAT, HierarchyShape::WIDE, HierarchyShape::DEEP };
+	const TransformScenario scenarios[] = { TransformScenario::STATIC, TransformScenario::ROOTS_MOVE, TransformScenario::ALL_MOVE_THREE_TIMES };
+	for (HierarchyShape shape : shapes) {
+		TransformHierarchy hierarchy = MakeHierarchy(shape, settings);
+
+		printf("\n%s hierarchy, %d transforms, %zu roots, built in %.3f ms, %d frames (times in ms)\n", GetShapeName(shape),
+			settings.entityCount, hierarchy.roots.size(), hierarchy.buildTime, settings.frames);
+		PrintHeader("scenario");
+		for (TransformScenario scenario : scenarios)
+			RunScenario(hierarchy, scenario, settings);
+
+		DeleteHierarchy(hierarchy);
+	}
+
+	return 0;
+}
@@ -0,0 +1,46 @@
+//Titan Benchmarks, by Atlas X Games
+//main.cpp, the source file that picks which benchmark suite to run, everything runs headlessly (no window or gpu)
+
+//include the benchmark suites
+#include "Benchmarks.h"
+
+//import other required features
+#include <cstdio>
+#include <cstring>
+
+//main function, runs the benchmarks
+//usage: Benchmarks [suite] [suite arguments...], the suite defaults to scene
+int main(int argc, char** argv) {
+	Logger::Init(); //initliaze otter's base logging system
+
+	//swap opengl out for the headless backend and turn on the profiler
+	TTN_HeadlessGL::Install();
+	TTN_Profiler::SetEnabled(true);
+
+	//pick the suite, if the first argument isn't a suite name it's passed on to the scene benchmark
+	const char* suite = (argc > 1) ? argv[1] : "scene";
+	int suiteArgc = (argc > 1) ? argc - 2 : 0;
+	char** suiteArgv = argv + 2;
+
+	if (strcmp(suite, "scene") == 0)
+		return RunSceneBenchmark(suiteArgc, suiteArgv);
+	if (strcmp(suite, "transforms") == 0)
+		return RunTransformBenchmark(suiteArgc, suiteArgv);
+	if (strcmp(suite, "particles") == 0)
+		return RunParticleBenchmark(suiteArgc, suiteArgv);
+	if (strcmp(suite, "models") == 0)
+		return RunObjBenchmark(suiteArgc, suiteArgv);
+	if (strcmp(suite, "physics") == 0)
+		return RunPhysicsBenchmark(suiteArgc, suiteArgv);
+	if (strcmp(suite, "solver") == 0)
+		return RunSolverBenchmark(suiteArgc, suiteArgv);
+	if (strcmp(suite, "textures") == 0)
+		return RunTextureBenchmark(suiteArgc, suiteArgv);
+
+	//no suite name, so treat all the arguments as scene benchmark arguments
+	if (suite[0] >= '0' && suite[0] <= '9')
+		return RunSceneBenchmark(argc - 1, argv + 1);
+
+	printf("unknown benchmark suite \"%s\", options are: scene, transforms, particles, models, physics, solver, textures\n", suite);
+	return 1;
+}
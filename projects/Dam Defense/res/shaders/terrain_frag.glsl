@@ -1,4 +1,5 @@
 #version 420
+#extension GL_ARB_bindless_texture : enable
 
 //mesh data from vert shader
 layout(location = 0) in vec3 inPos;
@@ -6,7 +7,7 @@ layout(location = 1) in vec3 inNormal;
 layout(location = 2) in vec2 inUV;
 layout(location = 3) in float inHeight;
 
-//material data
+//material data, set to bindless handles by the game when they are supported, otherwise bound to the texture slots
 layout(binding=1) uniform sampler2D s_base;
 layout(binding=2) uniform sampler2D s_second;
 layout(binding=3) uniform sampler2D s_third;
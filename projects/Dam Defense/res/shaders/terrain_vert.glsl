@@ -1,4 +1,5 @@
 #version 420
+#extension GL_ARB_bindless_texture : enable
 //mesh data from c++ program
 layout(location = 0) in vec3 inPos;
 layout(location = 1) in vec3 inNormal;
@@ -10,7 +11,7 @@ layout(location = 1) out vec3 outNormal;
 layout(location = 2) out vec2 outUV;
 layout(location = 3) out float outHeight;
 
-//texture
+//texture, set to a bindless handle by the game when they are supported, otherwise bound to the texture slot
 layout(binding=0)uniform sampler2D map;
 
 //influnce the displacement map should have 
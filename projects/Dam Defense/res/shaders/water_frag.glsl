@@ -1,11 +1,12 @@
 #version 420
+#extension GL_ARB_bindless_texture : enable
 
 //mesh data from vert shader
 layout(location = 0) in vec3 inPos;
 layout(location = 1) in vec3 inNormal;
 layout(location = 2) in vec2 inUV;
 
-//material data
+//material data, set to a bindless handle by the game when they are supported, otherwise bound to the texture slot
 layout(binding=0) uniform sampler2D waterText;
 
 //scene ambient lighting
@@ -65,20 +65,21 @@ void Game::Update(float deltaTime)
 			Flaming = false; //set flaming to false
 		}
 
-		//while it's flaming, iterate through the vector of boats, deleting the boat if it is at or below z = 20
-		std::vector<entt::entity>::iterator it = boats.begin();
-		while (it != boats.end()) {
-			if (Get<TTN_Transform>(*it).GetPos().z >= 27.0f) {
-				//std::cout <<"Global Pos:"<< Get<TTN_Transform>(*it).GetGlobalPos().z << std::endl;
-				//std::cout << "Pos:" << Get<TTN_Transform>(*it).GetPos().z << std::endl;
-				it++;
-			}
-			else {
-				DeleteEntity(*it);
-				it = boats.erase(it);
+		//while it's flaming, delete the boats in the flames in front of the dam (everything below z = 27), the box only finds the boats
+		//whose hulls reach into the flames, and then each one is still checked by it's position so they die in the same place they always did
+		OverlapBox(glm::vec3(0.0f, 0.0f, -36.5f), glm::vec3(200.0f, 100.0f, 63.5f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), flamedBoats, COLLISION_BOAT);
+		bool erased = false;
+		for (entt::entity boat : flamedBoats) {
+			if ((Get<TTN_Physics>(boat).GetCollisionGroup() & COLLISION_BOAT) && Get<TTN_Transform>(boat).GetPos().z < 27.0f) {
+				DeleteEntity(boat);
+				erased = true;
 				std::cout << "ERASED " << std::endl;
 			}
 		}
+
+		//then take all the deleted boats out of the vector in one go
+		if (erased)
+			boats.erase(std::remove_if(boats.begin(), boats.end(), [this](entt::entity boat) { return !GetScene()->valid(boat); }), boats.end());
 	}
 
 	Collisions(); //collision check
@@ -120,8 +121,9 @@ void Game::PostRender()
 		shaderProgramTerrain->Bind();
 
 		//vert shader
-		//bind the height map texture
-		terrainMap->Bind(0);
+		//bind the height map texture (unless the shader already has it's handle)
+		if (!terrainBindless)
+			terrainMap->Bind(0);
 
 		//pass the scale uniform
 		shaderProgramTerrain->SetUniform("u_scale", terrainScale);
@@ -139,9 +141,11 @@ void Game::PostRender()
 
 		//frag shader
 		//bind the textures
-		sandText->Bind(1);
-		rockText->Bind(2);
-		grassText->Bind(3);
+		if (!terrainBindless) {
+			sandText->Bind(1);
+			rockText->Bind(2);
+			grassText->Bind(3);
+		}
 
 		//send lighting from the scene
 		shaderProgramTerrain->SetUniform("u_AmbientCol", TTN_Scene::GetSceneAmbientColor());
@@ -178,7 +182,8 @@ void Game::PostRender()
 
 		//frag shader
 		//bind the textures
-		waterText->Bind(0);
+		if (!terrainBindless)
+			waterText->Bind(0);
 
 		//send lighting from the scene
 		shaderProgramWater->SetUniform("u_AmbientCol", TTN_Scene::GetSceneAmbientColor());
@@ -252,87 +257,94 @@ void Game::SetUpAssets()
 {
 	//// SHADERS ////
 #pragma region SHADERS
-	//create a shader program object
-	shaderProgramUnTextured = TTN_Shader::Create();
-	//load the shaders into the shader program
-	shaderProgramUnTextured->LoadDefaultShader(TTN_DefaultShaders::VERT_NO_COLOR);
-	shaderProgramUnTextured->LoadDefaultShader(TTN_DefaultShaders::FRAG_BLINN_PHONG_NO_TEXTURE);
-	shaderProgramUnTextured->Link();
-
-	//create a shader program object for textured objects
-	shaderProgramTextured = TTN_Shader::Create();
-	//load the shaders into the shader program
-	shaderProgramTextured->LoadDefaultShader(TTN_DefaultShaders::VERT_NO_COLOR);
-	shaderProgramTextured->LoadDefaultShader(TTN_DefaultShaders::FRAG_BLINN_PHONG_ALBEDO_ONLY);
-	shaderProgramTextured->Link();
-
-	//create a shader program object for the skybox
-	shaderProgramSkybox = TTN_Shader::Create();
-	//load the shaders into the shader program
-	shaderProgramSkybox->LoadDefaultShader(TTN_DefaultShaders::VERT_SKYBOX);
-	shaderProgramSkybox->LoadDefaultShader(TTN_DefaultShaders::FRAG_SKYBOX);
-	shaderProgramSkybox->Link();
-
-	//create a shader program for animationed textured objects
-	shaderProgramAnimatedTextured = TTN_Shader::Create();
-	//load the shaders into the shader program
-	shaderProgramAnimatedTextured->LoadDefaultShader(TTN_DefaultShaders::VERT_MORPH_ANIMATION_NO_COLOR);
-	shaderProgramAnimatedTextured->LoadDefaultShader(TTN_DefaultShaders::FRAG_BLINN_PHONG_ALBEDO_ONLY);
-	shaderProgramAnimatedTextured->Link();
-
-	//create a shader program for the terrain
-	shaderProgramTerrain = TTN_Shader::Create();
-	//load the shaders into the shader program
-	shaderProgramTerrain->LoadShaderStageFromFile("shaders/terrain_vert.glsl", GL_VERTEX_SHADER);
-	shaderProgramTerrain->LoadShaderStageFromFile("shaders/terrain_frag.glsl", GL_FRAGMENT_SHADER);
-	shaderProgramTerrain->Link();
-
-	//create a shader program for the water
-	shaderProgramWater = TTN_Shader::Create();
-	//load the shaders into the shader program
-	shaderProgramWater->LoadShaderStageFromFile("shaders/water_vert.glsl", GL_VERTEX_SHADER);
-	shaderProgramWater->LoadShaderStageFromFile("shaders/water_frag.glsl", GL_FRAGMENT_SHADER);
-	shaderProgramWater->Link();
+	//the shader programs come from the resource cache, so programs made from the same files are only compiled once
+	//shader program for untextured objects
+	shaderProgramUnTextured = TTN_ResourceCache::GetDefaultShader(TTN_DefaultShaders::VERT_NO_COLOR, TTN_DefaultShaders::FRAG_BLINN_PHONG_NO_TEXTURE);
+
+	//shader program for textured objects
+	shaderProgramTextured = TTN_ResourceCache::GetDefaultShader(TTN_DefaultShaders::VERT_NO_COLOR, TTN_DefaultShaders::FRAG_BLINN_PHONG_ALBEDO_ONLY);
+
+	//shader program for the skybox
+	shaderProgramSkybox = TTN_ResourceCache::GetDefaultShader(TTN_DefaultShaders::VERT_SKYBOX, TTN_DefaultShaders::FRAG_SKYBOX);
+
+	//shader program for animationed textured objects
+	shaderProgramAnimatedTextured = TTN_ResourceCache::GetDefaultShader(TTN_DefaultShaders::VERT_MORPH_ANIMATION_NO_COLOR,
+		TTN_DefaultShaders::FRAG_BLINN_PHONG_ALBEDO_ONLY);
+
+	//shader program for the terrain
+	shaderProgramTerrain = TTN_ResourceCache::GetShader("shaders/terrain_vert.glsl", "shaders/terrain_frag.glsl");
+
+	//shader program for the water
+	shaderProgramWater = TTN_ResourceCache::GetShader("shaders/water_vert.glsl", "shaders/water_frag.glsl");
 
 #pragma endregion
 
-	////MESHES////
-	cannonMesh = TTN_ObjLoader::LoadAnimatedMeshFromFiles("models/cannon/cannon", 7);
-	skyboxMesh = TTN_ObjLoader::LoadFromFile("models/SkyboxMesh.obj");
-	sphereMesh = TTN_ObjLoader::LoadFromFile("models/IcoSphereMesh.obj");
-	flamethrowerMesh = TTN_ObjLoader::LoadFromFile("models/Flamethrower.obj");
+	////MESHES AND TEXTURES////
+	//start reading all of them at once, they're read on the asset loader's worker threads and each one is sent to opengl once it's ready
+	std::vector<std::pair<TTN_Mesh::smptr*, TTN_Asset<TTN_Mesh>>> meshes = {
+		{ &cannonMesh, TTN_AssetLoader::LoadAnimatedMesh("models/cannon/cannon", 7) },
+		{ &skyboxMesh, TTN_AssetLoader::LoadMesh("models/SkyboxMesh.obj") },
+		{ &sphereMesh, TTN_AssetLoader::LoadMesh("models/IcoSphereMesh.obj") },
+		{ &flamethrowerMesh, TTN_AssetLoader::LoadMesh("models/Flamethrower.obj") },
+		{ &boat1Mesh, TTN_AssetLoader::LoadMesh("models/Boat 1.obj") },
+		{ &boat2Mesh, TTN_AssetLoader::LoadMesh("models/Boat 2.obj") },
+		{ &boat3Mesh, TTN_AssetLoader::LoadMesh("models/Boat 3.obj") },
+		{ &terrainPlain, TTN_AssetLoader::LoadMesh("models/terrainPlain.obj") },
+		{ &birdMesh, TTN_AssetLoader::LoadAnimatedMesh("models/bird/bird", 2) },
+		{ &treeMesh[0], TTN_AssetLoader::LoadMesh("models/Tree1.obj") },
+		{ &treeMesh[1], TTN_AssetLoader::LoadMesh("models/Tree2.obj") },
+		{ &treeMesh[2], TTN_AssetLoader::LoadMesh("models/Tree3.obj") },
+		{ &damMesh, TTN_AssetLoader::LoadMesh("models/Dam.obj") },
+		{ &rockMesh[0], TTN_AssetLoader::LoadMesh("models/Rock1.obj") },
+		{ &rockMesh[1], TTN_AssetLoader::LoadMesh("models/Rock2.obj") },
+		{ &rockMesh[2], TTN_AssetLoader::LoadMesh("models/Rock3.obj") },
+		{ &rockMesh[3], TTN_AssetLoader::LoadMesh("models/Rock4.obj") },
+		{ &rockMesh[4], TTN_AssetLoader::LoadMesh("models/Rock5.obj") }
+	};
+
+	std::vector<std::pair<TTN_Texture2D::st2dptr*, TTN_Asset<TTN_Texture2D>>> textures = {
+		{ &cannonText, TTN_AssetLoader::LoadTexture2D("textures/metal.png") },
+		//the heightmap is loaded with forceRgba so it never gets block compressed, BC1 would terrace the terrain
+		{ &terrainMap, TTN_AssetLoader::LoadTexture2D("textures/Game Map Long.jpg", true, true) },
+		{ &sandText, TTN_AssetLoader::LoadTexture2D("textures/SandTexture.jpg") },
+		{ &rockText, TTN_AssetLoader::LoadTexture2D("textures/RockTexture.jpg") },
+		{ &grassText, TTN_AssetLoader::LoadTexture2D("textures/GrassTexture.jpg") },
+		{ &waterText, TTN_AssetLoader::LoadTexture2D("textures/water.png") },
+		{ &boat1Text, TTN_AssetLoader::LoadTexture2D("textures/Boat 1 Texture.png") },
+		{ &boat2Text, TTN_AssetLoader::LoadTexture2D("textures/Boat 2 Texture.png") },
+		{ &boat3Text, TTN_AssetLoader::LoadTexture2D("textures/Boat 3 Texture.png") },
+		{ &flamethrowerText, TTN_AssetLoader::LoadTexture2D("textures/FlamethrowerTexture.png") },
+		{ &birdText, TTN_AssetLoader::LoadTexture2D("textures/BirdTexture.png") },
+		{ &treeText, TTN_AssetLoader::LoadTexture2D("textures/Trees Texture.png") },
+		{ &damText, TTN_AssetLoader::LoadTexture2D("textures/Dam.png") }
+	};
+
+	TTN_Asset<TTN_TextureCubeMap> skybox = TTN_AssetLoader::LoadTextureCubeMap("textures/skybox/sky.png");
+
+	//the entities need everything straight away, so wait for it all to be uploaded and then grab them
+	TTN_AssetLoader::WaitForAll();
+	for (auto& mesh : meshes)
+		*mesh.first = mesh.second.Get();
+	for (auto& texture : textures)
+		*texture.first = texture.second.Get();
+	skyboxText = skybox.Get();
+
 	flamethrowerMesh->SetUpVao();
-	boat1Mesh = TTN_ObjLoader::LoadFromFile("models/Boat 1.obj");
-	boat2Mesh = TTN_ObjLoader::LoadFromFile("models/Boat 2.obj");
-	boat3Mesh = TTN_ObjLoader::LoadFromFile("models/Boat 3.obj");
-	terrainPlain = TTN_ObjLoader::LoadFromFile("models/terrainPlain.obj");
 	terrainPlain->SetUpVao();
-	birdMesh = TTN_ObjLoader::LoadAnimatedMeshFromFiles("models/bird/bird", 2);
-	treeMesh[0] = TTN_ObjLoader::LoadFromFile("models/Tree1.obj");
-	treeMesh[1] = TTN_ObjLoader::LoadFromFile("models/Tree2.obj");
-	treeMesh[2] = TTN_ObjLoader::LoadFromFile("models/Tree3.obj");
-	damMesh = TTN_ObjLoader::LoadFromFile("models/Dam.obj");
-	rockMesh[0] = TTN_ObjLoader::LoadFromFile("models/Rock1.obj");
-	rockMesh[1] = TTN_ObjLoader::LoadFromFile("models/Rock2.obj");
-	rockMesh[2] = TTN_ObjLoader::LoadFromFile("models/Rock3.obj");
-	rockMesh[3] = TTN_ObjLoader::LoadFromFile("models/Rock4.obj");
-	rockMesh[4] = TTN_ObjLoader::LoadFromFile("models/Rock5.obj");
-
-	///TEXTURES////
-	cannonText = TTN_Texture2D::LoadFromFile("textures/metal.png");
-	skyboxText = TTN_TextureCubeMap::LoadFromImages("textures/skybox/sky.png");
-	terrainMap = TTN_Texture2D::LoadFromFile("textures/Game Map Long.jpg");
-	sandText = TTN_Texture2D::LoadFromFile("textures/SandTexture.jpg");
-	rockText = TTN_Texture2D::LoadFromFile("textures/RockTexture.jpg");
-	grassText = TTN_Texture2D::LoadFromFile("textures/GrassTexture.jpg");
-	waterText = TTN_Texture2D::LoadFromFile("textures/water.png");
-	boat1Text = TTN_Texture2D::LoadFromFile("textures/Boat 1 Texture.png");
-	boat2Text = TTN_Texture2D::LoadFromFile("textures/Boat 2 Texture.png");
-	boat3Text = TTN_Texture2D::LoadFromFile("textures/Boat 3 Texture.png");
-	flamethrowerText = TTN_Texture2D::LoadFromFile("textures/FlamethrowerTexture.png");
-	birdText = TTN_Texture2D::LoadFromFile("textures/BirdTexture.png");
-	treeText = TTN_Texture2D::LoadFromFile("textures/Trees Texture.png");
-	damText = TTN_Texture2D::LoadFromFile("textures/Dam.png");
+
+	//give the terrain and water shaders the bindless handles of their textures once, rather than binding them every frame
+	GLuint64 terrainHandles[5] = { terrainMap->GetBindlessHandle(), sandText->GetBindlessHandle(), rockText->GetBindlessHandle(),
+		grassText->GetBindlessHandle(), waterText->GetBindlessHandle() };
+	terrainBindless = true;
+	for (GLuint64 handle : terrainHandles)
+		terrainBindless = terrainBindless && handle != 0;
+	if (terrainBindless) {
+		shaderProgramTerrain->SetUniformHandle("map", terrainHandles[0]);
+		shaderProgramTerrain->SetUniformHandle("s_base", terrainHandles[1]);
+		shaderProgramTerrain->SetUniformHandle("s_second", terrainHandles[2]);
+		shaderProgramTerrain->SetUniformHandle("s_third", terrainHandles[3]);
+		shaderProgramWater->SetUniformHandle("waterText", terrainHandles[4]);
+	}
 
 	////MATERIALS////
 	cannonMat = TTN_Material::Create();
@@ -600,7 +612,7 @@ void Game::SetUpEntities()
 	flamethrowers = std::vector<entt::entity>();
 
 	//set the cannon to be a child of the camera
-	Get<TTN_Transform>(cannon).SetParent(&Get<TTN_Transform>(camera), &camera);
+	SetParent(cannon, camera);
 }
 
 //sets up any other data the game needs to store
@@ -613,6 +625,8 @@ void Game::SetUpOtherData()
 	cannonBallForce = 3600.0f;
 	playerShootCooldown = 0.7f;
 	playerShootCooldownTimer = playerShootCooldown;
+	//only the boats and cannonballs need collision events
+	SetCollisionEventMask(COLLISION_BOAT | COLLISION_BALL);
 	terrainScale = 0.1f;
 	time = 0.0f;
 	waveSpeed = -2.5f;
@@ -721,6 +735,12 @@ void Game::CreateCannonball()
 		TTN_Physics cannonBallPhysBod = TTN_Physics(cannonBallTrans.GetPos(), glm::vec3(0.0f), cannonBallTrans.GetScale(),
 			cannonBalls[cannonBalls.size() - 1]);
 
+		//cannonballs only need to hit boats and scenery, not each other
+		cannonBallPhysBod.SetCollisionGroup(COLLISION_BALL);
+		cannonBallPhysBod.SetCollisionMask(COLLISION_DEFAULT | COLLISION_BOAT);
+		//cannonballs are fast and small, so sweep them between physics steps to stop them skipping through boats
+		cannonBallPhysBod.SetUseCcd(true);
+
 		//attach that physics body to the entity
 		AttachCopy(cannonBalls[cannonBalls.size() - 1], cannonBallPhysBod);
 
@@ -931,29 +951,38 @@ void Game::SpawnerLS(float deltatime, float SpawnTime) {
 		}
 
 		AttachCopy<TTN_Renderer>(boats[boats.size() - 1], boatRenderer);
+		TTN_Mesh::smptr boatMesh = (randomBoat == 2) ? boat2Mesh : (randomBoat == 3) ? boat3Mesh : boat1Mesh;
+		glm::vec3 boatRotation = glm::vec3(0.0f);
 
 		TTN_Transform boatTrans = TTN_Transform(glm::vec3(21.0f, 10.0f, 0.0f), glm::vec3(0.0f), glm::vec3(1.0f));
 		boatTrans.SetPos(glm::vec3(90.0f, -7.5f, 115.0f));
 
 		if (randomBoat == 1) { //small regular boat
-			boatTrans.RotateFixed(glm::vec3(0.0f, 180.0f, 0.0f));
+			boatRotation = glm::vec3(0.0f, 180.0f, 0.0f);
+			boatTrans.RotateFixed(boatRotation);
 			boatTrans.SetScale(glm::vec3(0.25f, 0.25f, 0.25f));
 		}
 
 		else if (randomBoat == 2) { //large carrier
-			boatTrans.RotateFixed(glm::vec3(0.0f, -90.0f, 0.0f));
+			boatRotation = glm::vec3(0.0f, -90.0f, 0.0f);
+			boatTrans.RotateFixed(boatRotation);
 			boatTrans.SetScale(glm::vec3(0.05f, 0.05f, 0.05f));
 		}
 
 		else if (randomBoat == 3) { // submarine lookking
-			boatTrans.RotateFixed(glm::vec3(0.0f, 90.0f, 0.0f));
+			boatRotation = glm::vec3(0.0f, 90.0f, 0.0f);
+			boatTrans.RotateFixed(boatRotation);
 			boatTrans.SetScale(glm::vec3(0.15f, 0.15f, 0.15f));
 		}
 
 		AttachCopy<TTN_Transform>(boats[boats.size() - 1], boatTrans);
 
-		TTN_Physics pbody = TTN_Physics(boatTrans.GetPos(), glm::vec3(0.0f), glm::vec3(2.0f, 4.0f, 8.95f), boats[boats.size() - 1], TTN_PhysicsBodyType::DYNAMIC);
+		//the collider is a hull around the boat's mesh, so cannonballs have to actually hit the hull
+		TTN_Physics pbody = TTN_Physics(boatTrans.GetPos(), boatRotation, boatTrans.GetScale(), boats[boats.size() - 1], boatMesh);
 		pbody.SetLinearVelocity(glm::vec3(-25.0f, 0.0f, 0.0f));//-2.0f
+		//boats only need to hit cannonballs and scenery, not each other
+		pbody.SetCollisionGroup(COLLISION_BOAT);
+		pbody.SetCollisionMask(COLLISION_DEFAULT | COLLISION_BALL);
 		AttachCopy<TTN_Physics>(boats[boats.size() - 1], pbody);
 
 		int r = rand() % 3 + 1; // generates path number between 1-3 (left side paths, right side path nums are 4-6)
@@ -993,29 +1022,38 @@ void Game::SpawnerRS(float deltatime, float SpawnTime)
 		}
 
 		AttachCopy<TTN_Renderer>(boats[boats.size() - 1], boatRenderer);
+		TTN_Mesh::smptr boatMesh = (randomBoat == 2) ? boat2Mesh : (randomBoat == 3) ? boat3Mesh : boat1Mesh;
+		glm::vec3 boatRotation = glm::vec3(0.0f);
 
 		TTN_Transform boatTrans = TTN_Transform();
 		boatTrans.SetPos(glm::vec3(-90.0f, -7.5f, 115.0f));
 		if (randomBoat == 1) { //small regular boat
-			boatTrans.RotateFixed(glm::vec3(0.0f, 0.0f, 0.0f));
+			boatRotation = glm::vec3(0.0f, 0.0f, 0.0f);
+			boatTrans.RotateFixed(boatRotation);
 			boatTrans.SetScale(glm::vec3(0.25f, 0.25f, 0.25f));
 		}
 
 		else if (randomBoat == 2) { //large carrier
-			boatTrans.RotateFixed(glm::vec3(0.0f, 90.0f, 0.0f));
+			boatRotation = glm::vec3(0.0f, 90.0f, 0.0f);
+			boatTrans.RotateFixed(boatRotation);
 			boatTrans.SetScale(glm::vec3(0.05f, 0.05f, 0.05f));
 		}
 
 		else if (randomBoat == 3) { // submarine lookking
-			boatTrans.RotateFixed(glm::vec3(0.0f, -90.0f, 0.0f));
+			boatRotation = glm::vec3(0.0f, -90.0f, 0.0f);
+			boatTrans.RotateFixed(boatRotation);
 			boatTrans.SetScale(glm::vec3(0.15f, 0.15f, 0.15f));
 		}
 
 		AttachCopy<TTN_Transform>(boats[boats.size() - 1], boatTrans);
 
-		TTN_Physics pbody = TTN_Physics(boatTrans.GetPos(), glm::vec3(0.0f), glm::vec3(2.0f, 4.0f, 8.95f), boats[boats.size() - 1]);
+		//the collider is a hull around the boat's mesh, so cannonballs have to actually hit the hull
+		TTN_Physics pbody = TTN_Physics(boatTrans.GetPos(), boatRotation, boatTrans.GetScale(), boats[boats.size() - 1], boatMesh);
 
 		pbody.SetLinearVelocity(glm::vec3(25.0f, 0.0f, 0.0f));//-2.0f
+		//boats only need to hit cannonballs and scenery, not each other
+		pbody.SetCollisionGroup(COLLISION_BOAT);
+		pbody.SetCollisionMask(COLLISION_DEFAULT | COLLISION_BALL);
 		AttachCopy<TTN_Physics>(boats[boats.size() - 1], pbody);
 
 		int r = rand() % 3 + 4; // generates path number between 4-6 (left side paths 1-3, right side path nums are 4-6)
@@ -1157,56 +1195,37 @@ void Game::Flamethrower() {
 void Game::Collisions()
 {
 	//collision checks
-	//get the collisions from the base scene
-	std::vector<TTN_Collision::scolptr> collisionsThisFrame = TTN_Scene::GetCollisions();
-
-	//iterate through the collisions
-	for (int i = 0; i < collisionsThisFrame.size(); i++) {
-		//get both the rigidbodies
-		//const btRigidBody* b1 = collisionsThisFrame[i]->GetBody1();
-		//const btRigidBody* b2 = collisionsThisFrame[i]->GetBody2();
-		//get the entity number from each body
-		//entt::entity entity1Ptr = static_cast<entt::entity>(reinterpret_cast<uint32_t>(b1->getUserPointer()));
-		//entt::entity entity2Ptr = static_cast<entt::entity>(reinterpret_cast<uint32_t>(b2->getUserPointer()));
-		//entt::entity entity1Ptr = *static_cast<entt::entity*>(b1->getUserPointer());
-		//entt::entity entity2Ptr = *static_cast<entt::entity*>(b2->getUserPointer());
-		entt::entity entity1Ptr = collisionsThisFrame[i]->GetBody1();
-		entt::entity entity2Ptr = collisionsThisFrame[i]->GetBody2();
-
-		//entt::entity tempTankRed = redPlayer;
-		//entt::entity tempTankBlue = bluePlayer;
-
-		//check if both entities still exist
+	//go through the collision events from the base scene
+	const std::vector<TTN_CollisionEvent>& collisionsThisFrame = TTN_Scene::GetCollisionEvents();
+	for (const TTN_CollisionEvent& collision : collisionsThisFrame) {
+		//only a cannonball starting to touch a boat matters
+		if (collision.Type != TTN_CollisionEventType::BEGIN || !collision.IsBetween(COLLISION_BOAT, COLLISION_BALL))
+			continue;
+
+		entt::entity entity1Ptr = collision.Body1;
+		entt::entity entity2Ptr = collision.Body2;
+
+		//check if both entities still exist (an earlier event this frame could have deleted one of them)
 		if (TTN_Scene::GetScene()->valid(entity1Ptr) && TTN_Scene::GetScene()->valid(entity2Ptr)) {
-			bool cont = true;
-			//if they do, then check they both have tags
-			if (TTN_Scene::Has<TTN_Tag>(entity1Ptr) && TTN_Scene::Has<TTN_Tag>(entity2Ptr)) {
-				//if they do, then do tag comparisons
-
-				//if one is a boat and the other is a cannonball
-				if (cont && ((Get<TTN_Tag>(entity1Ptr).getName() == "Boat" && Get<TTN_Tag>(entity2Ptr).getName() == "Ball") ||
-					(Get<TTN_Tag>(entity1Ptr).getName() == "Ball" && Get<TTN_Tag>(entity2Ptr).getName() == "Boat"))) {
-					std::vector<entt::entity>::iterator it = cannonBalls.begin();
-					while (it != cannonBalls.end()) {
-						if (entity1Ptr == *it || entity2Ptr == *it) {
-							DeleteEntity(*it);
-							it = cannonBalls.erase(it);
-						}
-						else {
-							it++;
-						}
-					}
-
-					std::vector<entt::entity>::iterator itt = boats.begin();
-					while (itt != boats.end()) {
-						if (entity1Ptr == *itt || entity2Ptr == *itt) {
-							DeleteEntity(*itt);
-							itt = boats.erase(itt);
-						}
-						else {
-							itt++;
-						}
-					}
+			std::vector<entt::entity>::iterator it = cannonBalls.begin();
+			while (it != cannonBalls.end()) {
+				if (entity1Ptr == *it || entity2Ptr == *it) {
+					DeleteEntity(*it);
+					it = cannonBalls.erase(it);
+				}
+				else {
+					it++;
+				}
+			}
+
+			std::vector<entt::entity>::iterator itt = boats.begin();
+			while (itt != boats.end()) {
+				if (entity1Ptr == *itt || entity2Ptr == *itt) {
+					DeleteEntity(*itt);
+					itt = boats.erase(itt);
+				}
+				else {
+					itt++;
 				}
 			}
 		}
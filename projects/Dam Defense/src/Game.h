@@ -5,10 +5,19 @@
 //include required features from titan
 #include "Titan/Application.h"
 #include "Titan/ObjLoader.h"
+#include "Titan/AssetLoader.h"
+#include "Titan/ResourceCache.h"
 #include "Titan/Interpolation.h"
 
 using namespace Titan;
 
+//the collision groups the game's physics bodies are put in
+enum CollisionGroups : uint32_t {
+	COLLISION_DEFAULT = 1 << 0,
+	COLLISION_BOAT = 1 << 1,
+	COLLISION_BALL = 1 << 2
+};
+
 class Game : public TTN_Scene {
 public:
 	//default constructor
@@ -73,6 +82,8 @@ public:
 	TTN_Texture2D::st2dptr birdText;
 	TTN_Texture2D::st2dptr treeText;
 	TTN_Texture2D::st2dptr damText;
+	//wheter or not the terrain and water shaders have their textures' bindless handles, so they don't need to be bound every frame
+	bool terrainBindless = false;
 
 	//materials
 	TTN_Material::smatptr boat1Mat;
@@ -107,6 +118,8 @@ protected:
 
 	std::vector<entt::entity> flamethrowers;
 	std::vector<entt::entity> flames;
+	//the boats caught in the flames, kept so the query doesn't allocate every frame
+	std::vector<entt::entity> flamedBoats;
 
 //other data
 protected:
@@ -3,6 +3,8 @@
 
 //import required titan features
 #include "Titan/Application.h"
+#include "Titan/TextureCompressor.h"
+#include "Titan/ShaderCache.h"
 //include the other headers in dam defense
 #include "Game.h"
 
@@ -12,6 +14,7 @@ using namespace Titan;
 int main() { 
 	Logger::Init(); //initliaze otter's base logging system
 	TTN_Application::Init("Dam Defense", 1920, 1080); //initliaze titan's application
+	TTN_TextureCompressor::SetEnabled(true); //compress the textures (baked into cache/textures the first time they're loaded), data textures opt out with forceRgba
 
 	//lock the cursor while focused in the application window
 	TTN_Application::TTN_Input::SetCursorLocked(true);
@@ -22,6 +25,11 @@ int main() {
 	//initliaze them
 	gameScene->InitScene();
 
+	//log how long the shaders took, programs are cached in cache/shaders so the next run should only have hits
+	const TTN_ShaderCacheStats& shaderStats = TTN_ShaderCache::GetStats();
+	LOG_INFO("Shader cache: {} programs loaded in {:.2f}ms, {} compiled in {:.2f}ms ({} rejected by the driver)",
+		shaderStats.Hits, shaderStats.HitTime, shaderStats.Misses, shaderStats.CompileTime, shaderStats.Rejected);
+
 	//add them to the application
 	TTN_Application::scenes.push_back(gameScene);
 